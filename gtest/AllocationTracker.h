@@ -0,0 +1,99 @@
+#ifndef ALLOCATION_TRACKER_H
+#define ALLOCATION_TRACKER_H
+
+// 测试辅助：替换全局 operator new/delete，统计堆分配次数与字节数。
+// 替换函数在本头文件中定义，因此每个测试可执行文件只能有一个源文件包含它
+// （gtest/ 下每个 *_test.cpp 单独链接，满足这一条件）。
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace allocation_tracker {
+// 进程内的累计值，所有线程共享；AllocationScope 取差值
+inline std::atomic<uint64_t>& allocationCount() {
+    static std::atomic<uint64_t> count(0);
+    return count;
+}
+inline std::atomic<uint64_t>& allocatedBytes() {
+    static std::atomic<uint64_t> bytes(0);
+    return bytes;
+}
+inline std::atomic<uint64_t>& deallocationCount() {
+    static std::atomic<uint64_t> count(0);
+    return count;
+}
+
+inline void* allocate(std::size_t size, bool nothrow) {
+    allocationCount().fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes().fetch_add(size, std::memory_order_relaxed);
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr && !nothrow) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+inline void* allocateAligned(std::size_t size, std::align_val_t alignment, bool nothrow) {
+    allocationCount().fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes().fetch_add(size, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    // aligned_alloc 要求大小是对齐值的整数倍
+    void* memory = std::aligned_alloc(align, (size + align - 1) / align * align);
+    if (memory == nullptr && !nothrow) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+inline void release(void* memory) {
+    if (memory != nullptr) {
+        deallocationCount().fetch_add(1, std::memory_order_relaxed);
+        std::free(memory);
+    }
+}
+}
+
+// 统计从构造起（所有线程）发生的堆分配；可嵌套，也可 reset() 后重新计数
+class AllocationScope {
+public:
+    AllocationScope() { reset(); }
+
+    void reset() {
+        startCount = allocation_tracker::allocationCount().load();
+        startBytes = allocation_tracker::allocatedBytes().load();
+        startFrees = allocation_tracker::deallocationCount().load();
+    }
+    uint64_t allocations() const { return allocation_tracker::allocationCount().load() - startCount; }
+    uint64_t bytes() const { return allocation_tracker::allocatedBytes().load() - startBytes; }
+    uint64_t deallocations() const { return allocation_tracker::deallocationCount().load() - startFrees; }
+
+private:
+    uint64_t startCount;
+    uint64_t startBytes;
+    uint64_t startFrees;
+};
+
+void* operator new(std::size_t size) { return allocation_tracker::allocate(size, false); }
+void* operator new[](std::size_t size) { return allocation_tracker::allocate(size, false); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocation_tracker::allocate(size, true); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocation_tracker::allocate(size, true); }
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocation_tracker::allocateAligned(size, alignment, false);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocation_tracker::allocateAligned(size, alignment, false);
+}
+void operator delete(void* memory) noexcept { allocation_tracker::release(memory); }
+void operator delete[](void* memory) noexcept { allocation_tracker::release(memory); }
+void operator delete(void* memory, std::size_t) noexcept { allocation_tracker::release(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { allocation_tracker::release(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { allocation_tracker::release(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { allocation_tracker::release(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { allocation_tracker::release(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { allocation_tracker::release(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { allocation_tracker::release(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { allocation_tracker::release(memory); }
+
+#endif // ALLOCATION_TRACKER_H
@@ -0,0 +1,49 @@
+#ifndef TEST_GRAPHS_H
+#define TEST_GRAPHS_H
+
+// 测试辅助：各测试共用的单词编码与随机图生成
+
+#include <random>
+#include <string>
+#include "../include/Graph.h"
+
+// 用字母编码顶点编号，保证单词经过 normalizeWord 后不变；编号小于 26^4 时不超过 4 个字符，
+// 不会触发 std::string 的堆分配。字典序与编号顺序无关
+inline std::string wordFor(int id) {
+    std::string word;
+    do {
+        word += static_cast<char>('a' + id % 26);
+        id /= 26;
+    } while (id > 0);
+    return word;
+}
+
+// 随机有向图：每个顶点先得到一条出边（全部顶点都出现在图中），其余边的两端均匀随机，
+// 权重在 [1, maxWeight] 内均匀随机
+inline Graph randomGraph(int vertices, int edges, int maxWeight, unsigned seed) {
+    Graph graph;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pick(0, vertices - 1);
+    std::uniform_int_distribution<int> weight(1, maxWeight);
+    for (int v = 0; v < vertices; ++v) {
+        graph.addEdge(wordFor(v), wordFor(pick(rng)), weight(rng));
+    }
+    for (int e = vertices; e < edges; ++e) {
+        graph.addEdge(wordFor(pick(rng)), wordFor(pick(rng)), weight(rng));
+    }
+    return graph;
+}
+
+// 只有均匀随机边的有向图：没有被抽中的编号不成为顶点
+inline Graph uniformGraph(int vertices, int edges, int maxWeight, unsigned seed) {
+    Graph graph;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pick(0, vertices - 1);
+    std::uniform_int_distribution<int> weight(1, maxWeight);
+    for (int e = 0; e < edges; ++e) {
+        graph.addEdge(wordFor(pick(rng)), wordFor(pick(rng)), weight(rng));
+    }
+    return graph;
+}
+
+#endif // TEST_GRAPHS_H
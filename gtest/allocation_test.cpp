@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "AllocationTracker.h"
+#include "../include/ResultStream.h"
+#include "../include/SparseMatrix.h"
+#include "TestGraphs.h"
+
+// 规模依次翻倍的输入
+static const int kSizes[] = { 1000, 2000, 4000, 8000 };
+
+// 测试用例 1：计数器本身统计准确，作用域可以嵌套
+TEST(AllocationTest, ScopeCountsAllocations) {
+    AllocationScope outer;
+    {
+        AllocationScope inner;
+        std::vector<int> numbers;
+        numbers.reserve(100);
+        EXPECT_EQ(inner.allocations(), 1u);
+        EXPECT_GE(inner.bytes(), 100 * sizeof(int));
+        std::unique_ptr<int[]> block(new int[10]);
+        EXPECT_EQ(inner.allocations(), 2u);
+        inner.reset();
+        EXPECT_EQ(inner.allocations(), 0u);
+    }
+    EXPECT_EQ(outer.allocations(), 2u);
+    EXPECT_EQ(outer.deallocations(), 2u);
+
+    AllocationScope none;
+    std::string shortWord = "bridge";
+    EXPECT_EQ(none.allocations(), 0u);
+}
+
+// 测试用例 2：预热后，findBridgeWords 与 shortestPath 只为返回值分配内存，与图的规模无关
+TEST(AllocationTest, QueriesAfterWarmUp) {
+    for (int size : kSizes) {
+        SCOPED_TRACE("vertices " + std::to_string(size));
+        Graph graph = randomGraph(size, size * 4, 3, 1);
+        std::shared_ptr<const CsrGraph> csr = graph.csrView();
+        size_t bridged = 0;
+        for (int i = 0; i < 20; ++i) {
+            // 目标取 from 两步之内的单词，保证桥接词与路径非空
+            CsrGraph::VertexId fromId = 0;
+            std::string from = wordFor(i * 31);
+            ASSERT_TRUE(csr->findVertex(from, fromId));
+            CsrGraph::VertexId middle = *csr->targetsBegin(fromId);
+            std::string to = csr->outDegree(middle) > 0 ? csr->name(*csr->targetsBegin(middle)) : wordFor(i * 57 + 3);
+            // 预热调用建立 CSR、入边、可达性索引与最短路径树缓存（源点第二次查询才缓存完整树）
+            graph.findBridgeWords(from, to);
+            graph.shortestPath(from, to);
+            graph.shortestPath(from, to);
+
+            AllocationScope scope;
+            std::vector<std::string> bridges = graph.findBridgeWords(from, to);
+            uint64_t bridgeAllocations = scope.allocations();
+            // 结果为空时不分配；否则只有结果 vector 的扩容
+            EXPECT_LE(bridgeAllocations, bridges.size()) << from << " -> " << to;
+            bridged += bridges.empty() ? 0 : 1;
+
+            scope.reset();
+            std::pair<double, std::vector<std::string>> path = graph.shortestPath(from, to);
+            EXPECT_EQ(scope.allocations(), path.second.empty() ? 0u : 1u) << from << " -> " << to;
+
+            scope.reset();
+            EXPECT_TRUE(graph.findBridgeWords(from, "missing").empty());
+            EXPECT_EQ(graph.shortestPath("missing", to).first, -1);
+            EXPECT_EQ(scope.allocations(), 0u);
+        }
+        EXPECT_GT(bridged, 10u);
+    }
+}
+
+// 测试用例 3：PageRank 每轮迭代不分配内存，整体分配次数随顶点数线性增长
+TEST(AllocationTest, PageRankIterations) {
+    uint64_t previous = 0;
+    for (int size : kSizes) {
+        SCOPED_TRACE("vertices " + std::to_string(size));
+        Graph graph = randomGraph(size, size * 4, 3, 2);
+        SparseMatrix matrix(*graph.csrView());
+        std::vector<double> start(matrix.size(), 1.0 / static_cast<double>(matrix.size()));
+
+        uint64_t runs[2];
+        int iterations[2] = { 10, 40 };
+        for (int i = 0; i < 2; ++i) {
+            IterationOptions options;
+            options.maxIterations = iterations[i];
+            std::vector<double> copy = start;
+            AllocationScope scope;
+            IterationResult result = pageRankScores(matrix, 0.85, std::move(copy), options);
+            runs[i] = scope.allocations();
+            EXPECT_EQ(result.iterations, iterations[i]);
+        }
+        EXPECT_EQ(runs[0], runs[1]);
+        EXPECT_LE(runs[1], 8u);
+
+        // 按单词返回的结果每个顶点一个 map 节点，预热后不再随规模超线性增长
+        graph.calculatePageRank(0.85, std::map<std::string, double>(), 10);
+        AllocationScope scope;
+        std::map<std::string, double> ranks = graph.calculatePageRank(0.85, std::map<std::string, double>(), 10);
+        uint64_t total = scope.allocations();
+        EXPECT_LE(total, ranks.size() * 2 + 64);
+        if (previous != 0) {
+            EXPECT_LE(total, previous * 2 + 64);
+        }
+        previous = total;
+    }
+}
+
+// 测试用例 4：流式最短路径与跳数查询的分配次数不随图的规模增长（优先队列扩容除外）
+TEST(AllocationTest, StreamingScales) {
+    uint64_t firstStream = 0, firstHop = 0;
+    for (int size : kSizes) {
+        SCOPED_TRACE("vertices " + std::to_string(size));
+        Graph graph = randomGraph(size, size * 4, 3, 3);
+        graph.csrView();
+        graph.hopDistance("a", "b");
+
+        AllocationScope scope;
+        ShortestPathStream stream = graph.streamShortestPaths("a");
+        size_t settled = 0;
+        while (stream.next()) {
+            stream.pathIds();
+            settled++;
+        }
+        uint64_t streamAllocations = scope.allocations();
+        EXPECT_GT(settled, static_cast<size_t>(size / 2));
+
+        scope.reset();
+        graph.hopDistance("a", "b");
+        uint64_t hopAllocations = scope.allocations();
+        if (firstStream == 0) {
+            firstStream = streamAllocations;
+            firstHop = hopAllocations;
+        }
+        // 每次翻倍至多多出常数次扩容
+        EXPECT_LE(streamAllocations, firstStream + 8);
+        EXPECT_LE(hopAllocations, firstHop + 4);
+        EXPECT_LE(streamAllocations, 64u);
+    }
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/Betweenness.h"
+#include "TestGraphs.h"
+
+// 朴素对照：Floyd 求距离与最短路径条数，按定义累加 sigma(s,v)*sigma(v,t)/sigma(s,t)
+static std::vector<double> referenceBetweenness(const CsrGraph& csr) {
+    const size_t n = csr.vertexCount();
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<std::vector<double>> dist(n, std::vector<double>(n, inf));
+    for (size_t s = 0; s < n; ++s) {
+        dist[s][s] = 0;
+        const uint32_t* w = csr.weightsBegin(static_cast<CsrGraph::VertexId>(s));
+        for (const CsrGraph::VertexId* t = csr.targetsBegin(static_cast<CsrGraph::VertexId>(s));
+             t != csr.targetsEnd(static_cast<CsrGraph::VertexId>(s)); ++t, ++w) {
+            if (*t != s) {
+                dist[s][*t] = std::min(dist[s][*t], static_cast<double>(*w));
+            }
+        }
+    }
+    for (size_t k = 0; k < n; ++k)
+        for (size_t i = 0; i < n; ++i)
+            for (size_t j = 0; j < n; ++j)
+                dist[i][j] = std::min(dist[i][j], dist[i][k] + dist[k][j]);
+
+    // 按距离递增计数最短路径条数
+    std::vector<std::vector<double>> sigma(n, std::vector<double>(n, 0));
+    for (size_t s = 0; s < n; ++s) {
+        std::vector<size_t> byDist;
+        for (size_t v = 0; v < n; ++v) if (dist[s][v] < inf) byDist.push_back(v);
+        std::sort(byDist.begin(), byDist.end(), [&](size_t a, size_t b) { return dist[s][a] < dist[s][b]; });
+        sigma[s][s] = 1;
+        for (size_t v : byDist) {
+            const uint32_t* w = csr.weightsBegin(static_cast<CsrGraph::VertexId>(v));
+            for (const CsrGraph::VertexId* t = csr.targetsBegin(static_cast<CsrGraph::VertexId>(v));
+                 t != csr.targetsEnd(static_cast<CsrGraph::VertexId>(v)); ++t, ++w) {
+                if (*t != v && dist[s][v] + *w == dist[s][*t]) sigma[s][*t] += sigma[s][v];
+            }
+        }
+    }
+    std::vector<double> result(n, 0);
+    for (size_t s = 0; s < n; ++s)
+        for (size_t t = 0; t < n; ++t)
+            for (size_t v = 0; v < n; ++v)
+                if (s != t && v != s && v != t && dist[s][t] < inf && dist[s][v] + dist[v][t] == dist[s][t])
+                    result[v] += sigma[s][v] * sigma[v][t] / sigma[s][t];
+    return result;
+}
+
+// 测试用例 1：与按定义计算的结果一致
+TEST(BetweennessTest, MatchesDefinition) {
+    Graph graph = uniformGraph(60, 240, 3, 1);
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    std::vector<double> expected = referenceBetweenness(*csr);
+    BetweennessOptions options;
+    options.threads = 3;
+    std::vector<double> scores = betweennessCentrality(*csr, options);
+    for (size_t v = 0; v < csr->vertexCount(); ++v) {
+        EXPECT_NEAR(scores[v], expected[v], 1e-9) << csr->name(static_cast<CsrGraph::VertexId>(v));
+    }
+}
+
+// 测试用例 2：链上的中间词是枢纽，平行的两条等长路径各分一半
+TEST(BetweennessTest, ChainAndTiedPaths) {
+    Graph graph;
+    graph.addEdge("a", "b");
+    graph.addEdge("b", "c");
+    graph.addEdge("c", "d");
+    graph.addEdge("a", "x", 2);
+    graph.addEdge("x", "c", 1);
+    std::map<std::string, double> scores = graph.calculateBetweenness();
+    // a->c：a-b-c 与 a-x-c 长度分别为 2 和 3，只经过 b；a->d 同理
+    EXPECT_DOUBLE_EQ(scores["b"], 2.0);
+    EXPECT_DOUBLE_EQ(scores["x"], 0.0);
+    // c 位于 a->d、b->d、x->d 上
+    EXPECT_DOUBLE_EQ(scores["c"], 3.0);
+
+    graph.addEdge("a", "x", -1); // a->x 权重变为 1，a->c 出现两条等长路径
+    scores = graph.calculateBetweenness();
+    EXPECT_DOUBLE_EQ(scores["b"], 1.0);
+    EXPECT_DOUBLE_EQ(scores["x"], 1.0);
+}
+
+// 测试用例 3：采样模式可复现，且在全部源点时等于精确值
+TEST(BetweennessTest, SampledMode) {
+    Graph graph = uniformGraph(400, 2000, 3, 2);
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    BetweennessOptions exact;
+    std::vector<double> full = betweennessCentrality(*csr, exact);
+
+    BetweennessOptions sampled;
+    sampled.samples = 100;
+    sampled.seed = 9;
+    std::vector<double> first = betweennessCentrality(*csr, sampled);
+    sampled.threads = 1;
+    std::vector<double> second = betweennessCentrality(*csr, sampled);
+    double fullSum = 0, sampledSum = 0;
+    for (size_t v = 0; v < csr->vertexCount(); ++v) {
+        EXPECT_NEAR(first[v], second[v], 1e-6);
+        fullSum += full[v];
+        sampledSum += first[v];
+    }
+    // 总量估计误差在合理范围内
+    EXPECT_NEAR(sampledSum / fullSum, 1.0, 0.25);
+
+    sampled.samples = csr->vertexCount();
+    std::vector<double> all = betweennessCentrality(*csr, sampled);
+    for (size_t v = 0; v < csr->vertexCount(); ++v) {
+        EXPECT_NEAR(all[v], full[v], 1e-6);
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/CompactGraph.h"
+#include "../include/CsrGraph.h"
+#include "TestGraphs.h"
+
+// 测试用例 1：按词表大小与最大权重选择最窄的实例
+TEST(CompactGraphTest, PicksNarrowestInstantiation) {
+    std::unique_ptr<CompactGraph> small = CompactGraph::build(randomGraph(500, 1000, 50, 1));
+    EXPECT_STREQ(small->typeName(), "BasicGraph<uint16_t, uint8_t>");
+
+    std::unique_ptr<CompactGraph> heavier = CompactGraph::build(randomGraph(500, 2000, 300, 2));
+    EXPECT_EQ(heavier->vertexIdBytes(), 2u);
+    EXPECT_EQ(heavier->weightBytes(), 2u);
+
+    Graph large = randomGraph(70000, 70000, 2, 3);
+    std::unique_ptr<CompactGraph> wide = CompactGraph::build(large);
+    EXPECT_EQ(wide->vertexIdBytes(), 4u);
+    EXPECT_EQ(wide->weightBytes(), 1u);
+
+    Graph negative;
+    negative.addEdge("a", "b", -3);
+    EXPECT_EQ(CompactGraph::build(negative)->weightBytes(), 4u);
+}
+
+// 测试用例 2：窄类型实例的最短路径与 PageRank 与 Graph 一致
+TEST(CompactGraphTest, AnswersMatchGraph) {
+    Graph graph = randomGraph(800, 4000, 9, 4);
+    std::unique_ptr<CompactGraph> compact = CompactGraph::build(graph);
+    ASSERT_EQ(compact->vertexIdBytes(), 2u);
+    ASSERT_EQ(compact->vertexCount(), graph.vertexCount());
+    ASSERT_EQ(compact->edgeCount(), graph.edgeCount());
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> pick(0, 799);
+    for (int q = 0; q < 60; ++q) {
+        std::string from = wordFor(pick(rng)), to = wordFor(pick(rng));
+        std::pair<double, std::vector<std::string>> expected = graph.shortestPath(from, to);
+        std::pair<double, std::vector<std::string>> actual = compact->shortestPath(from, to);
+        EXPECT_EQ(actual.first, expected.first) << from << " -> " << to;
+        EXPECT_EQ(actual.second, expected.second) << from << " -> " << to;
+    }
+    EXPECT_EQ(compact->shortestPath("a", "notaword").first, -1);
+
+    std::map<std::string, double> expectedRanks = graph.calculatePageRank(0.85, std::map<std::string, double>(), 30);
+    std::map<std::string, double> ranks = compact->calculatePageRank(0.85, 30);
+    ASSERT_EQ(ranks.size(), expectedRanks.size());
+    for (const auto& entry : expectedRanks) {
+        EXPECT_NEAR(ranks[entry.first], entry.second, 1e-12) << entry.first;
+    }
+}
+
+// 测试用例 3：窄类型的数组占用小于 32 位 CSR
+TEST(CompactGraphTest, UsesLessMemoryThanCsr) {
+    Graph graph = randomGraph(3000, 30000, 5, 6);
+    std::unique_ptr<CompactGraph> compact = CompactGraph::build(graph);
+    CsrGraph csr(graph);
+    EXPECT_LT(compact->memoryBytes(), csr.memoryBytes());
+    // 每条边 3 字节（uint16_t 目标 + uint8_t 权重），32 位 CSR 为 8 字节
+    EXPECT_EQ(compact->vertexIdBytes() + compact->weightBytes(), 3u);
+    EXPECT_LE(compact->memoryBytes() + graph.edgeCount() * 5, csr.memoryBytes());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "../include/CompressedGraph.h"
+
+// 测试夹具：同一文本分别构建普通图与压缩图
+class CompressedGraphTest : public ::testing::Test {
+protected:
+    const std::string testFilePath = "compressed_test.txt";
+    const std::string snapshotPath = "compressed_test.tgcg";
+    Graph graph;
+
+    void SetUp() override {
+        std::ofstream testFile(testFilePath);
+        testFile << "The scientist carefully analyzed the data, wrote a detailed report, and shared the report "
+                    "with the team, but the team requested more data, so the scientist analyzed it again.";
+        testFile.close();
+        ASSERT_TRUE(graph.buildFromFile(testFilePath));
+    }
+
+    void TearDown() override {
+        std::remove(testFilePath.c_str());
+        std::remove(snapshotPath.c_str());
+    }
+
+    std::vector<std::string> vertices() const {
+        std::vector<std::string> result;
+        for (const auto& entry : graph.getAdjacencyList()) {
+            result.push_back(entry.first);
+        }
+        return result;
+    }
+};
+
+// 测试用例 1：规模与查询结果一致
+TEST_F(CompressedGraphTest, SameShortestPathsAsGraph) {
+    CompressedGraph compressed(graph);
+    EXPECT_EQ(compressed.vertexCount(), graph.vertexCount());
+    EXPECT_EQ(compressed.edgeCount(), graph.edgeCount());
+    EXPECT_EQ(compressed.weightWidth(), 1u);
+
+    std::vector<std::string> words = vertices();
+    for (const std::string& from : words) {
+        for (const std::string& to : words) {
+            EXPECT_EQ(compressed.shortestPath(from, to), graph.shortestPath(from, to)) << from << " -> " << to;
+        }
+    }
+    EXPECT_EQ(compressed.shortestPath("missing", "the").first, -1);
+}
+
+// 测试用例 2：PageRank 与原实现一致
+TEST_F(CompressedGraphTest, SamePageRankAsGraph) {
+    CompressedGraph compressed(graph);
+    std::map<std::string, double> expected = graph.calculatePageRank(0.85, std::map<std::string, double>(), 50);
+    std::map<std::string, double> actual = compressed.calculatePageRank(0.85, 50);
+    ASSERT_EQ(actual.size(), expected.size());
+    for (const auto& entry : expected) {
+        EXPECT_NEAR(actual[entry.first], entry.second, 1e-12) << entry.first;
+    }
+}
+
+// 测试用例 3：随机游走只经过真实存在的边且不重复
+TEST_F(CompressedGraphTest, RandomWalkFollowsEdges) {
+    CompressedGraph compressed(graph);
+    for (int round = 0; round < 50; ++round) {
+        std::vector<std::string> path = compressed.randomWalk();
+        ASSERT_FALSE(path.empty());
+        std::set<std::pair<std::string, std::string>> seen;
+        for (size_t i = 0; i + 1 < path.size(); ++i) {
+            EXPECT_TRUE(seen.insert(std::make_pair(path[i], path[i + 1])).second);
+            bool hasEdge = false;
+            for (const Graph::Edge& edge : graph.getAdjacencyList().at(path[i])) {
+                hasEdge = hasEdge || edge.dest == path[i + 1];
+            }
+            EXPECT_TRUE(hasEdge) << path[i] << " -> " << path[i + 1];
+        }
+    }
+}
+
+// 测试用例 4：大权重自动选择更宽的存储
+TEST(CompressedGraphWidthTest, WidensWeightStorage) {
+    Graph heavy;
+    for (int i = 0; i < 300; ++i) {
+        heavy.addEdge("alpha", "beta");
+    }
+    heavy.addEdge("beta", "gamma");
+    CompressedGraph compressed(heavy);
+    EXPECT_EQ(compressed.weightWidth(), 2u);
+    EXPECT_EQ(compressed.shortestPath("alpha", "gamma").first, 301);
+}
+
+// 测试用例 5：快照保存与加载
+TEST_F(CompressedGraphTest, SnapshotRoundTrip) {
+    CompressedGraph compressed(graph);
+    ASSERT_TRUE(compressed.saveToFile(snapshotPath));
+
+    CompressedGraph loaded;
+    ASSERT_TRUE(loaded.loadFromFile(snapshotPath));
+    EXPECT_EQ(loaded.vertexCount(), compressed.vertexCount());
+    EXPECT_EQ(loaded.edgeCount(), compressed.edgeCount());
+    EXPECT_TRUE(loaded.containsWord("Scientist"));
+    EXPECT_EQ(loaded.shortestPath("the", "again"), graph.shortestPath("the", "again"));
+}
+
+// 测试用例 6：偏移量或邻居编码被篡改的快照被拒绝，原有内容保持不变
+TEST_F(CompressedGraphTest, RejectsCorruptSnapshot) {
+    CompressedGraph compressed(graph);
+    ASSERT_TRUE(compressed.saveToFile(snapshotPath));
+    std::string bytes;
+    {
+        std::ifstream file(snapshotPath, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    // 文件布局：magic、版本、宽度各 4 字节，之后每个数组是 8 字节长度加数据
+    const size_t vertices = compressed.vertexCount();
+    const size_t namesAt = 12;
+    uint64_t nameCount = 0;
+    std::memcpy(&nameCount, &bytes[namesAt], sizeof(nameCount));
+    const size_t nameOffsetsAt = namesAt + 8 + nameCount;
+    const size_t neighborOffsetsAt = nameOffsetsAt + 8 + (vertices + 1) * sizeof(uint32_t);
+    const size_t edgeIndexAt = neighborOffsetsAt + 8 + (vertices + 1) * sizeof(uint64_t);
+    const size_t neighborBytesAt = edgeIndexAt + 8 + (vertices + 1) * sizeof(uint32_t);
+    uint64_t neighborCount = 0;
+    std::memcpy(&neighborCount, &bytes[neighborBytesAt], sizeof(neighborCount));
+    ASSERT_GT(neighborCount, 0u);
+
+    auto rejects = [&](const std::string& corrupt) {
+        {
+            std::ofstream file(snapshotPath, std::ios::binary);
+            file.write(corrupt.data(), static_cast<std::streamsize>(corrupt.size()));
+        }
+        CompressedGraph loaded(graph);
+        bool accepted = loaded.loadFromFile(snapshotPath);
+        EXPECT_EQ(loaded.vertexCount(), compressed.vertexCount());
+        EXPECT_EQ(loaded.shortestPath("the", "again"), graph.shortestPath("the", "again"));
+        return !accepted;
+    };
+
+    // 名字偏移量越过名字池
+    std::string corrupt = bytes;
+    uint32_t hugeOffset = 0xFFFFFF;
+    std::memcpy(&corrupt[nameOffsetsAt + 8 + vertices * sizeof(uint32_t)], &hugeOffset, sizeof(hugeOffset));
+    EXPECT_TRUE(rejects(corrupt));
+
+    // 邻居偏移量不从 0 开始
+    corrupt = bytes;
+    corrupt[neighborOffsetsAt + 8] = 1;
+    EXPECT_TRUE(rejects(corrupt));
+
+    // 出度前缀和递减
+    corrupt = bytes;
+    uint32_t large = static_cast<uint32_t>(compressed.edgeCount() + 5);
+    std::memcpy(&corrupt[edgeIndexAt + 8 + sizeof(uint32_t)], &large, sizeof(large));
+    EXPECT_TRUE(rejects(corrupt));
+
+    // 解码出的邻居编号超出顶点数
+    corrupt = bytes;
+    for (size_t i = 0; i < neighborCount; ++i) {
+        corrupt[neighborBytesAt + 8 + i] = 0x7F;
+    }
+    EXPECT_TRUE(rejects(corrupt));
+
+    // 变长整数的续位越过行尾
+    corrupt = bytes;
+    for (size_t i = 0; i < neighborCount; ++i) {
+        corrupt[neighborBytesAt + 8 + i] = static_cast<char>(0x80);
+    }
+    EXPECT_TRUE(rejects(corrupt));
+
+    // 截断的文件
+    EXPECT_TRUE(rejects(bytes.substr(0, bytes.size() / 2)));
+    // 原样写回仍然可以加载
+    EXPECT_FALSE(rejects(bytes));
+}
+
+// 测试用例 7：数组长度字段巨大的快照被拒绝，而不是抛出 bad_alloc
+TEST_F(CompressedGraphTest, RejectsHugeArrayCount) {
+    CompressedGraph compressed(graph);
+    ASSERT_TRUE(compressed.saveToFile(snapshotPath));
+    std::string bytes;
+    {
+        std::ifstream file(snapshotPath, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    // 名字数组的长度位于 magic、版本、宽度之后
+    for (uint64_t count : { static_cast<uint64_t>(1) << 60, static_cast<uint64_t>(bytes.size()), ~static_cast<uint64_t>(0) }) {
+        std::string corrupt = bytes;
+        std::memcpy(&corrupt[12], &count, sizeof(count));
+        {
+            std::ofstream file(snapshotPath, std::ios::binary);
+            file.write(corrupt.data(), static_cast<std::streamsize>(corrupt.size()));
+        }
+        CompressedGraph loaded;
+        bool accepted = true;
+        EXPECT_NO_THROW(accepted = loaded.loadFromFile(snapshotPath));
+        EXPECT_FALSE(accepted) << count;
+        EXPECT_EQ(loaded.vertexCount(), 0u);
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
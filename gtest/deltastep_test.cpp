@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/DeltaStepping.h"
+#include "../include/Jobs.h"
+#include "../include/Parallel.h"
+#include <mutex>
+#include <set>
+#include <thread>
+#include "TestGraphs.h"
+
+static void expectSameTree(const ShortestPathTree& expected, const ShortestPathTree& actual) {
+    ASSERT_EQ(expected.distance.size(), actual.distance.size());
+    EXPECT_TRUE(actual.complete);
+    EXPECT_EQ(expected.settled, actual.settled);
+    for (size_t v = 0; v < expected.distance.size(); ++v) {
+        ASSERT_EQ(expected.distance[v], actual.distance[v]) << "vertex " << v;
+        ASSERT_EQ(expected.parent[v], actual.parent[v]) << "vertex " << v;
+    }
+}
+
+// 测试用例 1：不同 delta 与线程数下，距离与父节点都和顺序 Dijkstra 完全一致
+TEST(DeltaSteppingTest, MatchesDijkstra) {
+    Graph graph = randomGraph(20000, 120000, 6, 1);
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    const uint32_t deltas[] = { 0, 1, 3, 100 };
+    const unsigned threadCounts[] = { 1, 4 };
+    for (CsrGraph::VertexId source : { 0u, 777u, 19999u }) {
+        ShortestPathTree expected = buildShortestPathTree(*csr, source);
+        for (uint32_t delta : deltas) {
+            for (unsigned threads : threadCounts) {
+                DeltaSteppingOptions options;
+                options.delta = delta;
+                options.threads = threads;
+                SCOPED_TRACE("delta " + std::to_string(delta) + ", threads " + std::to_string(threads));
+                expectSameTree(expected, deltaSteppingTree(*csr, source, options));
+            }
+        }
+    }
+}
+
+// 测试用例 2：只含权重 1 的文本图（逐层展开）与部分不可达的图
+TEST(DeltaSteppingTest, UnitWeightsAndUnreachable) {
+    Graph graph = randomGraph(5000, 15000, 1, 2);
+    graph.addEdge("isolated", "island");
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    CsrGraph::VertexId island = 0;
+    ASSERT_TRUE(csr->findVertex("island", island));
+    ShortestPathTree expected = buildShortestPathTree(*csr, 0);
+    ShortestPathTree actual = deltaSteppingTree(*csr, 0);
+    expectSameTree(expected, actual);
+    EXPECT_EQ(actual.distance[island], std::numeric_limits<double>::infinity());
+    EXPECT_EQ(actual.parent[island], CsrGraph::kNoVertex);
+}
+
+// 测试用例 3：Graph 切换到并行搜索后查询结果不变；取消的搜索不完整
+TEST(DeltaSteppingTest, GraphQueriesAndCancel) {
+    Graph graph = randomGraph(3000, 12000, 4, 3);
+    std::map<std::string, std::pair<double, std::vector<std::string>>> expected = graph.shortestPathsFromSource(wordFor(5));
+    std::pair<double, std::vector<std::string>> expectedPath = graph.shortestPath(wordFor(9), wordFor(2000));
+
+    Graph parallel = randomGraph(3000, 12000, 4, 3);
+    parallel.setPathThreads(4, 2);
+    EXPECT_EQ(parallel.shortestPathsFromSource(wordFor(5)), expected);
+    EXPECT_EQ(parallel.shortestPath(wordFor(9), wordFor(2000)), expectedPath);
+
+    JobControl control;
+    control.requestCancel();
+    ShortestPathTree stopped = deltaSteppingTree(*parallel.csrView(), 0, DeltaSteppingOptions(), &control);
+    EXPECT_FALSE(stopped.complete);
+}
+
+// 测试用例 4：WorkerPool 在多次并行循环之间复用同一组线程，每个下标恰好执行一次
+TEST(DeltaSteppingTest, WorkerPoolReusesThreads) {
+    WorkerPool pool(4);
+    ASSERT_EQ(pool.size(), 4u);
+    std::mutex mutex;
+    std::set<std::thread::id> seen;
+    for (int round = 0; round < 200; ++round) {
+        const size_t count = 1 + static_cast<size_t>(round % 37);
+        std::vector<std::atomic<int>> visits(count);
+        for (std::atomic<int>& visit : visits) {
+            visit.store(0);
+        }
+        pool.forEachWorker(count, true, [&](size_t i, unsigned worker) {
+            EXPECT_LT(worker, pool.size());
+            visits[i].fetch_add(1);
+            std::lock_guard<std::mutex> lock(mutex);
+            seen.insert(std::this_thread::get_id());
+        });
+        for (size_t i = 0; i < count; ++i) {
+            ASSERT_EQ(visits[i].load(), 1) << "round " << round << " index " << i;
+        }
+    }
+    // 调用线程加上最多 3 个辅助线程，不随循环次数增长
+    EXPECT_LE(seen.size(), 4u);
+
+    // 不并行时只在调用线程上执行
+    std::set<std::thread::id> inlineThreads;
+    pool.forEach(100, false, [&](size_t) { inlineThreads.insert(std::this_thread::get_id()); });
+    EXPECT_EQ(inlineThreads, std::set<std::thread::id>({ std::this_thread::get_id() }));
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
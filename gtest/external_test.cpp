@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "../include/ExternalBuilder.h"
+
+// 测试夹具：生成较长文本，用极小的内存预算强制产生多个排序段
+class ExternalBuildTest : public ::testing::Test {
+protected:
+    const std::string testFilePath = "external_test.txt";
+    const std::string secondFilePath = "external_test_2.txt";
+    const std::string snapshotPath = "external_test.tgcg";
+
+    void SetUp() override {
+        std::ofstream testFile(testFilePath);
+        const char* words[] = { "alpha", "Beta", "gamma,", "delta.", "epsilon", "zeta", "eta!", "theta" };
+        unsigned state = 7;
+        for (int i = 0; i < 20000; ++i) {
+            state = state * 1103515245u + 12345u;
+            testFile << words[(state >> 16) % 8] << ((i % 13 == 0) ? "\n" : " ");
+        }
+        testFile.close();
+
+        std::ofstream second(secondFilePath);
+        second << "to explore the strange new worlds to seek the new life and new civilizations";
+        second.close();
+    }
+
+    void TearDown() override {
+        std::remove(testFilePath.c_str());
+        std::remove(secondFilePath.c_str());
+        std::remove(snapshotPath.c_str());
+    }
+
+    static ExternalBuildOptions tinyBudget() {
+        ExternalBuildOptions options;
+        options.memoryBudgetBytes = 64 * 1024; // 4096 个二元组一段
+        options.readChunkBytes = 1000;         // 单词会跨越读取块边界
+        options.tempDir = ".";
+        return options;
+    }
+};
+
+// 测试用例 1：外存构建与 buildFromFile 得到相同的邻接表
+TEST_F(ExternalBuildTest, MatchesInMemoryBuild) {
+    Graph expected;
+    ASSERT_TRUE(expected.buildFromFile(testFilePath));
+
+    ExternalGraphBuilder builder(tinyBudget());
+    ASSERT_TRUE(builder.addFile(testFilePath));
+    Graph actual;
+    ASSERT_TRUE(builder.finishInto(actual));
+
+    EXPECT_GT(builder.report().runs, 1u);
+    EXPECT_EQ(builder.report().tokens, 20000u);
+    EXPECT_EQ(actual.vertexCount(), expected.vertexCount());
+    EXPECT_EQ(actual.edgeCount(), expected.edgeCount());
+    for (const auto& entry : expected.getAdjacencyList()) {
+        std::vector<Graph::Edge> want = entry.second;
+        std::vector<Graph::Edge> got = actual.getAdjacencyList().at(entry.first);
+        std::sort(want.begin(), want.end());
+        std::sort(got.begin(), got.end());
+        ASSERT_EQ(got.size(), want.size()) << entry.first;
+        for (size_t i = 0; i < want.size(); ++i) {
+            EXPECT_EQ(got[i].dest, want[i].dest);
+            EXPECT_EQ(got[i].weight, want[i].weight) << entry.first << " -> " << want[i].dest;
+        }
+    }
+}
+
+// 测试用例 2：多个文件之间不产生跨文件的边
+TEST_F(ExternalBuildTest, NoEdgesAcrossFiles) {
+    Graph expected;
+    ASSERT_TRUE(expected.buildFromFile(testFilePath));
+    ASSERT_TRUE(expected.buildFromFile(secondFilePath));
+
+    ExternalGraphBuilder builder(tinyBudget());
+    ASSERT_TRUE(builder.addFile(testFilePath));
+    ASSERT_TRUE(builder.addFile(secondFilePath));
+    Graph actual;
+    ASSERT_TRUE(builder.finishInto(actual));
+    EXPECT_EQ(actual.edgeCount(), expected.edgeCount());
+    EXPECT_EQ(actual.findBridgeWords("theta", "explore"), expected.findBridgeWords("theta", "explore"));
+}
+
+// 测试用例 3：直接合并到压缩快照
+TEST_F(ExternalBuildTest, SnapshotMatchesCompressedGraph) {
+    Graph expected;
+    ASSERT_TRUE(expected.buildFromFile(testFilePath));
+    CompressedGraph reference(expected);
+
+    ExternalGraphBuilder builder(tinyBudget());
+    ASSERT_TRUE(builder.addFile(testFilePath));
+    ASSERT_TRUE(builder.finishToSnapshot(snapshotPath));
+
+    CompressedGraph loaded;
+    ASSERT_TRUE(loaded.loadFromFile(snapshotPath));
+    EXPECT_EQ(loaded.vertexCount(), reference.vertexCount());
+    EXPECT_EQ(loaded.edgeCount(), reference.edgeCount());
+    EXPECT_EQ(loaded.shortestPath("alpha", "theta"), expected.shortestPath("alpha", "theta"));
+    EXPECT_EQ(loaded.shortestPath("zeta", "beta"), expected.shortestPath("zeta", "beta"));
+}
+
+// 测试用例 4：合并到非空的图时累加已有边的权重
+TEST_F(ExternalBuildTest, FinishIntoExistingGraph) {
+    Graph expected;
+    ASSERT_TRUE(expected.buildFromFile(secondFilePath));
+    expected.addEdge("new", "worlds", 5);
+    expected.addEdge("brave", "new");
+
+    ExternalGraphBuilder builder(tinyBudget());
+    ASSERT_TRUE(builder.addFile(secondFilePath));
+    Graph actual;
+    actual.addEdge("new", "worlds", 5);
+    actual.addEdge("brave", "new");
+    uint64_t before = actual.getVersion();
+    ASSERT_TRUE(builder.finishInto(actual));
+    EXPECT_NE(actual.getVersion(), before);
+
+    EXPECT_EQ(actual.vertexCount(), expected.vertexCount());
+    EXPECT_EQ(actual.edgeCount(), expected.edgeCount());
+    EXPECT_EQ(actual.shortestPath("brave", "civilizations"), expected.shortestPath("brave", "civilizations"));
+    for (const auto& entry : expected.getAdjacencyList()) {
+        std::vector<Graph::Edge> want = entry.second;
+        std::vector<Graph::Edge> got = actual.getAdjacencyList().at(entry.first);
+        std::sort(want.begin(), want.end());
+        std::sort(got.begin(), got.end());
+        ASSERT_EQ(got.size(), want.size()) << entry.first;
+        for (size_t i = 0; i < want.size(); ++i) {
+            EXPECT_EQ(got[i].dest, want[i].dest);
+            EXPECT_EQ(got[i].weight, want[i].weight) << entry.first << " -> " << want[i].dest;
+        }
+    }
+}
+
+// 测试用例 5：段数超过合并扇入上限时分多趟合并，流式写出的快照与内存中压缩的图逐边一致
+TEST_F(ExternalBuildTest, MultiPassSnapshotMatchesEdgeByEdge) {
+    Graph expected;
+    ASSERT_TRUE(expected.buildFromFile(testFilePath));
+    ASSERT_TRUE(expected.buildFromFile(secondFilePath));
+    CompressedGraph reference(expected);
+
+    ExternalBuildOptions options = tinyBudget();
+    options.maxMergeFanIn = 2;
+    ExternalGraphBuilder builder(options);
+    ASSERT_TRUE(builder.addFile(testFilePath));
+    ASSERT_TRUE(builder.addFile(secondFilePath));
+    ASSERT_TRUE(builder.finishToSnapshot(snapshotPath));
+    EXPECT_GT(builder.report().runs, 2u);
+    EXPECT_GT(builder.report().mergePasses, 0u);
+    EXPECT_EQ(builder.report().vertices, reference.vertexCount());
+
+    CompressedGraph loaded;
+    ASSERT_TRUE(loaded.loadFromFile(snapshotPath));
+    ASSERT_EQ(loaded.vertexCount(), reference.vertexCount());
+    ASSERT_EQ(loaded.edgeCount(), reference.edgeCount());
+    EXPECT_EQ(loaded.weightWidth(), reference.weightWidth());
+    for (CompressedGraph::VertexId v = 0; v < reference.vertexCount(); ++v) {
+        ASSERT_EQ(loaded.vertexName(v), reference.vertexName(v));
+        CompressedGraph::NeighborIterator want = reference.neighbors(v);
+        CompressedGraph::NeighborIterator got = loaded.neighbors(v);
+        CompressedGraph::VertexId wantDest, gotDest;
+        uint32_t wantWeight, gotWeight;
+        while (want.next(wantDest, wantWeight)) {
+            ASSERT_TRUE(got.next(gotDest, gotWeight)) << reference.vertexName(v);
+            EXPECT_EQ(gotDest, wantDest);
+            EXPECT_EQ(gotWeight, wantWeight);
+        }
+        EXPECT_FALSE(got.next(gotDest, gotWeight)) << reference.vertexName(v);
+    }
+
+    // 临时的边文件已删除
+    EXPECT_FALSE(std::ifstream(snapshotPath + ".neighbors.tmp").is_open());
+    EXPECT_FALSE(std::ifstream(snapshotPath + ".weights.tmp").is_open());
+}
+
+// 测试用例 6：词表超出内存预算时 addFile 报错失败，而不是无限增长
+TEST_F(ExternalBuildTest, VocabularyOverBudgetFails) {
+    const std::string manyWordsPath = "external_test_words.txt";
+    {
+        std::ofstream file(manyWordsPath);
+        for (int i = 0; i < 5000; ++i) {
+            std::string word;
+            for (int id = i; ; id /= 26) {
+                word += static_cast<char>('a' + id % 26);
+                if (id < 26) {
+                    break;
+                }
+            }
+            file << word << ' ';
+        }
+    }
+    ExternalGraphBuilder builder(tinyBudget());
+    EXPECT_FALSE(builder.addFile(manyWordsPath));
+    EXPECT_LT(builder.report().tokens, 5000u);
+
+    ExternalBuildOptions roomy = tinyBudget();
+    roomy.memoryBudgetBytes = static_cast<size_t>(8) << 20;
+    ExternalGraphBuilder enough(roomy);
+    EXPECT_TRUE(enough.addFile(manyWordsPath));
+    EXPECT_EQ(enough.report().tokens, 5000u);
+    std::remove(manyWordsPath.c_str());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <random>
+#include "../include/GraphBuilder.h"
+#include "TestGraphs.h"
+
+// 逐个比较邻接表（含边的顺序与权重）
+static void expectSameGraph(const Graph& a, const Graph& b) {
+    const std::map<std::string, std::vector<Graph::Edge>>& left = a.getAdjacencyList();
+    const std::map<std::string, std::vector<Graph::Edge>>& right = b.getAdjacencyList();
+    ASSERT_EQ(left.size(), right.size());
+    for (auto l = left.begin(), r = right.begin(); l != left.end(); ++l, ++r) {
+        ASSERT_EQ(l->first, r->first);
+        ASSERT_EQ(l->second.size(), r->second.size()) << l->first;
+        for (size_t i = 0; i < l->second.size(); ++i) {
+            EXPECT_EQ(l->second[i].dest, r->second[i].dest) << l->first;
+            EXPECT_EQ(l->second[i].weight, r->second[i].weight) << l->first;
+        }
+    }
+}
+
+// 测试用例 1：单词编号与边计数在哈希表多次扩容后仍然正确，超长单词单独存放
+TEST(GraphBuilderTest, InternAndCount) {
+    GraphBuilder builder;
+    std::vector<uint32_t> ids;
+    for (int i = 0; i < 50000; ++i) {
+        std::string word = wordFor(i);
+        ids.push_back(builder.intern(word.data(), word.size()));
+        EXPECT_EQ(ids.back(), static_cast<uint32_t>(i));
+    }
+    for (int i = 0; i < 50000; ++i) {
+        std::string word = wordFor(i);
+        ASSERT_EQ(builder.intern(word.data(), word.size()), ids[i]);
+        ASSERT_EQ(builder.word(ids[i]), word);
+    }
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i + 1 < 50000; ++i) {
+            builder.addEdge(ids[i], ids[(i * 7 + 1) % 50000], static_cast<uint32_t>(round + 1));
+        }
+    }
+    EXPECT_EQ(builder.vertexCount(), 50000u);
+    EXPECT_EQ(builder.edgeCount(), 49999u);
+    EXPECT_EQ(builder.weight(ids[10], ids[71]), 6u);
+    EXPECT_EQ(builder.weight(ids[71], ids[10]), 0u);
+
+    std::string longWord(200000, 'q');
+    uint32_t longId = builder.intern(longWord.data(), longWord.size());
+    EXPECT_EQ(builder.word(longId), longWord);
+    EXPECT_EQ(builder.intern("a", 1), ids[0]);
+}
+
+// 测试用例 2：buildFromFile 与逐个调用 addEdge 得到完全相同的图（含边顺序与词频）
+TEST(GraphBuilderTest, BuildMatchesAddEdge) {
+    const std::string path = "graphbuilder_test.txt";
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> pick(0, 400);
+    std::vector<std::string> tokens;
+    {
+        std::ofstream file(path);
+        for (int i = 0; i < 20000; ++i) {
+            tokens.push_back(wordFor(pick(rng) * pick(rng) % 401));
+            file << tokens.back() << (i % 11 == 10 ? ". " : " ");
+        }
+    }
+    Graph built;
+    ASSERT_TRUE(built.buildFromFile(path));
+    std::remove(path.c_str());
+
+    Graph expected;
+    for (size_t i = 0; i + 1 < tokens.size(); ++i) {
+        expected.addEdge(tokens[i], tokens[i + 1]);
+    }
+    expectSameGraph(expected, built);
+    EXPECT_EQ(built.stats().build.tokens, tokens.size());
+    EXPECT_EQ(built.getCorpusTerms().at(tokens[0]).termFrequency,
+        static_cast<uint64_t>(std::count(tokens.begin(), tokens.end(), tokens[0])));
+    EXPECT_NE(built.getVersion(), 0u);
+}
+
+// 测试用例 3：只有一个单词的文档不产生顶点
+TEST(GraphBuilderTest, SingleWordDocument) {
+    const std::string path = "graphbuilder_single.txt";
+    {
+        std::ofstream file(path);
+        file << "Lonely!";
+    }
+    Graph graph;
+    ASSERT_TRUE(graph.buildFromFile(path));
+    std::remove(path.c_str());
+    EXPECT_EQ(graph.vertexCount(), 0u);
+    EXPECT_EQ(graph.stats().build.documents, 1u);
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/HopSearch.h"
+#include "../include/PathCache.h"
+#include "TestGraphs.h"
+
+static void expectSameHops(const ShortestPathTree& expected, const HopSearchResult& actual) {
+    ASSERT_EQ(expected.distance.size(), actual.hops.size());
+    size_t reached = 0;
+    for (size_t v = 0; v < actual.hops.size(); ++v) {
+        if (expected.distance[v] == std::numeric_limits<double>::infinity()) {
+            ASSERT_EQ(actual.hops[v], HopSearchResult::kUnreached) << "vertex " << v;
+        }
+        else {
+            ASSERT_EQ(static_cast<double>(actual.hops[v]), expected.distance[v]) << "vertex " << v;
+            reached++;
+        }
+    }
+    EXPECT_EQ(actual.reached, reached);
+}
+
+// 测试用例 1：自顶向下、自底向上与混合策略在任意线程数下的跳数都与逐层 BFS 一致
+TEST(HopSearchTest, MatchesLevelBfs) {
+    Graph graph = randomGraph(30000, 200000, 3, 1);
+    graph.addEdge("lonely", "island");
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    CsrGraph in = csr->transpose();
+    for (CsrGraph::VertexId source : { 0u, 4321u, 29999u }) {
+        ShortestPathTree expected = buildHopTree(*csr, source);
+        for (double alpha : { 1e-9, 14.0, 1e9 }) {
+            for (unsigned threads : { 1u, 4u }) {
+                HopSearchOptions options;
+                options.alpha = alpha;
+                options.threads = threads;
+                SCOPED_TRACE("alpha " + std::to_string(alpha) + ", threads " + std::to_string(threads));
+                HopSearchResult result = hopSearch(*csr, in, source, options);
+                expectSameHops(expected, result);
+                if (alpha == 1e-9) {
+                    EXPECT_EQ(result.bottomUpSteps, 0u);
+                }
+                else {
+                    EXPECT_GT(result.bottomUpSteps, 0u);
+                }
+            }
+        }
+    }
+}
+
+// 测试用例 2：maxHops 截断与目标顶点提前结束
+TEST(HopSearchTest, DepthLimitAndTarget) {
+    Graph graph = randomGraph(5000, 20000, 1, 2);
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    CsrGraph in = csr->transpose();
+    ShortestPathTree expected = buildHopTree(*csr, 7);
+
+    HopSearchOptions options;
+    options.maxHops = 2;
+    HopSearchResult limited = hopSearch(*csr, in, 7, options);
+    EXPECT_LE(limited.levels, 2u);
+    for (size_t v = 0; v < expected.distance.size(); ++v) {
+        if (expected.distance[v] <= 2) {
+            EXPECT_EQ(static_cast<double>(limited.hops[v]), expected.distance[v]);
+        }
+        else {
+            EXPECT_EQ(limited.hops[v], HopSearchResult::kUnreached);
+        }
+    }
+
+    CsrGraph::VertexId target = 0;
+    for (size_t v = 0; v < expected.distance.size(); ++v) {
+        if (expected.distance[v] == 3) {
+            target = static_cast<CsrGraph::VertexId>(v);
+            break;
+        }
+    }
+    options = HopSearchOptions();
+    options.target = target;
+    HopSearchResult early = hopSearch(*csr, in, 7, options);
+    EXPECT_EQ(early.hops[target], 3u);
+    EXPECT_EQ(early.levels, 3u);
+}
+
+// 测试用例 3：Graph 的跳数、k 跳邻域与可达集合查询
+TEST(HopSearchTest, GraphQueries) {
+    Graph graph;
+    graph.addEdge("one", "two");
+    graph.addEdge("two", "three");
+    graph.addEdge("three", "four");
+    graph.addEdge("one", "three");
+    graph.addEdge("five", "one");
+
+    EXPECT_EQ(graph.hopDistance("one", "four"), 2);
+    EXPECT_EQ(graph.hopDistance("one", "one"), 0);
+    EXPECT_EQ(graph.hopDistance("four", "one"), -1);
+    EXPECT_EQ(graph.hopDistance("one", "missing"), -1);
+
+    std::map<std::string, uint32_t> nearby = graph.neighborhood("one", 1);
+    std::map<std::string, uint32_t> expectedNearby = { { "three", 1 }, { "two", 1 } };
+    EXPECT_EQ(nearby, expectedNearby);
+    std::vector<std::string> reachable = graph.reachableSet("one");
+    std::vector<std::string> expectedReachable = { "four", "three", "two" };
+    EXPECT_EQ(reachable, expectedReachable);
+    EXPECT_TRUE(graph.reachableSet("missing").empty());
+
+    Graph large = randomGraph(3000, 9000, 4, 3);
+    large.setPathThreads(4);
+    for (int i = 0; i < 20; ++i) {
+        std::string from = wordFor(i * 37), to = wordFor(i * 101 + 5);
+        EXPECT_EQ(large.hopDistance(from, to) >= 0, large.isReachable(from, to)) << from << " -> " << to;
+        EXPECT_EQ(large.hopDistance(from, to), static_cast<int>(large.shortestPath(from, to, PathCost::Hops).first));
+    }
+}
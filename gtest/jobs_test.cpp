@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <random>
+#include "../include/Jobs.h"
+#include "../include/Graph.h"
+#include "TestGraphs.h"
+
+static Graph chainGraph(int vertices) {
+    Graph graph;
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> pick(0, vertices - 1);
+    for (int v = 0; v + 1 < vertices; ++v) {
+        graph.addEdge(wordFor(v), wordFor(v + 1));
+        graph.addEdge(wordFor(v), wordFor(pick(rng)));
+    }
+    return graph;
+}
+
+static void waitUntilDone(const Job& job) {
+    while (job.state() == JobState::Running) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+// 测试用例 1：后台任务正常完成并报告进度
+TEST(JobsTest, JobFinishesWithProgress) {
+    Graph graph = chainGraph(300);
+    JobManager manager;
+    std::shared_ptr<std::map<std::string, double>> ranks = std::make_shared<std::map<std::string, double>>();
+    bool presented = false;
+    std::shared_ptr<Job> job = manager.start("PageRank", std::chrono::milliseconds(0),
+        [&graph, ranks](JobControl& control) {
+            *ranks = graph.calculatePageRank(0.85, std::map<std::string, double>(), 20, &control);
+            return !control.shouldStop();
+        },
+        [&presented]() { presented = true; });
+    job->wait();
+    EXPECT_EQ(job->state(), JobState::Finished);
+    EXPECT_EQ(job->control().progressDone(), 20u);
+    EXPECT_EQ(job->control().progressTotal(), 20u);
+    EXPECT_EQ(ranks->size(), graph.vertexCount());
+    job->presentResult();
+    EXPECT_TRUE(presented);
+    EXPECT_TRUE(manager.remove(job->id()));
+    EXPECT_TRUE(manager.list().empty());
+}
+
+// 测试用例 2：协作式取消使 PageRank 提前结束并返回空结果
+TEST(JobsTest, CancelStopsPageRank) {
+    Graph graph = chainGraph(2000);
+    JobManager manager;
+    std::shared_ptr<std::map<std::string, double>> ranks = std::make_shared<std::map<std::string, double>>();
+    std::shared_ptr<Job> job = manager.start("PageRank", std::chrono::milliseconds(0),
+        [&graph, ranks](JobControl& control) {
+            *ranks = graph.calculatePageRank(0.85, std::map<std::string, double>(), 1000000, &control);
+            return !control.shouldStop();
+        },
+        []() {});
+    while (job->control().progressDone() < 2) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_FALSE(manager.remove(job->id())); // 仍在运行
+    job->cancel();
+    waitUntilDone(*job);
+    EXPECT_EQ(job->state(), JobState::Cancelled);
+    EXPECT_TRUE(ranks->empty());
+    EXPECT_LT(job->control().progressDone(), 1000000u);
+}
+
+// 测试用例 3：超过期限的全源最短路径任务超时，未完成的树不进入缓存
+TEST(JobsTest, DeadlineStopsAllPaths) {
+    Graph graph = chainGraph(20000);
+    graph.csrView();
+    JobControl control;
+    control.setDeadline(std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    EXPECT_TRUE(control.deadlinePassed());
+    EXPECT_TRUE(graph.shortestPathsFromSource(wordFor(0), &control).empty());
+    EXPECT_EQ(graph.stats().pathCache.entries, 0u);
+
+    JobManager manager;
+    std::shared_ptr<Job> job = manager.start("All paths", std::chrono::milliseconds(1),
+        [&graph](JobControl& jobControl) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            graph.shortestPathsFromSource(wordFor(1), &jobControl);
+            return !jobControl.shouldStop();
+        },
+        []() {});
+    waitUntilDone(*job);
+    EXPECT_EQ(job->state(), JobState::TimedOut);
+
+    // 不带控制时照常得到完整结果
+    EXPECT_EQ(graph.shortestPathsFromSource(wordFor(0)).size(), graph.vertexCount() - 1);
+}
+
+// 测试用例 4：带 JobControl 运行的 PageRank 不向标准输出打印，以免打断交互提示
+TEST(JobsTest, BackgroundRanksStayQuiet) {
+    const std::string path = "jobs_test.txt";
+    {
+        std::ofstream file(path);
+        file << "to explore the strange new worlds to seek the new life and new civilizations";
+    }
+    Graph graph;
+    ASSERT_TRUE(graph.buildFromFile(path));
+
+    JobControl control;
+    testing::internal::CaptureStdout();
+    EXPECT_FALSE(graph.calculatePageRank(0.85, std::map<std::string, double>(), 20, &control).empty());
+    EXPECT_FALSE(graph.calculatePageRankWithTfIdf(0.85, 20, &control).empty());
+    EXPECT_FALSE(graph.calculatePageRankWithTfIdf(path, 0.85, 20, &control).empty());
+    EXPECT_EQ(testing::internal::GetCapturedStdout(), "");
+
+    // 前台调用保留原有的初始值输出
+    testing::internal::CaptureStdout();
+    graph.calculatePageRank();
+    graph.calculatePageRankWithTfIdf(0.85, 20);
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_NE(output.find("initialRank"), std::string::npos);
+    EXPECT_NE(output.find("TF-IDF initialRank"), std::string::npos);
+    std::remove(path.c_str());
+}
+
+// 测试用例 5：算法跑完后才到的取消不算中断；算法在检查点看到取消才算
+TEST(JobsTest, LateCancelKeepsFinishedResult) {
+    Graph graph = randomGraph(200, 800, 5, 7);
+
+    JobControl late;
+    std::map<std::string, double> ranks = graph.calculatePageRank(0.85, std::map<std::string, double>(), 20, &late);
+    late.requestCancel();
+    EXPECT_FALSE(ranks.empty());
+    EXPECT_FALSE(late.interrupted());
+
+    JobControl early;
+    early.requestCancel();
+    EXPECT_TRUE(graph.calculatePageRank(0.85, std::map<std::string, double>(), 20, &early).empty());
+    EXPECT_TRUE(early.interrupted());
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include "../include/CsrGraph.h"
+#include "../include/LazyCache.h"
+#include "TestGraphs.h"
+
+// 测试用例 1：并发 get 只构建一次；版本变化后重建，peek 不触发构建
+TEST(LazyCacheTest, BuildsOncePerVersion) {
+    LazyCache<int> cache;
+    std::atomic<int> builds(0);
+    auto build = [&builds]() {
+        builds++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return std::make_shared<const int>(42);
+    };
+    EXPECT_FALSE(cache.peek(7));
+
+    std::vector<std::thread> threads;
+    std::atomic<int> seen(0);
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() { seen += *cache.get(7, build); });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(builds.load(), 1);
+    EXPECT_EQ(seen.load(), 8 * 42);
+    EXPECT_EQ(*cache.peek(7), 42);
+    EXPECT_FALSE(cache.peek(8));
+
+    LazyCache<int> copy(cache);
+    EXPECT_EQ(copy.peek(7), cache.peek(7));
+    cache.get(8, build);
+    EXPECT_EQ(builds.load(), 2);
+    EXPECT_FALSE(cache.peek(7));
+    EXPECT_TRUE(copy.peek(7));
+}
+
+// 测试用例 2：Graph 的派生结构在查询间复用，addEdge 后失效
+TEST(LazyCacheTest, GraphReusesViewsUntilChanged) {
+    Graph graph;
+    for (int i = 0; i < 200; ++i) {
+        graph.addEdge(wordFor(i), wordFor((i * 7 + 3) % 200), 1 + i % 4);
+    }
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    EXPECT_EQ(graph.csrView(), csr);
+    graph.findBridgeWords(wordFor(1), wordFor(2));
+    graph.randomWalk();
+    EXPECT_EQ(graph.csrView(), csr);
+
+    Graph copy(graph);
+    EXPECT_EQ(copy.csrView(), csr);
+    graph.addEdge("fresh", wordFor(0));
+    EXPECT_NE(graph.csrView(), csr);
+    EXPECT_TRUE(graph.containsWord("fresh"));
+    EXPECT_FALSE(copy.containsWord("fresh"));
+    EXPECT_EQ(copy.csrView(), csr);
+}
+
+// 测试用例 3：多个线程同时对同一图做只读查询，结果与串行一致
+TEST(LazyCacheTest, ConcurrentConstQueries) {
+    Graph graph;
+    for (int i = 0; i < 3000; ++i) {
+        graph.addEdge(wordFor(i % 500), wordFor((i * 31 + 11) % 500), 1 + i % 3);
+    }
+    Graph reference(graph);
+    std::vector<std::vector<std::string>> expectedBridges;
+    for (int i = 0; i < 50; ++i) {
+        expectedBridges.push_back(reference.findBridgeWords(wordFor(i), wordFor(i + 100)));
+    }
+    std::map<std::string, double> expectedRanks = reference.calculatePageRank(0.85, std::map<std::string, double>(), 20);
+
+    const Graph& shared = graph;
+    std::atomic<int> mismatches(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 6; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 50; ++i) {
+                int word = (i + t * 7) % 50;
+                if (shared.findBridgeWords(wordFor(word), wordFor(word + 100)) != expectedBridges[word]) {
+                    mismatches++;
+                }
+                if (!shared.isReachable(wordFor(word), wordFor(word + 1)) &&
+                    shared.shortestPath(wordFor(word), wordFor(word + 1)).first != -1) {
+                    mismatches++;
+                }
+            }
+            if (t % 2 == 0 && shared.calculatePageRank(0.85, std::map<std::string, double>(), 20) != expectedRanks) {
+                mismatches++;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(mismatches.load(), 0);
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <random>
+#include "../include/Graph.h"
+
+// 逐个比较邻接表（含边的顺序与权重）
+static void expectSameGraph(const Graph& a, const Graph& b) {
+    const std::map<std::string, std::vector<Graph::Edge>>& left = a.getAdjacencyList();
+    const std::map<std::string, std::vector<Graph::Edge>>& right = b.getAdjacencyList();
+    ASSERT_EQ(left.size(), right.size());
+    for (auto l = left.begin(), r = right.begin(); l != left.end(); ++l, ++r) {
+        ASSERT_EQ(l->first, r->first);
+        ASSERT_EQ(l->second.size(), r->second.size()) << l->first;
+        for (size_t i = 0; i < l->second.size(); ++i) {
+            EXPECT_EQ(l->second[i].dest, r->second[i].dest) << l->first;
+            EXPECT_EQ(l->second[i].weight, r->second[i].weight) << l->first;
+        }
+    }
+}
+
+class MergeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 rng(7);
+        const char* vocabulary[] = { "alpha", "beta", "gamma", "delta", "epsilon", "zeta", "eta", "theta" };
+        std::uniform_int_distribution<int> pick(0, 7);
+        for (int f = 0; f < 23; ++f) {
+            std::string path = "merge_test_" + std::to_string(f) + ".txt";
+            std::ofstream file(path);
+            int words = 5 + f * 13;
+            for (int w = 0; w < words; ++w) {
+                file << vocabulary[pick(rng)] << (w % 9 == 8 ? ".\n" : " ");
+            }
+            files.push_back(path);
+        }
+    }
+
+    void TearDown() override {
+        for (const std::string& path : files) {
+            std::remove(path.c_str());
+        }
+    }
+
+    std::vector<std::string> files;
+};
+
+// 测试用例 1：多线程构建与逐个文件串行构建得到完全相同的图
+TEST_F(MergeTest, ParallelMatchesSerial) {
+    Graph serial;
+    for (const std::string& path : files) {
+        ASSERT_TRUE(serial.buildFromFile(path));
+    }
+    Graph parallel;
+    ASSERT_TRUE(parallel.buildFromFiles(files, 4));
+    expectSameGraph(serial, parallel);
+    EXPECT_EQ(parallel.stats().build.documents, files.size());
+    EXPECT_EQ(parallel.stats().build.tokens, serial.stats().build.tokens);
+}
+
+// 测试用例 2：合并时权重相加、词表取并集，文件之间没有边
+TEST_F(MergeTest, MergeSumsWeightsWithoutCrossFileEdges) {
+    std::ofstream("merge_a.txt") << "red fish blue fish";
+    std::ofstream("merge_b.txt") << "fish blue sky";
+    Graph graph;
+    ASSERT_TRUE(graph.buildFromFiles({ "merge_a.txt", "merge_b.txt" }, 2));
+    std::remove("merge_a.txt");
+    std::remove("merge_b.txt");
+
+    const std::map<std::string, std::vector<Graph::Edge>>& adjacency = graph.getAdjacencyList();
+    ASSERT_EQ(adjacency.size(), 4u);
+    ASSERT_EQ(adjacency.at("fish").size(), 1u);
+    EXPECT_EQ(adjacency.at("fish")[0].dest, "blue");
+    EXPECT_EQ(adjacency.at("fish")[0].weight, 2);
+    EXPECT_EQ(adjacency.at("blue").size(), 2u); // blue->fish、blue->sky，没有 fish(a 结尾)->fish(b 开头)
+
+    // 每个文件一个文档：fish 在 a 中出现 2 次、b 中 1 次
+    const std::map<std::string, Graph::TermCounts>& terms = graph.getCorpusTerms();
+    EXPECT_EQ(terms.at("fish").termFrequency, 3u);
+    EXPECT_EQ(terms.at("fish").documentFrequency, 2u);
+    EXPECT_EQ(terms.at("red").termFrequency, 1u);
+    EXPECT_EQ(terms.at("red").documentFrequency, 1u);
+    EXPECT_EQ(terms.at("sky").documentFrequency, 1u);
+
+    // 只在一个文档中出现的词 IDF 更高
+    std::map<std::string, double> ranks = graph.calculateTfIdfRanks();
+    EXPECT_GT(ranks.at("red"), ranks.at("fish"));
+}
+
+// 测试用例 3：与自身合并使所有权重翻倍
+TEST_F(MergeTest, SelfMergeDoublesWeights) {
+    Graph graph;
+    graph.addEdge("a", "b", 2);
+    graph.addEdge("b", "c", 1);
+    uint64_t before = graph.getVersion();
+    graph.merge(graph);
+    EXPECT_NE(graph.getVersion(), before);
+    EXPECT_EQ(graph.getAdjacencyList().at("a")[0].weight, 4);
+    EXPECT_EQ(graph.getAdjacencyList().at("b")[0].weight, 2);
+    EXPECT_EQ(graph.shortestPath("a", "c").first, 6);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
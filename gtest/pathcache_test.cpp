@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include "../include/PathCache.h"
+#include "TestGraphs.h"
+
+// Bellman-Ford 作为距离对照
+static std::vector<double> referenceDistances(const CsrGraph& csr, CsrGraph::VertexId source) {
+    std::vector<double> dist(csr.vertexCount(), std::numeric_limits<double>::infinity());
+    dist[source] = 0;
+    for (size_t round = 0; round < csr.vertexCount(); ++round) {
+        bool changed = false;
+        for (CsrGraph::VertexId u = 0; u < csr.vertexCount(); ++u) {
+            const uint32_t* w = csr.weightsBegin(u);
+            for (const CsrGraph::VertexId* t = csr.targetsBegin(u); t != csr.targetsEnd(u); ++t, ++w) {
+                if (dist[u] + *w < dist[*t]) {
+                    dist[*t] = dist[u] + *w;
+                    changed = true;
+                }
+            }
+        }
+        if (!changed) {
+            break;
+        }
+    }
+    return dist;
+}
+
+// 测试用例 1：最短路径树的距离与 Bellman-Ford 一致，路径权重之和等于距离
+TEST(PathCacheTest, TreeMatchesReference) {
+    Graph graph = uniformGraph(300, 1200, 4, 1);
+    CsrGraph csr(graph);
+    for (CsrGraph::VertexId source = 0; source < csr.vertexCount(); source += 17) {
+        ShortestPathTree tree = buildShortestPathTree(csr, source);
+        std::vector<double> expected = referenceDistances(csr, source);
+        for (CsrGraph::VertexId v = 0; v < csr.vertexCount(); ++v) {
+            ASSERT_EQ(tree.distance[v], expected[v]);
+            std::pair<double, std::vector<std::string>> path = graph.shortestPath(csr.name(source), csr.name(v));
+            if (expected[v] == std::numeric_limits<double>::infinity()) {
+                EXPECT_EQ(path.first, -1);
+            }
+            else {
+                EXPECT_EQ(path.first, expected[v]);
+                EXPECT_EQ(path.second.front(), csr.name(source));
+                EXPECT_EQ(path.second.back(), csr.name(v));
+            }
+        }
+    }
+}
+
+// 测试用例 2：源点第一次查询只做剪枝搜索，重复时才建完整树并缓存，addEdge 之后自动失效
+TEST(PathCacheTest, HitsAndInvalidation) {
+    Graph graph;
+    graph.addEdge("a", "b", 5);
+    graph.addEdge("b", "c", 1);
+    graph.addEdge("a", "d", 1);
+
+    EXPECT_EQ(graph.shortestPath("a", "c").first, 6);
+    EXPECT_EQ(graph.stats().pathCache.misses, 1u);
+    EXPECT_EQ(graph.stats().pathCache.entries, 0u); // 剪枝得到的部分树不进入缓存
+    EXPECT_EQ(graph.shortestPath("a", "b").first, 5);
+    EXPECT_EQ(graph.stats().pathCache.misses, 2u);
+    EXPECT_EQ(graph.stats().pathCache.entries, 1u);
+    EXPECT_EQ(graph.shortestPathsFromSource("a").size(), 3u);
+    PathCacheStats stats = graph.stats().pathCache;
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_EQ(graph.stats().queries.lastVerticesSettled, 0u);
+
+    graph.addEdge("d", "c", 1);
+    std::pair<double, std::vector<std::string>> path = graph.shortestPath("a", "c");
+    EXPECT_EQ(path.first, 2);
+    EXPECT_EQ(path.second, std::vector<std::string>({"a", "d", "c"}));
+    EXPECT_EQ(graph.stats().pathCache.misses, 3u);
+    EXPECT_EQ(graph.stats().pathCache.entries, 0u);
+}
+
+// 测试用例 3：超出内存预算时淘汰最久未使用的树
+TEST(PathCacheTest, EvictsLeastRecentlyUsed) {
+    Graph graph = uniformGraph(100, 300, 4, 2);
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    ShortestPathCache cache(0);
+    std::shared_ptr<ShortestPathTree> tree = std::make_shared<ShortestPathTree>(buildShortestPathTree(*csr, 0));
+    size_t treeBytes = tree->memoryBytes();
+    cache.setMemoryBudget(treeBytes * 2);
+
+    for (CsrGraph::VertexId source = 0; source < 3; ++source) {
+        std::shared_ptr<ShortestPathTree> built = std::make_shared<ShortestPathTree>(buildShortestPathTree(*csr, source));
+        built->version = 7;
+        cache.insert(built);
+        if (source == 1) {
+            EXPECT_TRUE(cache.find(0, 7) != nullptr); // 0 变为最近使用
+        }
+    }
+    EXPECT_TRUE(cache.find(0, 7) != nullptr);
+    EXPECT_TRUE(cache.find(1, 7) == nullptr);
+    EXPECT_TRUE(cache.find(2, 7) != nullptr);
+    PathCacheStats stats = cache.stats();
+    EXPECT_EQ(stats.entries, 2u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_LE(stats.bytes, stats.budgetBytes);
+
+    // 新版本的查询清空旧树
+    EXPECT_TRUE(cache.find(0, 8) == nullptr);
+    EXPECT_EQ(cache.stats().entries, 0u);
+}
+
+// 测试用例 4：多线程并发查找与插入
+TEST(PathCacheTest, ConcurrentAccess) {
+    Graph graph = uniformGraph(200, 800, 4, 3);
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    ShortestPathCache cache;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.push_back(std::thread([&cache, &csr, t]() {
+            for (CsrGraph::VertexId source = 0; source < 50; ++source) {
+                CsrGraph::VertexId key = (source * 7 + t) % 50;
+                if (!cache.find(key, 1)) {
+                    std::shared_ptr<ShortestPathTree> built = std::make_shared<ShortestPathTree>(buildShortestPathTree(*csr, key));
+                    built->version = 1;
+                    cache.insert(built);
+                }
+            }
+        }));
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    PathCacheStats stats = cache.stats();
+    EXPECT_EQ(stats.hits + stats.misses, 200u);
+    EXPECT_EQ(stats.entries, 50u);
+}
+
+// 测试用例 5：带目标的搜索在目标确定后停止，距离与路径与完整树一致（Dijkstra 与按跳数的 BFS）
+TEST(PathCacheTest, PrunedSearchMatchesFullTree) {
+    Graph graph = uniformGraph(400, 1600, 4, 5);
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    for (CsrGraph::VertexId source = 0; source < 3; ++source) {
+        ShortestPathTree full = buildShortestPathTree(*csr, source);
+        ShortestPathTree hops = buildHopTree(*csr, source);
+        for (CsrGraph::VertexId target = 0; target < csr->vertexCount(); ++target) {
+            ShortestPathTree pruned = buildShortestPathTree(*csr, source, nullptr, target);
+            EXPECT_EQ(pruned.distance[target], full.distance[target]);
+            EXPECT_EQ(pruned.pathTo(*csr, target), full.pathTo(*csr, target));
+            EXPECT_LE(pruned.settled, full.settled);
+            ShortestPathTree prunedHops = buildHopTree(*csr, source, nullptr, target);
+            EXPECT_EQ(prunedHops.distance[target], hops.distance[target]);
+            EXPECT_EQ(prunedHops.pathTo(*csr, target), hops.pathTo(*csr, target));
+        }
+    }
+
+    // Graph::shortestPath：离源点最近的目标只确定少数顶点
+    ShortestPathTree full = buildShortestPathTree(*csr, 0);
+    CsrGraph::VertexId nearest = csr->targetsBegin(0)[0];
+    for (CsrGraph::VertexId v = 1; v < csr->vertexCount(); ++v) {
+        if (full.distance[v] < full.distance[nearest]) {
+            nearest = v;
+        }
+    }
+    EXPECT_EQ(graph.shortestPath(csr->name(0), csr->name(nearest)).first, full.distance[nearest]);
+    EXPECT_LT(graph.stats().queries.lastVerticesSettled, full.settled);
+    EXPECT_EQ(graph.stats().pathCache.entries, 0u);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/Graph.h"
+#include "../include/EdgeCost.h"
+#include "../include/PathCache.h"
+#include "TestGraphs.h"
+
+// Bellman-Ford 参考实现，返回每个顶点的最短距离
+template <class Cost>
+static std::vector<double> referenceDistances(const CsrGraph& graph, CsrGraph::VertexId source, const Cost& cost) {
+    std::vector<double> distance(graph.vertexCount(), std::numeric_limits<double>::infinity());
+    distance[source] = 0;
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (CsrGraph::VertexId v = 0; v < graph.vertexCount(); ++v) {
+            for (uint32_t e = graph.rowOffsets()[v]; e < graph.rowOffsets()[v + 1]; ++e) {
+                double alt = distance[v] + cost(e, graph.edgeWeight(e));
+                if (alt < distance[graph.edgeTarget(e)] - 1e-12) {
+                    distance[graph.edgeTarget(e)] = alt;
+                    changed = true;
+                }
+            }
+        }
+    }
+    return distance;
+}
+
+template <class Cost>
+static void expectMatchesReference(const CsrGraph& graph, CsrGraph::VertexId source, const Cost& cost) {
+    ShortestPathTree tree = buildShortestPathTree(graph, source, cost);
+    std::vector<double> expected = referenceDistances(graph, source, cost);
+    for (CsrGraph::VertexId v = 0; v < graph.vertexCount(); ++v) {
+        if (expected[v] == std::numeric_limits<double>::infinity()) {
+            ASSERT_EQ(tree.distance[v], expected[v]) << "vertex " << v;
+            continue;
+        }
+        ASSERT_NEAR(tree.distance[v], expected[v], 1e-9) << "vertex " << v;
+        if (v != source) {
+            ASSERT_NE(tree.parent[v], CsrGraph::kNoVertex);
+            EXPECT_LE(tree.distance[tree.parent[v]], tree.distance[v]);
+        }
+    }
+}
+
+// 测试用例 1：按跳数的 BFS 树与所有边权为 1 的图上的 Dijkstra 完全一致
+TEST(PathCostTest, HopTreeMatchesUnitDijkstra) {
+    Graph weighted = randomGraph(4000, 20000, 9, 1);
+    Graph unit;
+    for (const auto& entry : weighted.getAdjacencyList()) {
+        for (const Graph::Edge& edge : entry.second) {
+            unit.addEdge(entry.first, edge.dest, 1);
+        }
+    }
+    std::shared_ptr<const CsrGraph> csr = weighted.csrView();
+    std::shared_ptr<const CsrGraph> unitCsr = unit.csrView();
+    ASSERT_EQ(csr->vertexCount(), unitCsr->vertexCount());
+    for (CsrGraph::VertexId source : { 0u, 123u, 3999u }) {
+        ShortestPathTree hops = buildHopTree(*csr, source);
+        ShortestPathTree expected = buildShortestPathTree(*unitCsr, source);
+        EXPECT_EQ(hops.cost, PathCost::Hops);
+        EXPECT_EQ(hops.settled, expected.settled);
+        for (CsrGraph::VertexId v = 0; v < csr->vertexCount(); ++v) {
+            ASSERT_EQ(hops.distance[v], expected.distance[v]) << "vertex " << v;
+            ASSERT_EQ(hops.parent[v], expected.parent[v]) << "vertex " << v;
+        }
+    }
+}
+
+// 测试用例 2：倒数频率与负对数概率代价的距离与参考实现一致
+TEST(PathCostTest, WeightedCostsMatchReference) {
+    Graph graph = randomGraph(300, 1500, 20, 2);
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    NegativeLogProbabilityCost logProbability(*csr);
+    for (CsrGraph::VertexId source : { 0u, 42u, 299u }) {
+        expectMatchesReference(*csr, source, InverseFrequencyCost());
+        expectMatchesReference(*csr, source, logProbability);
+    }
+    for (double cost : logProbability.costs) {
+        EXPECT_GE(cost, 0.0);
+    }
+}
+
+// 测试用例 3：高频转移在 -log P 下更短，而按原始计数则相反
+TEST(PathCostTest, CostChangesChosenPath) {
+    Graph graph;
+    graph.addEdge("the", "cat", 9);
+    graph.addEdge("cat", "sat", 9);
+    graph.addEdge("the", "sat", 1);
+    graph.addEdge("the", "dog", 1);
+
+    std::vector<std::string> direct = { "the", "sat" };
+    std::vector<std::string> frequent = { "the", "cat", "sat" };
+    EXPECT_EQ(graph.shortestPath("the", "sat").second, direct);
+    EXPECT_EQ(graph.shortestPath("the", "sat", PathCost::Hops).second, direct);
+    EXPECT_EQ(graph.shortestPath("the", "sat", PathCost::InverseFrequency).second, frequent);
+    std::pair<double, std::vector<std::string>> likely = graph.shortestPath("the", "sat", PathCost::NegativeLogProbability);
+    EXPECT_EQ(likely.second, frequent);
+    EXPECT_NEAR(likely.first, -std::log(9.0 / 11.0), 1e-12);
+    EXPECT_EQ(graph.shortestPath("the", "sat", PathCost::Hops).first, 1);
+}
+
+// 测试用例 4：不同代价的树分别缓存，修改图后全部失效
+TEST(PathCostTest, CacheKeepsCostsApart) {
+    Graph graph = randomGraph(500, 2500, 5, 3);
+    std::map<std::string, std::pair<double, std::vector<std::string>>> counts = graph.shortestPathsFromSource(wordFor(1));
+    std::map<std::string, std::pair<double, std::vector<std::string>>> hops =
+        graph.shortestPathsFromSource(wordFor(1), nullptr, PathCost::Hops);
+    EXPECT_EQ(graph.stats().pathCache.entries, 2u);
+    EXPECT_EQ(graph.shortestPathsFromSource(wordFor(1), nullptr, PathCost::Hops), hops);
+    EXPECT_EQ(graph.shortestPathsFromSource(wordFor(1)), counts);
+    EXPECT_EQ(graph.stats().pathCache.hits, 2u);
+
+    graph.addEdge(wordFor(1), wordFor(2), 1);
+    graph.shortestPathsFromSource(wordFor(1), nullptr, PathCost::NegativeLogProbability);
+    EXPECT_EQ(graph.stats().pathCache.entries, 1u);
+}
+
+// 测试用例 5：命令行代价名称解析
+TEST(PathCostTest, ParseNames) {
+    PathCost cost = PathCost::Count;
+    EXPECT_TRUE(parsePathCost("logprob", cost));
+    EXPECT_EQ(cost, PathCost::NegativeLogProbability);
+    EXPECT_TRUE(parsePathCost("hops", cost));
+    EXPECT_EQ(cost, PathCost::Hops);
+    EXPECT_TRUE(parsePathCost("inverse", cost));
+    EXPECT_EQ(cost, PathCost::InverseFrequency);
+    EXPECT_FALSE(parsePathCost("meters", cost));
+    EXPECT_EQ(cost, PathCost::InverseFrequency);
+    EXPECT_STREQ(pathCostName(PathCost::Count), "count");
+}
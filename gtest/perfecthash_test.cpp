@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include "../include/PerfectHash.h"
+#include "../include/CompressedGraph.h"
+#include "../include/CsrGraph.h"
+#include "TestGraphs.h"
+
+// 测试用例 1：n 个键各自找回自己的编号，且每键只占几个字节
+TEST(PerfectHashTest, BijectiveAndSmall) {
+    const int n = 200000;
+    std::vector<uint64_t> hashes(n);
+    for (int i = 0; i < n; ++i) {
+        hashes[i] = PerfectHash::hashKey(wordFor(i));
+    }
+    PerfectHash index;
+    ASSERT_TRUE(index.build(hashes));
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(index.find(hashes[i]), static_cast<uint32_t>(i));
+    }
+    EXPECT_LT(index.memoryBytes(), static_cast<size_t>(n) * 7);
+
+    // 指纹拒绝大部分不存在的词；剩下的由调用方比较字符串
+    int candidates = 0;
+    for (int i = n; i < 2 * n; ++i) {
+        candidates += index.find(PerfectHash::hashKey(wordFor(i))) != PerfectHash::kNotFound;
+    }
+    EXPECT_LT(candidates, n / 100);
+
+    std::vector<uint64_t> duplicate = { 1, 2, 1 };
+    EXPECT_FALSE(index.build(duplicate));
+    EXPECT_TRUE(index.empty());
+    EXPECT_TRUE(index.build(std::vector<uint64_t>()));
+    EXPECT_EQ(index.find(7), PerfectHash::kNotFound);
+}
+
+// 测试用例 2：CSR 视图与重编号后的视图按词查找得到正确编号，不存在的词查不到
+TEST(PerfectHashTest, CsrLookups) {
+    Graph graph;
+    for (int v = 0; v < 5000; ++v) {
+        graph.addEdge(wordFor(v), wordFor((v * 7 + 3) % 5000));
+    }
+    CsrGraph csr(graph);
+    CsrGraph relabelled = csr.permuted(csr.vertexOrder(VertexOrder::Degree));
+    for (int v = 0; v < 5000; ++v) {
+        CsrGraph::VertexId id = CsrGraph::kNoVertex;
+        ASSERT_TRUE(csr.findVertex(wordFor(v), id));
+        EXPECT_EQ(csr.name(id), wordFor(v));
+        ASSERT_TRUE(relabelled.findVertex(wordFor(v), id));
+        EXPECT_EQ(relabelled.name(id), wordFor(v));
+        EXPECT_FALSE(csr.findVertex(wordFor(v + 5000), id));
+    }
+    EXPECT_TRUE(graph.containsWord("ab"));
+    graph.csrView();
+    EXPECT_TRUE(graph.containsWord("AB"));
+    EXPECT_FALSE(graph.containsWord("unknown"));
+}
+
+// 测试用例 3：完美哈希随快照保存，载入后无需重建即可查词
+TEST(PerfectHashTest, StoredWithSnapshot) {
+    const std::string path = "perfecthash_test.tgcg";
+    Graph graph;
+    for (int v = 0; v < 3000; ++v) {
+        graph.addEdge(wordFor(v), wordFor((v * 13 + 1) % 3000), 1 + v % 5);
+    }
+    CompressedGraph compressed(graph);
+    ASSERT_TRUE(compressed.saveToFile(path));
+    CompressedGraph loaded;
+    ASSERT_TRUE(loaded.loadFromFile(path));
+    std::remove(path.c_str());
+
+    EXPECT_EQ(loaded.memoryBytes(), compressed.memoryBytes());
+    for (int v = 0; v < 3000; ++v) {
+        CompressedGraph::VertexId expected = 0, actual = 0;
+        ASSERT_TRUE(compressed.findVertex(wordFor(v), expected));
+        ASSERT_TRUE(loaded.findVertex(wordFor(v), actual));
+        EXPECT_EQ(actual, expected);
+        EXPECT_EQ(loaded.vertexName(actual), wordFor(v));
+    }
+    CompressedGraph::VertexId id = 0;
+    EXPECT_FALSE(loaded.findVertex("missing", id));
+    EXPECT_EQ(loaded.shortestPath(wordFor(1), wordFor(14)), graph.shortestPath(wordFor(1), wordFor(14)));
+}
+
+// 测试用例 4：键数翻倍时构建耗时大致翻倍（装载因子小于 1，不再随键数超线性增长）
+TEST(PerfectHashTest, BuildScalesLinearly) {
+    std::vector<uint64_t> hashes;
+    double previous = 0.0;
+    for (int n = 12500; n <= 100000; n *= 2) {
+        while (static_cast<int>(hashes.size()) < n) {
+            hashes.push_back(PerfectHash::hashKey(wordFor(static_cast<int>(hashes.size()))));
+        }
+        // 取三次中最快的一次，减少计时抖动
+        double fastest = 0.0;
+        for (int run = 0; run < 3; ++run) {
+            PerfectHash index;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            ASSERT_TRUE(index.build(hashes));
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            fastest = run == 0 ? seconds : std::min(fastest, seconds);
+        }
+        if (previous > 0.0) {
+            EXPECT_LT(fastest, previous * 3.0) << n << " keys";
+        }
+        previous = fastest;
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <random>
+#include "../include/Reachability.h"
+#include "TestGraphs.h"
+
+// 朴素 BFS 作为对照
+static std::vector<bool> reachableFrom(const CsrGraph& csr, CsrGraph::VertexId source) {
+    std::vector<bool> seen(csr.vertexCount(), false);
+    std::vector<CsrGraph::VertexId> queue(1, source);
+    seen[source] = true;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        for (const CsrGraph::VertexId* t = csr.targetsBegin(queue[head]); t != csr.targetsEnd(queue[head]); ++t) {
+            if (!seen[*t]) {
+                seen[*t] = true;
+                queue.push_back(*t);
+            }
+        }
+    }
+    return seen;
+}
+
+// 随机图：大部分边指向编号更大的顶点（近似 DAG），少量回边形成强连通分量
+static Graph nearDagGraph(int vertices, int edges, int backEdges, unsigned seed) {
+    Graph graph;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pick(0, vertices - 1);
+    for (int v = 0; v < vertices; ++v) {
+        graph.addEdge(wordFor(v), wordFor(v));
+    }
+    for (int e = 0; e < edges; ++e) {
+        int a = pick(rng), b = pick(rng);
+        graph.addEdge(wordFor(std::min(a, b)), wordFor(std::max(a, b)));
+    }
+    for (int e = 0; e < backEdges; ++e) {
+        int a = pick(rng);
+        int b = std::max(0, a - 1 - pick(rng) % 5);
+        graph.addEdge(wordFor(b), wordFor(a));
+        graph.addEdge(wordFor(a), wordFor(b));
+    }
+    return graph;
+}
+
+static void expectMatchesBfs(const Graph& graph, int sources, unsigned seed) {
+    CsrGraph csr(graph);
+    ReachabilityIndex index(csr);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<size_t> pick(0, csr.vertexCount() - 1);
+    for (int s = 0; s < sources; ++s) {
+        CsrGraph::VertexId source = static_cast<CsrGraph::VertexId>(pick(rng));
+        std::vector<bool> expected = reachableFrom(csr, source);
+        for (CsrGraph::VertexId v = 0; v < csr.vertexCount(); ++v) {
+            ASSERT_EQ(index.canReach(source, v), expected[v]) << csr.name(source) << " -> " << csr.name(v);
+        }
+    }
+}
+
+// 测试用例 1：小图使用传递闭包位图
+TEST(ReachabilityTest, ClosureMatchesBfs) {
+    Graph graph = nearDagGraph(500, 600, 40, 1);
+    CsrGraph csr(graph);
+    ReachabilityIndex index(csr);
+    EXPECT_TRUE(index.usesClosure());
+    EXPECT_LT(index.componentCount(), 500u);
+    expectMatchesBfs(graph, 100, 2);
+}
+
+// 测试用例 2：大图使用区间标签 + 剪枝 DFS
+TEST(ReachabilityTest, IntervalsMatchBfs) {
+    Graph graph = nearDagGraph(12000, 9000, 200, 3);
+    CsrGraph csr(graph);
+    ReachabilityIndex index(csr);
+    ASSERT_GT(index.componentCount(), ReachabilityIndex::kClosureLimit);
+    EXPECT_FALSE(index.usesClosure());
+    expectMatchesBfs(graph, 40, 4);
+}
+
+// 测试用例 3：Graph 接口对不可达的词对立即返回 -1
+TEST(ReachabilityTest, GraphAnswersNoPath) {
+    std::ofstream testFile("reachability_test.txt");
+    testFile << "to explore the strange new worlds to seek the new life and new civilizations";
+    testFile.close();
+    Graph graph;
+    ASSERT_TRUE(graph.buildFromFile("reachability_test.txt"));
+    std::remove("reachability_test.txt");
+
+    EXPECT_TRUE(graph.isReachable("to", "civilizations"));
+    EXPECT_FALSE(graph.isReachable("civilizations", "to"));
+    EXPECT_EQ(graph.shortestPath("civilizations", "to").first, -1);
+    EXPECT_EQ(graph.stats().queries.lastVerticesSettled, 0u);
+
+    std::pair<double, std::vector<std::string>> path = graph.shortestPath("to", "civilizations");
+    EXPECT_GT(path.first, 0);
+    EXPECT_EQ(path.second.back(), "civilizations");
+
+    // 加边后索引失效并重建
+    graph.addEdge("civilizations", "to");
+    EXPECT_TRUE(graph.isReachable("civilizations", "to"));
+    EXPECT_EQ(graph.shortestPath("civilizations", "to").first, 1);
+}
+
+// 测试用例 4：区间标签下 shortestPath 只做 O(1) 预检查，结果仍与可达性一致
+TEST(ReachabilityTest, GraphPathsOnLargeDag) {
+    Graph graph = nearDagGraph(12000, 9000, 200, 5);
+    ASSERT_FALSE(graph.reachabilityIndex()->usesClosure());
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    std::mt19937 rng(6);
+    std::uniform_int_distribution<int> pick(0, 11999);
+    int reachable = 0;
+    for (int i = 0; i < 200; ++i) {
+        int a = pick(rng), b = pick(rng);
+        std::string from = wordFor(std::min(a, b)), to = wordFor(std::max(a, b));
+        if (i % 2 == 0) {
+            // 一半的词对取两步之外的后继，保证存在可达的情形
+            CsrGraph::VertexId v = 0;
+            ASSERT_TRUE(csr->findVertex(from, v));
+            for (int step = 0; step < 2; ++step) {
+                v = *(csr->targetsEnd(v) - 1);
+            }
+            to = csr->name(v);
+        }
+        std::pair<double, std::vector<std::string>> path = graph.shortestPath(from, to);
+        ASSERT_EQ(path.first >= 0, graph.isReachable(from, to)) << from << " -> " << to;
+        if (path.first >= 0) {
+            EXPECT_EQ(path.second.front(), from);
+            EXPECT_EQ(path.second.back(), to);
+            reachable++;
+        }
+        else {
+            EXPECT_TRUE(path.second.empty());
+        }
+    }
+    EXPECT_GT(reachable, 0);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/CsrGraph.h"
+#include "TestGraphs.h"
+
+static const VertexOrder kOrders[] = { VertexOrder::Lexicographic, VertexOrder::ReverseCuthillMcKee,
+                                       VertexOrder::Degree, VertexOrder::BreadthFirst };
+
+// 测试用例 1：每种顺序都是排列，重编号后的边与单词一一对应
+TEST(VertexOrderTest, PermutationKeepsEdgesByWord) {
+    Graph graph = randomGraph(600, 3000, 7, 1);
+    CsrGraph csr(graph);
+    for (VertexOrder order : kOrders) {
+        std::vector<CsrGraph::VertexId> permutation = csr.vertexOrder(order);
+        ASSERT_EQ(permutation.size(), csr.vertexCount());
+        std::vector<bool> seen(csr.vertexCount(), false);
+        for (CsrGraph::VertexId v : permutation) {
+            ASSERT_FALSE(seen[v]) << vertexOrderName(order);
+            seen[v] = true;
+        }
+
+        CsrGraph relabelled = csr.permuted(permutation);
+        ASSERT_EQ(relabelled.edgeCount(), csr.edgeCount());
+        for (CsrGraph::VertexId v = 0; v < csr.vertexCount(); ++v) {
+            CsrGraph::VertexId id = CsrGraph::kNoVertex;
+            ASSERT_TRUE(relabelled.findVertex(csr.name(v), id));
+            EXPECT_EQ(relabelled.name(id), csr.name(v));
+            ASSERT_EQ(relabelled.outDegree(id), csr.outDegree(v));
+            std::map<std::string, uint32_t> before, after;
+            for (uint32_t e = 0; e < csr.outDegree(v); ++e) {
+                before[csr.name(csr.targetsBegin(v)[e])] = csr.weightsBegin(v)[e];
+                after[relabelled.name(relabelled.targetsBegin(id)[e])] = relabelled.weightsBegin(id)[e];
+            }
+            EXPECT_EQ(before, after);
+        }
+        CsrGraph::VertexId missing = 0;
+        EXPECT_FALSE(relabelled.findVertex("zzzzz", missing));
+    }
+}
+
+// 测试用例 2：RCM 把打乱的链还原为带宽 1，度数顺序把枢纽放在最前
+TEST(VertexOrderTest, OrdersImproveLocality) {
+    Graph chain;
+    for (int v = 0; v + 1 < 2000; ++v) {
+        chain.addEdge(wordFor(v), wordFor(v + 1));
+    }
+    CsrGraph csr(chain);
+    EXPECT_GT(csr.bandwidth(), 100u);
+    EXPECT_EQ(csr.permuted(csr.vertexOrder(VertexOrder::ReverseCuthillMcKee)).bandwidth(), 1u);
+    // BFS 从链中间的某个顶点出发，向两侧交替展开
+    EXPECT_LE(csr.permuted(csr.vertexOrder(VertexOrder::BreadthFirst)).bandwidth(), 2u);
+
+    Graph star = randomGraph(300, 600, 3, 2);
+    for (int v = 0; v < 300; ++v) {
+        star.addEdge("hub", wordFor(v));
+    }
+    CsrGraph starCsr(star);
+    CsrGraph byDegree = starCsr.permuted(starCsr.vertexOrder(VertexOrder::Degree));
+    EXPECT_EQ(byDegree.name(0), "hub");
+}
+
+// 测试用例 3：重编号后 Graph 的 PageRank 与最短路径距离不变，结果仍以单词为键
+TEST(VertexOrderTest, GraphResultsUnchanged) {
+    Graph graph = randomGraph(800, 4000, 9, 3);
+    std::map<std::string, double> expectedRanks = graph.calculatePageRank(0.85, std::map<std::string, double>(), 30);
+    std::map<std::string, std::pair<double, std::vector<std::string>>> expectedPaths = graph.shortestPathsFromSource(wordFor(0));
+
+    for (VertexOrder order : kOrders) {
+        graph.setVertexOrder(order);
+        EXPECT_EQ(graph.getVertexOrder(), order);
+        std::map<std::string, double> ranks = graph.calculatePageRank(0.85, std::map<std::string, double>(), 30);
+        ASSERT_EQ(ranks.size(), expectedRanks.size());
+        for (const auto& entry : expectedRanks) {
+            EXPECT_NEAR(ranks[entry.first], entry.second, 1e-12) << vertexOrderName(order);
+        }
+
+        std::map<std::string, std::pair<double, std::vector<std::string>>> paths = graph.shortestPathsFromSource(wordFor(0));
+        ASSERT_EQ(paths.size(), expectedPaths.size());
+        for (const auto& entry : expectedPaths) {
+            EXPECT_EQ(paths[entry.first].first, entry.second.first);
+            EXPECT_EQ(paths[entry.first].second.front(), wordFor(0));
+            EXPECT_EQ(paths[entry.first].second.back(), entry.first);
+        }
+        EXPECT_TRUE(graph.isReachable(wordFor(0), expectedPaths.begin()->first));
+    }
+}
+
+// 测试用例 4：顺序名称解析
+TEST(VertexOrderTest, ParsesNames) {
+    VertexOrder order = VertexOrder::Lexicographic;
+    EXPECT_TRUE(parseVertexOrder("rcm", order));
+    EXPECT_EQ(order, VertexOrder::ReverseCuthillMcKee);
+    EXPECT_TRUE(parseVertexOrder("bfs", order));
+    EXPECT_EQ(order, VertexOrder::BreadthFirst);
+    EXPECT_FALSE(parseVertexOrder("random", order));
+    EXPECT_EQ(order, VertexOrder::BreadthFirst);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/ResultStream.h"
+#include "../include/PathCache.h"
+#include "../include/EdgeCost.h"
+#include "TestGraphs.h"
+
+// 测试用例 1：流式结果与完整最短路径树一致，且按距离非递减的顺序产出
+TEST(ResultStreamTest, MatchesShortestPathTree) {
+    Graph graph = randomGraph(3000, 12000, 5, 1);
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    CsrGraph::VertexId source = 0;
+    ASSERT_TRUE(csr->findVertex("abc", source));
+    NegativeLogProbabilityCost logProbability(*csr);
+    for (PathCost cost : { PathCost::Count, PathCost::InverseFrequency, PathCost::NegativeLogProbability, PathCost::Hops }) {
+        SCOPED_TRACE(pathCostName(cost));
+        ShortestPathTree tree = cost == PathCost::Hops ? buildHopTree(*csr, source)
+            : cost == PathCost::InverseFrequency ? buildShortestPathTree(*csr, source, InverseFrequencyCost())
+            : cost == PathCost::NegativeLogProbability ? buildShortestPathTree(*csr, source, logProbability)
+            : buildShortestPathTree(*csr, source);
+
+        ShortestPathStream stream = graph.streamShortestPaths("abc", cost);
+        size_t yielded = 0;
+        double previous = 0;
+        while (stream.next()) {
+            ASSERT_NE(stream.target(), source);
+            ASSERT_EQ(stream.distance(), tree.distance[stream.target()]) << stream.word();
+            ASSERT_GE(stream.distance(), previous);
+            previous = stream.distance();
+            std::vector<std::string> words;
+            for (CsrGraph::VertexId id : stream.pathIds()) {
+                words.push_back(csr->name(id));
+            }
+            ASSERT_EQ(words, tree.pathTo(*csr, stream.target())) << stream.word();
+            yielded++;
+        }
+        EXPECT_EQ(yielded, tree.settled - 1);
+    }
+}
+
+// 测试用例 2：与 shortestPathsFromSource 结果相同，可提前停止，不存在的单词得到空流
+TEST(ResultStreamTest, GraphStreams) {
+    Graph graph = randomGraph(500, 2000, 3, 2);
+    std::map<std::string, std::pair<double, std::vector<std::string>>> expected = graph.shortestPathsFromSource("b");
+    std::map<std::string, std::pair<double, std::vector<std::string>>> streamed;
+    ShortestPathStream stream = graph.streamShortestPaths("B");
+    while (stream.next()) {
+        std::vector<std::string> words;
+        for (CsrGraph::VertexId id : stream.pathIds()) {
+            words.push_back(stream.view().name(id));
+        }
+        streamed[stream.word()] = std::make_pair(stream.distance(), words);
+    }
+    EXPECT_EQ(streamed, expected);
+
+    // 只取最近的 3 个目标：图之后的修改不影响已经开始的流
+    ShortestPathStream nearest = graph.streamShortestPaths("b");
+    ASSERT_TRUE(nearest.next());
+    graph.addEdge("b", "zzzz", 1);
+    ASSERT_TRUE(nearest.next());
+    ASSERT_TRUE(nearest.next());
+    EXPECT_LE(nearest.settledCount(), 4u);
+
+    ShortestPathStream missing = graph.streamShortestPaths("missing");
+    EXPECT_FALSE(missing.next());
+}
+
+// 测试用例 3：随机游走的每一步都沿着真实的边，且没有重复的边
+TEST(ResultStreamTest, RandomWalkSteps) {
+    Graph graph = randomGraph(200, 600, 2, 3);
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    for (uint32_t seed = 0; seed < 50; ++seed) {
+        RandomWalkStream walk(csr, seed);
+        ASSERT_TRUE(walk.next());
+        CsrGraph::VertexId previous = walk.vertex();
+        std::set<std::pair<std::string, std::string>> edges;
+        while (walk.next()) {
+            ASSERT_TRUE(std::find(csr->targetsBegin(previous), csr->targetsEnd(previous), walk.vertex()) !=
+                csr->targetsEnd(previous));
+            ASSERT_TRUE(edges.insert(std::make_pair(csr->name(previous), walk.word())).second);
+            previous = walk.vertex();
+        }
+        EXPECT_EQ(walk.length(), edges.size() + 1);
+        EXPECT_FALSE(walk.next());
+    }
+
+    Graph empty;
+    EXPECT_FALSE(empty.streamRandomWalk().next());
+    EXPECT_TRUE(empty.randomWalk().empty());
+}
+
+// 测试用例 4：流式随机游走结束时计入 stats() 的随机游走计数
+TEST(ResultStreamTest, RandomWalkCounters) {
+    Graph graph = randomGraph(200, 600, 2, 4);
+    RandomWalkStream walk = graph.streamRandomWalk();
+    while (walk.next()) {
+    }
+    std::vector<std::string> path = graph.randomWalk();
+    RandomWalkStream abandoned = graph.streamRandomWalk();
+    EXPECT_TRUE(abandoned.next());
+
+    QueryStats queries = graph.stats().queries;
+    if (TG_STATS_ENABLED) {
+        EXPECT_EQ(queries.randomWalkCalls, 2u);
+        EXPECT_EQ(queries.lastRandomWalkSteps, path.size() - 1);
+        EXPECT_EQ(queries.totalRandomWalkSteps, walk.length() - 1 + path.size() - 1);
+    }
+    else {
+        EXPECT_EQ(queries.randomWalkCalls, 0u);
+    }
+}
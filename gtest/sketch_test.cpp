@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <random>
+#include "../include/SketchBuilder.h"
+#include "TestGraphs.h"
+
+// Zipf 分布的词流：少数二元组频繁出现，大量二元组只出现一两次
+static std::vector<std::string> zipfStream(size_t tokens, int vocabulary, unsigned seed) {
+    std::vector<double> weights(vocabulary);
+    for (int i = 0; i < vocabulary; ++i) {
+        weights[i] = 1.0 / (i + 1);
+    }
+    std::discrete_distribution<int> pick(weights.begin(), weights.end());
+    std::mt19937 rng(seed);
+    std::vector<std::string> stream(tokens);
+    for (std::string& word : stream) {
+        word = wordFor(pick(rng));
+    }
+    return stream;
+}
+
+static void feed(SketchGraphBuilder& builder, const std::vector<std::string>& stream) {
+    for (const std::string& word : stream) {
+        builder.addWord(word.data(), word.size());
+    }
+}
+
+// 测试用例 1：估计值从不低于真实次数，误差在报告的界内
+TEST(SketchBuilderTest, EstimatesWithinBound) {
+    std::vector<std::string> stream = zipfStream(200000, 5000, 1);
+    std::map<std::pair<std::string, std::string>, uint64_t> exact;
+    for (size_t i = 1; i < stream.size(); ++i) {
+        exact[std::make_pair(stream[i - 1], stream[i])]++;
+    }
+
+    SketchBuildOptions options;
+    options.sketchWidth = 1 << 14;
+    options.heavyHitters = 2000;
+    options.minWeight = 1;
+    SketchGraphBuilder builder(options);
+    feed(builder, stream);
+    Graph graph;
+    builder.finishInto(graph);
+    const SketchBuildReport& report = builder.report();
+    EXPECT_EQ(report.tokens, stream.size());
+    EXPECT_EQ(report.pairs, stream.size() - 1);
+    EXPECT_EQ(report.tracked, 2000u);
+    EXPECT_GT(report.confidence, 0.98);
+
+    size_t outside = 0;
+    for (const auto& entry : exact) {
+        uint64_t estimate = builder.estimate(entry.first.first, entry.first.second);
+        ASSERT_GE(estimate, entry.second);
+        outside += static_cast<double>(estimate - entry.second) > report.errorBound;
+    }
+    EXPECT_LT(outside, exact.size() / 50);
+
+    // 未被跟踪的二元组都不超过 trackedFloor 次，超过的一定已进入图中
+    for (const auto& entry : exact) {
+        if (entry.second > report.trackedFloor) {
+            EXPECT_TRUE(graph.getAdjacencyList().count(entry.first.first));
+        }
+    }
+}
+
+// 测试用例 2：按阈值或 top-K 只物化高频边，内存由参数决定而与语料无关
+TEST(SketchBuilderTest, MaterializesFrequentEdges) {
+    std::vector<std::string> stream = zipfStream(100000, 3000, 2);
+    std::map<std::pair<std::string, std::string>, uint64_t> exact;
+    for (size_t i = 1; i < stream.size(); ++i) {
+        exact[std::make_pair(stream[i - 1], stream[i])]++;
+    }
+
+    SketchBuildOptions options;
+    options.sketchWidth = 1 << 15;
+    options.heavyHitters = 4000;
+    options.minWeight = 20;
+    SketchGraphBuilder thresholded(options);
+    feed(thresholded, stream);
+    Graph graph;
+    thresholded.finishInto(graph);
+    ASSERT_LT(thresholded.report().trackedFloor, options.minWeight);
+    size_t frequent = 0;
+    for (const auto& entry : exact) {
+        if (entry.second >= options.minWeight) {
+            frequent++;
+            const std::vector<Graph::Edge>& edges = graph.getAdjacencyList().at(entry.first.first);
+            auto edge = std::find_if(edges.begin(), edges.end(), [&entry](const Graph::Edge& e) { return e.dest == entry.first.second; });
+            ASSERT_NE(edge, edges.end());
+            EXPECT_GE(static_cast<uint64_t>(edge->weight), entry.second);
+        }
+    }
+    EXPECT_GE(graph.edgeCount(), frequent);
+    EXPECT_LT(graph.edgeCount(), exact.size() / 4);
+
+    options.topK = 10;
+    SketchGraphBuilder top(options);
+    feed(top, stream);
+    feed(top, stream);
+    Graph topGraph;
+    top.finishInto(topGraph);
+    EXPECT_EQ(topGraph.edgeCount(), 10u);
+    EXPECT_EQ(top.report().edges, 10u);
+    EXPECT_LT(top.report().memoryBytes, thresholded.report().memoryBytes + 4096);
+}
+
+// 测试用例 3：按文件读取时二元组不跨文件
+TEST(SketchBuilderTest, FilesAreSeparateDocuments) {
+    const std::string first = "sketch_test_a.txt", second = "sketch_test_b.txt";
+    std::ofstream(first) << "alpha beta alpha beta";
+    std::ofstream(second) << "gamma alpha beta";
+    SketchBuildOptions options;
+    options.minWeight = 1;
+    SketchGraphBuilder builder(options);
+    ASSERT_TRUE(builder.addFile(first));
+    ASSERT_TRUE(builder.addFile(second));
+    EXPECT_FALSE(builder.addFile("sketch_test_missing.txt"));
+    std::remove(first.c_str());
+    std::remove(second.c_str());
+
+    EXPECT_EQ(builder.estimate("alpha", "beta"), 3u);
+    EXPECT_EQ(builder.estimate("beta", "gamma"), 0u);
+    Graph graph;
+    builder.finishInto(graph);
+    EXPECT_EQ(graph.edgeCount(), 3u);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/SparseMatrix.h"
+#include "TestGraphs.h"
+
+// 测试用例 1：正向与转置乘法与稠密矩阵结果一致，且与线程数无关（逐位相同）
+TEST(SparseMatrixTest, ProductsMatchDense) {
+    Graph graph = randomGraph(3000, 15000, 7, 1);
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    SparseMatrix matrix(*csr);
+    const size_t n = csr->vertexCount();
+    std::vector<double> x(n);
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<double> value(0.0, 1.0);
+    for (double& element : x) {
+        element = value(rng);
+    }
+
+    std::vector<double> expectedForward(n, 0.0), expectedTranspose(n, 0.0);
+    for (uint32_t u = 0; u < n; ++u) {
+        for (uint32_t e = csr->rowOffsets()[u]; e < csr->rowOffsets()[u + 1]; ++e) {
+            expectedForward[u] += csr->edgeWeight(e) * x[csr->edgeTarget(e)];
+            expectedTranspose[csr->edgeTarget(e)] += csr->edgeWeight(e) * x[u];
+        }
+    }
+    std::vector<double> forward, transpose, parallelForward, parallelTranspose;
+    matrix.multiply(x, forward);
+    matrix.multiplyTranspose(x, transpose);
+    matrix.multiply(x, parallelForward, 4);
+    matrix.multiplyTranspose(x, parallelTranspose, 4);
+    for (size_t v = 0; v < n; ++v) {
+        ASSERT_NEAR(forward[v], expectedForward[v], 1e-9) << v;
+        ASSERT_NEAR(transpose[v], expectedTranspose[v], 1e-9) << v;
+    }
+    EXPECT_EQ(forward, parallelForward);
+    EXPECT_EQ(transpose, parallelTranspose);
+}
+
+// 测试用例 2：引擎上的 PageRank 与 BasicGraph 的直接实现一致，多线程结果完全相同
+TEST(SparseMatrixTest, PageRankMatchesReference) {
+    Graph graph = randomGraph(2000, 9000, 5, 3);
+    graph.addEdge("dangling", "sink");
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    std::vector<double> expected = csr->pageRank(0.85, 40);
+
+    SparseMatrix matrix(*csr);
+    IterationOptions options;
+    options.maxIterations = 40;
+    std::vector<double> start(csr->vertexCount(), 1.0 / static_cast<double>(csr->vertexCount()));
+    IterationResult serial = pageRankScores(matrix, 0.85, start, options);
+    options.threads = 4;
+    IterationResult parallel = pageRankScores(matrix, 0.85, start, options);
+    ASSERT_EQ(serial.values.size(), expected.size());
+    EXPECT_EQ(serial.iterations, 40);
+    EXPECT_FALSE(serial.converged);
+    for (size_t v = 0; v < expected.size(); ++v) {
+        EXPECT_NEAR(serial.values[v], expected[v], 1e-12) << v;
+    }
+    EXPECT_EQ(serial.values, parallel.values);
+
+    graph.setRankThreads(4);
+    std::map<std::string, double> ranks = graph.calculatePageRank(0.85, std::map<std::string, double>(), 40);
+    for (CsrGraph::VertexId v = 0; v < csr->vertexCount(); ++v) {
+        EXPECT_EQ(ranks[csr->name(v)], serial.values[v]);
+    }
+}
+
+// 测试用例 3：星形图上 HITS 的枢纽与权威值，以及随机图上的特征向量性质
+TEST(SparseMatrixTest, HitsScores) {
+    Graph star;
+    star.addEdge("hub", "one", 1);
+    star.addEdge("hub", "two", 1);
+    star.addEdge("hub", "three", 1);
+    std::pair<std::map<std::string, double>, std::map<std::string, double>> scores = star.calculateHits();
+    EXPECT_NEAR(scores.first["hub"], 1.0, 1e-12);
+    EXPECT_NEAR(scores.first["one"], 0.0, 1e-12);
+    EXPECT_NEAR(scores.second["hub"], 0.0, 1e-12);
+    EXPECT_NEAR(scores.second["two"], 1.0 / 3.0, 1e-12);
+
+    Graph graph = randomGraph(500, 3000, 4, 4);
+    SparseMatrix matrix(*graph.csrView());
+    IterationOptions options;
+    options.maxIterations = 1000;
+    options.tolerance = 1e-13;
+    HitsResult hits = hitsScores(matrix, options);
+    ASSERT_TRUE(hits.authorities.converged);
+    std::vector<double> hubs, next;
+    matrix.multiply(hits.authorities.values, hubs);
+    matrix.multiplyTranspose(hubs, next);
+    scaleToSum(next, 1.0);
+    EXPECT_LT(l1Distance(next, hits.authorities.values), 1e-10);
+    double hubSum = 0.0;
+    for (double hub : hits.hubs) {
+        hubSum += hub;
+    }
+    EXPECT_NEAR(hubSum, 1.0, 1e-12);
+}
+
+// 测试用例 4：链上的 Katz 中心性等于闭式解；自动 alpha 收敛
+TEST(SparseMatrixTest, KatzScores) {
+    Graph chain;
+    chain.addEdge("alpha", "beta", 1);
+    chain.addEdge("beta", "gamma", 1);
+    std::map<std::string, double> katz = chain.calculateKatz(0.5);
+    EXPECT_NEAR(katz["alpha"], 1.0, 1e-12);
+    EXPECT_NEAR(katz["beta"], 1.5, 1e-12);
+    EXPECT_NEAR(katz["gamma"], 1.75, 1e-12);
+
+    Graph graph = randomGraph(1000, 6000, 9, 5);
+    IterationOptions options;
+    options.maxIterations = 500;
+    options.tolerance = 1e-12;
+    IterationResult result = katzScores(SparseMatrix(*graph.csrView()), 0.0, 1.0, options);
+    EXPECT_TRUE(result.converged);
+    for (double score : result.values) {
+        EXPECT_GE(score, 1.0);
+    }
+}
+
+// 测试用例 5：取消后所有排名都返回空结果
+TEST(SparseMatrixTest, CancelledRunsAreEmpty) {
+    Graph graph = randomGraph(200, 800, 3, 6);
+    JobControl control;
+    control.requestCancel();
+    EXPECT_TRUE(graph.calculatePageRank(0.85, std::map<std::string, double>(), 10, &control).empty());
+    EXPECT_TRUE(graph.calculateHits(10, &control).first.empty());
+    EXPECT_TRUE(graph.calculateKatz(0.0, 10, &control).empty());
+}
+
+class VectorBackendTest : public ::testing::TestWithParam<VectorBackend> {
+protected:
+    void SetUp() override {
+        if (!vectorBackendSupported(GetParam())) {
+            GTEST_SKIP() << vectorBackendName(GetParam()) << " not supported on this CPU";
+        }
+    }
+};
+
+// 测试用例 6：各 SIMD 后端的乘法、L1 距离与归一化与标量实现相差不超过舍入误差，且与线程数无关
+TEST_P(VectorBackendTest, KernelsMatchScalar) {
+    Graph graph = randomGraph(3000, 15000, 7, 4);
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    SparseMatrix matrix(*csr);
+    const size_t n = csr->vertexCount();
+    std::vector<double> x(n), z(n - 1); // z 取奇数长度，覆盖向量循环之后的尾部
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> value(0.0, 1.0);
+    for (double& element : x) {
+        element = value(rng);
+    }
+    for (double& element : z) {
+        element = value(rng);
+    }
+
+    std::vector<double> scalar, simd, parallel;
+    matrix.multiplyTranspose(x, scalar, 1, VectorBackend::Scalar);
+    matrix.multiplyTranspose(x, simd, 1, GetParam());
+    matrix.multiplyTranspose(x, parallel, 4, GetParam());
+    for (size_t v = 0; v < n; ++v) {
+        ASSERT_NEAR(simd[v], scalar[v], 1e-12) << v;
+    }
+    EXPECT_EQ(simd, parallel);
+    matrix.multiply(x, scalar, 1, VectorBackend::Scalar);
+    matrix.multiply(x, simd, 1, GetParam());
+    for (size_t v = 0; v < n; ++v) {
+        ASSERT_NEAR(simd[v], scalar[v], 1e-12) << v;
+    }
+
+    std::vector<double> y(x.begin(), x.end() - 1);
+    EXPECT_NEAR(l1Distance(y, z, GetParam()), l1Distance(y, z, VectorBackend::Scalar), 1e-9);
+    EXPECT_EQ(l1Distance(y, y, GetParam()), 0.0);
+
+    std::vector<double> scaled = z;
+    scaleToSum(scaled, 2.0, GetParam());
+    double total = 0.0;
+    for (double element : scaled) {
+        total += element;
+    }
+    EXPECT_NEAR(total, 2.0, 1e-12);
+    std::vector<double> zeros(7, 0.0);
+    scaleToSum(zeros, 1.0, GetParam());
+    EXPECT_EQ(zeros, std::vector<double>(7, 0.0));
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, VectorBackendTest,
+    ::testing::Values(VectorBackend::Scalar, VectorBackend::SSE2, VectorBackend::AVX2));
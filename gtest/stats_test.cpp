@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include "../include/Graph.h"
+
+// 测试夹具：用固定文本构建图，检查 stats() 的规模、构建耗时与查询计数
+class GraphStatsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // 创建临时测试文件
+        std::ofstream testFile("stats_test.txt");
+        testFile << "to explore the strange new worlds to seek the new life and new civilizations";
+        testFile.close();
+
+        // 构建有向图
+        ASSERT_TRUE(graph.buildFromFile("stats_test.txt"));
+    }
+
+    void TearDown() override {
+        // 删除临时测试文件
+        std::remove("stats_test.txt");
+    }
+
+    Graph graph; // Graph 对象
+};
+
+// 测试用例 1：词数、顶点数、边数与内存估计
+TEST_F(GraphStatsTest, SizesAfterBuild) {
+    GraphStats stats = graph.stats();
+    EXPECT_EQ(stats.build.tokens, 14u);
+    EXPECT_EQ(stats.build.documents, 1u);
+    EXPECT_EQ(stats.vertices, 10u); // to explore the strange new worlds seek life and civilizations
+    EXPECT_EQ(stats.edges, 13u);    // 14 个词的 13 个二元组互不相同
+    EXPECT_EQ(stats.vertices, graph.vertexCount());
+    EXPECT_EQ(stats.edges, graph.edgeCount());
+    EXPECT_GT(stats.memory.mapNodes, 0u);
+    EXPECT_GT(stats.memory.edgeArrays, 0u);
+    EXPECT_EQ(stats.memory.adjacency(), stats.memory.mapNodes + stats.memory.vertexStrings + stats.memory.edgeArrays +
+        stats.memory.edgeStrings);
+    EXPECT_EQ(stats.memory.derived(), 0u); // 还没有查询，派生视图都未构建
+    EXPECT_EQ(stats.memory.total(), stats.memory.adjacency());
+}
+
+// 测试用例 2：构建耗时非负，再次构建时词数与文档数累加
+TEST_F(GraphStatsTest, BuildTimingsAccumulate) {
+    GraphStats first = graph.stats();
+    EXPECT_GE(first.build.readMs, 0.0);
+    EXPECT_GE(first.build.tokenizeMs, 0.0);
+    EXPECT_GE(first.build.insertMs, 0.0);
+
+    Graph other;
+    ASSERT_TRUE(other.buildFromFile("stats_test.txt"));
+    graph.merge(other);
+    GraphStats merged = graph.stats();
+    EXPECT_EQ(merged.build.tokens, 28u);
+    EXPECT_EQ(merged.build.documents, 2u);
+    EXPECT_EQ(merged.vertices, first.vertices);
+    EXPECT_EQ(merged.edges, first.edges);
+}
+
+// 测试用例 3：最短路径、PageRank 与随机游走的计数器
+TEST_F(GraphStatsTest, QueryCounters) {
+    QueryStats before = graph.stats().queries;
+    EXPECT_EQ(before.shortestPathCalls, 0u);
+    EXPECT_EQ(before.pageRankCalls, 0u);
+    EXPECT_EQ(before.randomWalkCalls, 0u);
+
+    graph.shortestPath("to", "civilizations"); // 第一次只做剪枝搜索
+    graph.shortestPath("to", "civilizations"); // 第二次建立并缓存完整树
+    graph.shortestPath("to", "civilizations"); // 第三次命中缓存，不再松弛
+    graph.calculatePageRank(0.85, std::map<std::string, double>(), 20);
+    std::vector<std::string> walk = graph.randomWalk();
+
+    QueryStats after = graph.stats().queries;
+    if (!TG_STATS_ENABLED) {
+        EXPECT_EQ(after.shortestPathCalls, 0u);
+        return;
+    }
+    EXPECT_EQ(after.shortestPathCalls, 3u);
+    EXPECT_EQ(after.lastVerticesSettled, 0u);
+    EXPECT_GT(after.totalVerticesSettled, 0u);
+    EXPECT_GT(after.totalEdgesRelaxed, 0u);
+    EXPECT_EQ(after.pageRankCalls, 1u);
+    EXPECT_GT(after.lastPageRankIterations, 0u);
+    EXPECT_LE(after.lastPageRankIterations, 20u);
+    EXPECT_GE(after.lastPageRankResidual, 0.0);
+    EXPECT_EQ(after.randomWalkCalls, 1u);
+    EXPECT_EQ(after.lastRandomWalkSteps, walk.size() - 1);
+    EXPECT_EQ(after.totalRandomWalkSteps, walk.size() - 1);
+}
+
+// 测试用例 4：查询构建的派生视图计入内存估计，图修改后过期的视图不再计入
+TEST_F(GraphStatsTest, DerivedViewsCounted) {
+    graph.findBridgeWords("to", "the");
+    graph.shortestPath("to", "life", PathCost::NegativeLogProbability);
+    graph.calculatePageRank(0.85, std::map<std::string, double>(), 20);
+
+    GraphStats stats = graph.stats();
+    EXPECT_GT(stats.memory.csrView, 0u);
+    EXPECT_GT(stats.memory.inEdgeView, 0u);
+    EXPECT_GT(stats.memory.reachability, 0u);
+    EXPECT_GT(stats.memory.rankMatrix, 0u);
+    EXPECT_GT(stats.memory.logProbabilityCosts, 0u);
+    EXPECT_EQ(stats.memory.pathTrees, stats.pathCache.bytes);
+    EXPECT_EQ(stats.memory.total(), stats.memory.adjacency() + stats.memory.derived());
+
+    graph.addEdge("life", "to", 1);
+    MemoryStats changed = graph.stats().memory;
+    EXPECT_EQ(changed.csrView, 0u);
+    EXPECT_EQ(changed.inEdgeView, 0u);
+    EXPECT_EQ(changed.reachability, 0u);
+    EXPECT_EQ(changed.rankMatrix, 0u);
+    EXPECT_EQ(changed.logProbabilityCosts, 0u);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/Tools.h"
+
+// 旧版分词流程：ispunct 替换为空格 + stringstream 切分 + isalpha/tolower 规范化
+static std::vector<std::string> legacyTokenize(std::string content) {
+    for (char& c : content) {
+        if (std::ispunct(c) || c == '\n' || c == '\r') {
+            c = ' ';
+        }
+    }
+    std::vector<std::string> words;
+    std::stringstream ss(content);
+    std::string word;
+    while (ss >> word) {
+        std::string normalized;
+        for (char c : word) {
+            if (std::isalpha(c)) {
+                normalized += static_cast<char>(std::tolower(c));
+            }
+        }
+        if (!normalized.empty()) {
+            words.push_back(normalized);
+        }
+    }
+    return words;
+}
+
+static std::vector<std::string> simdTokenize(std::string content, TokenizerBackend backend) {
+    size_t wordCount = 0;
+    content.resize(normalizeTextInPlace(&content[0], content.size(), &wordCount, backend));
+    std::vector<std::string> words;
+    WordCursor cursor(content.data(), content.size());
+    const char* word = nullptr;
+    size_t length = 0;
+    while (cursor.next(word, length)) {
+        words.emplace_back(word, length);
+    }
+    EXPECT_EQ(words.size(), wordCount);
+    return words;
+}
+
+class TokenizerTest : public ::testing::TestWithParam<TokenizerBackend> {
+protected:
+    void SetUp() override {
+        if (!tokenizerBackendSupported(GetParam())) {
+            GTEST_SKIP() << tokenizerBackendName(GetParam()) << " not supported on this CPU";
+        }
+    }
+};
+
+// 测试用例 1：常见文本与边界情况
+TEST_P(TokenizerTest, MatchesLegacyOnSamples) {
+    const std::vector<std::string> samples = {
+        "",
+        "   ",
+        "to explore the strange new worlds to seek the new life and new civilizations",
+        "The scientist carefully analyzed the data, wrote a detailed report.",
+        "Hello,World!!It's\tA\r\nTEST-case 123 a1b2c 42",
+        "caf\xC3\xA9 na\xC3\xAFve \x01\x7F control",
+        "AVeryLongWordThatSpansMoreThanThirtyTwoBytesWithoutAnySeparatorsAtAll, end",
+    };
+    for (const std::string& sample : samples) {
+        EXPECT_EQ(simdTokenize(sample, GetParam()), legacyTokenize(sample)) << "input: " << sample;
+    }
+}
+
+// 测试用例 2：随机字节（含高位字节与各类标点）
+TEST_P(TokenizerTest, MatchesLegacyOnRandomBytes) {
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    std::uniform_int_distribution<int> letterDist(0, 3);
+    for (int round = 0; round < 200; ++round) {
+        std::string text(static_cast<size_t>(round * 7 + 1), ' ');
+        for (char& c : text) {
+            // 偏向字母，使长单词与跨块边界的情况都能出现
+            c = letterDist(rng) == 0 ? static_cast<char>(byteDist(rng)) : static_cast<char>('A' + byteDist(rng) % 58);
+        }
+        EXPECT_EQ(simdTokenize(text, GetParam()), legacyTokenize(text)) << "round " << round;
+    }
+}
+
+// 测试用例 3：仓库自带的测试文本
+TEST_P(TokenizerTest, MatchesLegacyOnTestFiles) {
+    const char* files[] = { "test/test.txt", "test/Easy_Test.txt", "test/Cursed_Be_The_Treasure.txt" };
+    for (const char* path : files) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            continue;
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        EXPECT_EQ(simdTokenize(buffer.str(), GetParam()), legacyTokenize(buffer.str())) << path;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, TokenizerTest,
+    ::testing::Values(TokenizerBackend::Scalar, TokenizerBackend::SSE2, TokenizerBackend::AVX2));
+
+// 测试用例 4：normalizeWord 语义保持不变
+TEST(NormalizeWordTest, KeepsLettersLowercased) {
+    EXPECT_EQ(normalizeWord("Hello,"), "hello");
+    EXPECT_EQ(normalizeWord("a1B2c"), "abc");
+    EXPECT_EQ(normalizeWord("123"), "");
+    EXPECT_EQ(normalizeWord("caf\xC3\xA9"), "caf");
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
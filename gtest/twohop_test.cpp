@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <random>
+#include "../include/TwoHop.h"
+#include "TestGraphs.h"
+
+// 测试用例 1：桥接词数量与 findBridgeWords 对所有词对逐一比较一致
+TEST(TwoHopTest, CountsMatchFindBridgeWords) {
+    std::ofstream testFile("twohop_test.txt");
+    testFile << "to explore the strange new worlds to seek the new life and new civilizations the new";
+    testFile.close();
+    Graph graph;
+    ASSERT_TRUE(graph.buildFromFile("twohop_test.txt"));
+    std::remove("twohop_test.txt");
+
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    TwoHopMatrix matrix(*csr);
+    size_t nonZero = 0;
+    for (CsrGraph::VertexId a = 0; a < csr->vertexCount(); ++a) {
+        for (CsrGraph::VertexId c = 0; c < csr->vertexCount(); ++c) {
+            size_t expected = graph.findBridgeWords(csr->name(a), csr->name(c)).size();
+            TwoHopEntry entry;
+            bool found = matrix.find(a, c, entry);
+            EXPECT_EQ(found, expected > 0) << csr->name(a) << " -> " << csr->name(c);
+            if (found) {
+                EXPECT_EQ(entry.bridges, expected);
+                ++nonZero;
+            }
+        }
+    }
+    EXPECT_EQ(matrix.nonZeroCount(), nonZero);
+
+    TwoHopEntry entry;
+    CsrGraph::VertexId to = 0, the = 0;
+    csr->findVertex("to", to);
+    csr->findVertex("the", the);
+    ASSERT_TRUE(matrix.find(to, the, entry));
+    EXPECT_EQ(entry.bridges, 2u); // explore、seek
+    EXPECT_EQ(entry.weight, 2u);
+}
+
+// 测试用例 2：多线程结果与单线程一致，权重为两跳权重乘积之和
+TEST(TwoHopTest, ParallelMatchesSerialWithWeights) {
+    Graph graph = uniformGraph(1500, 9000, 3, 5);
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    TwoHopOptions serialOptions;
+    serialOptions.threads = 1;
+    TwoHopOptions parallelOptions;
+    parallelOptions.threads = 4;
+    TwoHopMatrix serial(*csr, serialOptions);
+    TwoHopMatrix parallel(*csr, parallelOptions);
+    ASSERT_EQ(serial.nonZeroCount(), parallel.nonZeroCount());
+
+    for (CsrGraph::VertexId a = 0; a < csr->vertexCount(); a += 37) {
+        std::map<CsrGraph::VertexId, uint64_t> expected;
+        const uint32_t* wab = csr->weightsBegin(a);
+        for (const CsrGraph::VertexId* b = csr->targetsBegin(a); b != csr->targetsEnd(a); ++b, ++wab) {
+            const uint32_t* wbc = csr->weightsBegin(*b);
+            for (const CsrGraph::VertexId* c = csr->targetsBegin(*b); c != csr->targetsEnd(*b); ++c, ++wbc) {
+                expected[*c] += static_cast<uint64_t>(*wab) * *wbc;
+            }
+        }
+        ASSERT_EQ(static_cast<size_t>(parallel.rowEnd(a) - parallel.rowBegin(a)), expected.size());
+        const TwoHopEntry* s = serial.rowBegin(a);
+        for (const TwoHopEntry* p = parallel.rowBegin(a); p != parallel.rowEnd(a); ++p, ++s) {
+            EXPECT_EQ(p->target, s->target);
+            EXPECT_EQ(p->bridges, s->bridges);
+            EXPECT_EQ(p->weight, expected[p->target]);
+        }
+    }
+}
+
+// 测试用例 3：top-k 与阈值限制每行输出
+TEST(TwoHopTest, TopKAndThresholds) {
+    Graph graph = uniformGraph(800, 8000, 3, 6);
+    std::shared_ptr<const CsrGraph> csr = graph.csrView();
+    TwoHopMatrix full(*csr);
+
+    TwoHopOptions options;
+    options.topK = 3;
+    options.minBridges = 2;
+    options.skipSelfPairs = true;
+    TwoHopMatrix limited(*csr, options);
+    for (CsrGraph::VertexId a = 0; a < csr->vertexCount(); ++a) {
+        std::vector<uint64_t> candidates;
+        for (const TwoHopEntry* e = full.rowBegin(a); e != full.rowEnd(a); ++e) {
+            if (e->bridges >= 2 && e->target != a) {
+                candidates.push_back(e->weight);
+            }
+        }
+        std::sort(candidates.rbegin(), candidates.rend());
+        size_t kept = static_cast<size_t>(limited.rowEnd(a) - limited.rowBegin(a));
+        ASSERT_EQ(kept, std::min<size_t>(3, candidates.size()));
+        for (const TwoHopEntry* e = limited.rowBegin(a); e != limited.rowEnd(a); ++e) {
+            EXPECT_GE(e->bridges, 2u);
+            EXPECT_NE(e->target, a);
+            EXPECT_GE(e->weight, candidates[kept - 1]);
+            if (e + 1 != limited.rowEnd(a)) {
+                EXPECT_LT(e->target, (e + 1)->target);
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
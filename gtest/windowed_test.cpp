@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "../include/WindowedGraph.h"
+#include "TestGraphs.h"
+
+// 测试用例 1：权重按纪元指数衰减，再次出现时在衰减值上累加
+TEST(WindowedGraphTest, WeightsDecay) {
+    WindowOptions options;
+    options.windowEpochs = 10;
+    options.tokensPerEpoch = 0;
+    options.decayPerEpoch = 0.5;
+    WindowedGraph graph(options);
+    graph.addEdge("new", "worlds", 8);
+    graph.advanceEpoch();
+    graph.advanceEpoch();
+    EXPECT_DOUBLE_EQ(graph.edgeWeight("new", "worlds"), 2.0);
+    graph.addEdge("new", "worlds", 1);
+    EXPECT_DOUBLE_EQ(graph.edgeWeight("new", "worlds"), 3.0);
+    graph.advanceEpoch();
+    EXPECT_DOUBLE_EQ(graph.edgeWeight("new", "worlds"), 1.5);
+    EXPECT_EQ(graph.snapshot().getAdjacencyList().at("new")[0].weight, 2);
+}
+
+// 测试用例 2：窗口外的边立即对查询不可见，随后被回收，孤立的词一并回收
+TEST(WindowedGraphTest, EdgesExpireAndAreReclaimed) {
+    WindowOptions options;
+    options.windowEpochs = 3;
+    options.tokensPerEpoch = 4;
+    WindowedGraph graph(options);
+    graph.addText("to explore the strange"); // 第 0 纪元
+    graph.endDocument();
+    EXPECT_EQ(graph.currentEpoch(), 1u);
+    EXPECT_DOUBLE_EQ(graph.edgeWeight("to", "explore"), 1.0);
+
+    graph.addText("new worlds new worlds"); // 第 1 纪元
+    graph.endDocument();
+    graph.addText("new life new life"); // 第 2 纪元
+    EXPECT_EQ(graph.currentEpoch(), 3u);
+    EXPECT_DOUBLE_EQ(graph.edgeWeight("to", "explore"), 0.0);
+    EXPECT_DOUBLE_EQ(graph.edgeWeight("new", "worlds"), 2.0);
+
+    Graph recent = graph.snapshot();
+    EXPECT_FALSE(recent.containsWord("explore"));
+    EXPECT_TRUE(recent.containsWord("life"));
+    EXPECT_EQ(recent.shortestPath("worlds", "life").first, 3); // worlds->new(1) + new->life(2)
+
+    graph.reclaimExpired();
+    EXPECT_EQ(graph.edgeCount(), 4u); // new->worlds、worlds->new、new->life、life->new
+    EXPECT_EQ(graph.vertexCount(), 3u);
+}
+
+// 测试用例 3：持续输入且词表漂移时，存储的边与词的数量受窗口约束
+TEST(WindowedGraphTest, MemoryFollowsWindow) {
+    WindowOptions options;
+    options.windowEpochs = 5;
+    options.tokensPerEpoch = 1000;
+    options.decayPerEpoch = 0.9;
+    WindowedGraph graph(options);
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> pick(0, 99);
+    size_t peakEdges = 0;
+    for (int t = 0; t < 200000; ++t) {
+        graph.addToken(wordFor(t / 500 + pick(rng))); // 词表随时间漂移
+        peakEdges = std::max(peakEdges, graph.edgeCount());
+    }
+    // 窗口内最多 5000 个词元，外加尚未回收的少量过期边
+    EXPECT_LT(peakEdges, 12000u);
+    EXPECT_LT(graph.vertexCount(), 200u);
+
+    Graph recent = graph.snapshot();
+    EXPECT_LE(recent.edgeCount(), graph.edgeCount());
+    EXPECT_FALSE(recent.containsWord(wordFor(0)));
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
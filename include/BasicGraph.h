@@ -0,0 +1,83 @@
+#ifndef BASIC_GRAPH_H
+#define BASIC_GRAPH_H
+
+#include "Graph.h"
+#include "VertexOrder.h"
+#include "PerfectHash.h"
+#include <cstdint>
+#include <type_traits>
+
+// Frozen, ID-based copy of a Graph's adjacency in compressed sparse row form, parameterized
+// by the integer types of vertex IDs and edge weights. Vertex IDs are lexicographic ranks of
+// the words (Graph's std::map order) and each row is sorted by target ID, so index-based
+// algorithms run on flat arrays whose element size the instantiation decides. A copy made by
+// permuted() numbers its vertices differently; name() and findVertex() still translate.
+// findVertex() resolves words through a minimal perfect hash built with the view.
+//
+// Instantiated for uint16_t / uint32_t IDs and uint8_t / uint16_t / uint32_t weights in
+// BasicGraph.cpp; CsrGraph is the <uint32_t, uint32_t> member of the family and
+// CompactGraph::build picks the narrowest one that fits a corpus.
+template <class VertexIdT, class WeightT>
+class BasicGraph {
+public:
+    typedef VertexIdT VertexId;
+    typedef WeightT Weight;
+    // Path lengths: 32 bits cannot overflow while both IDs and weights are 16-bit or narrower
+    typedef typename std::conditional<(sizeof(VertexIdT) <= 2 && sizeof(WeightT) <= 2), uint32_t, uint64_t>::type Distance;
+
+    static const VertexId kNoVertex = static_cast<VertexIdT>(-1);
+    static const Distance kInfinity = static_cast<Distance>(-1);
+
+    // Whether a graph with this many vertices and this largest weight is representable
+    // (the all-ones ID stays reserved for kNoVertex)
+    static bool fits(size_t vertices, uint64_t maxWeight) {
+        return vertices < static_cast<size_t>(kNoVertex) && maxWeight <= static_cast<uint64_t>(static_cast<WeightT>(-1));
+    }
+
+    BasicGraph();
+    explicit BasicGraph(const Graph& graph);
+
+    size_t vertexCount() const { return names.size(); }
+    size_t edgeCount() const { return targets.size(); }
+    // Heap bytes held by the CSR arrays and the words
+    size_t memoryBytes() const;
+
+    const std::string& name(VertexId id) const { return names[id]; }
+    bool findVertex(const std::string& word, VertexId& id) const;
+
+    uint32_t outDegree(VertexId id) const { return offsets[id + 1] - offsets[id]; }
+    const VertexId* targetsBegin(VertexId id) const { return targets.data() + offsets[id]; }
+    const VertexId* targetsEnd(VertexId id) const { return targets.data() + offsets[id + 1]; }
+    const Weight* weightsBegin(VertexId id) const { return weights.data() + offsets[id]; }
+    const std::vector<uint32_t>& rowOffsets() const { return offsets; }
+    VertexId edgeTarget(uint32_t edge) const { return targets[edge]; }
+    Weight edgeWeight(uint32_t edge) const { return weights[edge]; }
+
+    // Same vertices with every edge reversed (rows hold in-edges)
+    BasicGraph transpose() const;
+    // New numbering for the given layout: order[newId] is the current ID of that vertex
+    std::vector<VertexId> vertexOrder(VertexOrder order) const;
+    // Copy in which vertex order[i] becomes vertex i, rows re-sorted by the new target IDs
+    BasicGraph permuted(const std::vector<VertexId>& order) const;
+    // Largest |source - target| over all edges, the spread the orderings try to shrink
+    size_t bandwidth() const;
+
+    // Dijkstra from one source to one target with Graph::shortestPath's tie-breaking;
+    // returns kInfinity and leaves path empty when the target is unreachable
+    Distance shortestPath(VertexId source, VertexId target, std::vector<VertexId>& path) const;
+    // Uniform-start PageRank with Graph::calculatePageRank's dangling-node handling, by ID
+    // (Graph's own rankings run on the SparseMatrix engine; this serves CompactGraph)
+    std::vector<double> pageRank(double dampingFactor, int iterations) const;
+
+private:
+    std::vector<std::string> names;
+    std::vector<VertexId> byName;  // IDs sorted by word; empty while IDs are the sorted ranks
+    PerfectHash wordIndex;         // word -> ID; empty only if the build found a hash collision
+    std::vector<uint32_t> offsets; // V + 1
+    std::vector<VertexId> targets;
+    std::vector<Weight> weights;
+
+    void buildWordIndex();
+};
+
+#endif // BASIC_GRAPH_H
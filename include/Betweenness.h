@@ -0,0 +1,19 @@
+#ifndef BETWEENNESS_H
+#define BETWEENNESS_H
+
+#include "CsrGraph.h"
+
+struct BetweennessOptions {
+    size_t samples = 0;     // pivot sources for the approximate mode (0 = every vertex, exact)
+    unsigned seed = 1;      // pivot selection, so sampled runs are reproducible
+    unsigned threads = 0;   // worker threads (0 = all cores)
+    bool normalize = false; // divide by (V - 1)(V - 2), the number of ordered pairs excluding the vertex
+};
+
+// Weighted betweenness centrality (Brandes) over the CSR view. Path lengths are sums of
+// edge weights, the same metric as Graph::shortestPath, and every shortest path between
+// a pair counts with equal share. Sources are spread over worker threads, each with its
+// own dependency accumulator; in sampled mode the scores are scaled by V / samples.
+std::vector<double> betweennessCentrality(const CsrGraph& graph, const BetweennessOptions& options = BetweennessOptions());
+
+#endif // BETWEENNESS_H
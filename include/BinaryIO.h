@@ -0,0 +1,45 @@
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+// Length-prefixed arrays in host byte order, the layout of the binary snapshot files
+template <typename T>
+void writeArray(std::ofstream& file, const std::vector<T>& values) {
+    uint64_t count = values.size();
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    if (count > 0) {
+        file.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+    }
+}
+
+// Bytes between the read position and the end of the file
+inline uint64_t remainingBytes(std::ifstream& file) {
+    std::streampos here = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streampos end = file.tellg();
+    file.seekg(here);
+    return here < 0 || end < here ? 0 : static_cast<uint64_t>(end - here);
+}
+
+template <typename T>
+bool readArray(std::ifstream& file, std::vector<T>& values) {
+    uint64_t count = 0;
+    if (!file.read(reinterpret_cast<char*>(&count), sizeof(count))) {
+        return false;
+    }
+    // The count comes from the file: never allocate more than the bytes that are left
+    if (count > remainingBytes(file) / sizeof(T)) {
+        file.setstate(std::ios::failbit);
+        return false;
+    }
+    values.resize(static_cast<size_t>(count));
+    if (count > 0) {
+        file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+    }
+    return static_cast<bool>(file);
+}
+
+#endif // BINARY_IO_H
@@ -0,0 +1,30 @@
+#ifndef COMPACT_GRAPH_H
+#define COMPACT_GRAPH_H
+
+#include "BasicGraph.h"
+
+// Read-only query interface over whichever BasicGraph instantiation fits a corpus.
+// build() scans the Graph once for its vertex count and largest weight and picks the
+// narrowest ID and weight types, so small vocabularies run their algorithms on 2-byte IDs
+// and 1-byte weights. Answers are the same as the Graph's.
+class CompactGraph {
+public:
+    virtual ~CompactGraph() {}
+
+    // Narrowest of BasicGraph<uint16_t | uint32_t, uint8_t | uint16_t | uint32_t> for graph
+    static std::unique_ptr<CompactGraph> build(const Graph& graph);
+
+    // e.g. "BasicGraph<uint16_t, uint8_t>"
+    virtual const char* typeName() const = 0;
+    virtual size_t vertexIdBytes() const = 0;
+    virtual size_t weightBytes() const = 0;
+    virtual size_t vertexCount() const = 0;
+    virtual size_t edgeCount() const = 0;
+    virtual size_t memoryBytes() const = 0;
+
+    virtual bool containsWord(const std::string& word) const = 0;
+    virtual std::pair<double, std::vector<std::string>> shortestPath(const std::string& start, const std::string& end) const = 0;
+    virtual std::map<std::string, double> calculatePageRank(double dampingFactor, int iterations) const = 0;
+};
+
+#endif // COMPACT_GRAPH_H
@@ -0,0 +1,116 @@
+#ifndef COMPRESSED_GRAPH_H
+#define COMPRESSED_GRAPH_H
+
+#include "Graph.h"
+#include "PerfectHash.h"
+#include <cstdint>
+
+// Read-only, compact copy of a Graph for large vocabularies.
+// Vertex IDs are the lexicographic ranks of the words (the same order as Graph's std::map).
+// Each vertex's neighbors are sorted by ID and stored as LEB128 varint deltas; weights are
+// stored in the narrowest width (1, 2 or 4 bytes) that fits the largest weight. Words are
+// resolved to IDs through a minimal perfect hash that is saved with the snapshot.
+// Queries decode neighbors on the fly and give the same answers as the Graph they came from.
+class CompressedGraph {
+public:
+    typedef uint32_t VertexId;
+
+    // Decodes one vertex's neighbor list lazily
+    class NeighborIterator {
+        const uint8_t* pos;
+        const uint8_t* weights;
+        uint32_t remaining;
+        unsigned weightWidth;
+        VertexId current;
+
+    public:
+        NeighborIterator(const uint8_t* neighborPos, const uint8_t* weightPos, uint32_t count, unsigned width)
+            : pos(neighborPos), weights(weightPos), remaining(count), weightWidth(width), current(0) {}
+
+        bool next(VertexId& dest, uint32_t& weight);
+    };
+
+    // Writes a snapshot without holding the graph, for the external-memory build. Words are
+    // given up front and their IDs are their sorted ranks; edges then arrive in ascending
+    // (src, dst) ID order. Neighbor deltas and weights are streamed to two temporary files
+    // next to the snapshot and copied into it by finish(), which picks the weight width once
+    // the largest weight is known. Only the word order and the V + 1 offsets stay in memory
+    class SnapshotWriter {
+    public:
+        SnapshotWriter(const std::string& path, const std::vector<const std::string*>& words);
+        ~SnapshotWriter();
+
+        // ID of words[index] in the snapshot
+        VertexId idOf(size_t index) const { return rankOf[index]; }
+        size_t vertexCount() const { return sortedWords.size(); }
+        // False once anything has failed (the reason has been printed)
+        bool good() const { return ok; }
+        // Append one edge: src never decreases and dst increases within a row
+        bool addEdge(VertexId src, VertexId dst, uint32_t weight);
+        // Write the snapshot file; the temporary files are removed either way
+        bool finish();
+
+    private:
+        std::string path;
+        std::string neighborPath;
+        std::string weightPath;
+        std::ofstream neighborFile; // varint ID deltas, as in neighborBytes
+        std::ofstream weightFile;   // 4 bytes per edge until finish() narrows them
+        std::vector<const std::string*> sortedWords;
+        std::vector<VertexId> rankOf;
+        std::vector<uint64_t> neighborOffsets;
+        std::vector<uint32_t> edgeIndex;
+        uint64_t neighborBytesWritten;
+        uint32_t edgesWritten;
+        VertexId previousDst;
+        uint32_t maxWeight;
+        bool ok;
+
+        bool fail(const std::string& message);
+        // Close every row before vertex (rows without edges stay empty)
+        void closeRowsBefore(size_t vertex);
+        bool writeSnapshot();
+    };
+
+    CompressedGraph();
+    explicit CompressedGraph(const Graph& graph);
+
+    size_t vertexCount() const { return nameOffsets.empty() ? 0 : nameOffsets.size() - 1; }
+    size_t edgeCount() const { return edgeIndex.empty() ? 0 : edgeIndex.back(); }
+    unsigned weightWidth() const { return weightBytesPerEdge; }
+    // Heap bytes held by the compressed arrays
+    size_t memoryBytes() const;
+
+    bool findVertex(const std::string& word, VertexId& id) const;
+    std::string vertexName(VertexId id) const;
+    bool containsWord(const std::string& word) const;
+    uint32_t outDegree(VertexId id) const { return edgeIndex[id + 1] - edgeIndex[id]; }
+    NeighborIterator neighbors(VertexId id) const;
+
+    std::pair<double, std::vector<std::string>> shortestPath(const std::string& start, const std::string& end) const;
+    std::vector<std::string> randomWalk();
+    std::map<std::string, double> calculatePageRank(double dampingFactor = 0.85, int iterations = 100) const;
+
+    // Binary snapshot (host byte order) so the compressed form can be built once and shipped
+    bool saveToFile(const std::string& filename) const;
+    bool loadFromFile(const std::string& filename);
+
+private:
+    std::string namePool;               // all words back to back, in ID order
+    std::vector<uint32_t> nameOffsets;  // V + 1 offsets into namePool
+    std::vector<uint64_t> neighborOffsets; // V + 1 byte offsets into neighborBytes
+    std::vector<uint32_t> edgeIndex;    // V + 1 prefix sums of out-degrees
+    std::vector<uint8_t> neighborBytes; // varint-encoded ID deltas
+    std::vector<uint8_t> weightBytes;   // edgeCount * weightBytesPerEdge
+    unsigned weightBytesPerEdge;
+    PerfectHash wordIndex;              // word -> ID in O(1)
+    std::mt19937 rng;
+
+    int compareName(VertexId id, const std::string& word) const;
+    // Offsets start at 0, never decrease and end at their pool sizes; every neighbor list
+    // decodes within its own bytes to IDs below the vertex count. Checked on load
+    bool hasValidLayout() const;
+    void buildWordIndex();
+};
+
+#endif // COMPRESSED_GRAPH_H
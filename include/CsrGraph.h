@@ -0,0 +1,10 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include "BasicGraph.h"
+
+// 32-bit IDs and weights: the general-purpose CSR view every index-based algorithm
+// (reachability, path trees, two-hop, betweenness) runs on
+typedef BasicGraph<uint32_t, uint32_t> CsrGraph;
+
+#endif // CSR_GRAPH_H
@@ -0,0 +1,23 @@
+#ifndef DELTA_STEPPING_H
+#define DELTA_STEPPING_H
+
+#include "PathCache.h"
+
+struct DeltaSteppingOptions {
+    uint32_t delta = 0;   // bucket width in weight units (0 = mean edge weight, at least 1)
+    unsigned threads = 0; // worker threads (0 = all cores)
+};
+
+// Parallel delta-stepping single-source shortest paths over the CSR view. Vertices are
+// kept in buckets of width delta; a bucket's light edges (weight <= delta) are relaxed by
+// all workers until it stops changing, then its heavy edges once. Small frontiers are
+// relaxed on the calling thread, so short-diameter word graphs with weight-1 edges
+// spend their time in a few wide levels rather than in thread start-up.
+//
+// Returns the tree buildShortestPathTree returns: the same distances and, because each
+// parent is picked as the predecessor Dijkstra settles first (smallest distance, then
+// smallest ID), the same paths. This holds for positive weights, which text graphs have.
+ShortestPathTree deltaSteppingTree(const CsrGraph& graph, CsrGraph::VertexId source,
+    const DeltaSteppingOptions& options = DeltaSteppingOptions(), JobControl* control = nullptr);
+
+#endif // DELTA_STEPPING_H
@@ -0,0 +1,33 @@
+#ifndef EDGE_COST_H
+#define EDGE_COST_H
+
+#include "CsrGraph.h"
+#include "PathCost.h"
+
+// Cost policies for the templated shortest-path search. Each is called as
+// cost(edge, weight) with the edge's CSR index and weight, and names its PathCost in kind;
+// the search is instantiated once per policy, so the relax loop has no branch or
+// indirect call on the metric. PathCost::Hops has no policy: it goes to buildHopTree.
+
+struct CountCost {
+    static const PathCost kind = PathCost::Count;
+    double operator()(uint32_t, uint32_t weight) const { return weight; }
+};
+
+struct InverseFrequencyCost {
+    static const PathCost kind = PathCost::InverseFrequency;
+    double operator()(uint32_t, uint32_t weight) const { return 1.0 / weight; }
+};
+
+// Costs are computed once per CSR view (Graph caches them), so a search only loads
+// one double per edge, as cheap as reading the count
+struct NegativeLogProbabilityCost {
+    static const PathCost kind = PathCost::NegativeLogProbability;
+    std::vector<double> costs; // per CSR edge: log(out-weight of source) - log(weight)
+
+    explicit NegativeLogProbabilityCost(const CsrGraph& graph);
+    double operator()(uint32_t edge, uint32_t) const { return costs[edge]; }
+    size_t memoryBytes() const { return costs.capacity() * sizeof(double); }
+};
+
+#endif // EDGE_COST_H
@@ -0,0 +1,72 @@
+#ifndef EXTERNAL_BUILDER_H
+#define EXTERNAL_BUILDER_H
+
+#include "CompressedGraph.h"
+#include <cstdint>
+#include <unordered_map>
+
+struct ExternalBuildOptions {
+    size_t memoryBudgetBytes = static_cast<size_t>(256) << 20; // bigram run buffer + vocabulary
+    size_t readChunkBytes = static_cast<size_t>(1) << 20;      // bytes read from the input per step
+    size_t maxMergeFanIn = 64;                                 // runs read at once; more take several passes
+    std::string tempDir;                                       // empty: $TMPDIR or /tmp
+};
+
+struct ExternalBuildReport {
+    uint64_t tokens = 0;
+    uint64_t pairs = 0;      // bigrams seen (before aggregation)
+    uint64_t runs = 0;       // sorted runs spilled to tempDir
+    uint64_t mergePasses = 0; // intermediate passes that merged runs into longer runs
+    uint64_t edges = 0;      // distinct bigrams after the merge
+    uint64_t vertices = 0;
+    size_t vocabularyBytes = 0; // estimated bytes the vocabulary needs, finish included
+};
+
+// External-memory graph build for corpora larger than RAM.
+// Files are streamed in fixed-size chunks; each bigram becomes a (srcId, dstId) key in a
+// bounded buffer that is sorted, aggregated and spilled to tempDir as a run when full.
+// finishInto / finishToSnapshot k-way merge the runs, summing counts for equal pairs; with
+// more runs than maxMergeFanIn, groups of runs are first merged into longer runs.
+// finishToSnapshot re-sorts the summed edges by the words' snapshot IDs in a second set of
+// runs and streams the rows from that merge straight into the file.
+// Only the vocabulary (word -> ID) stays resident. It is charged against the half of the
+// budget the run buffer leaves, and addFile fails once it would need more.
+class ExternalGraphBuilder {
+public:
+    explicit ExternalGraphBuilder(const ExternalBuildOptions& options = ExternalBuildOptions());
+    ~ExternalGraphBuilder();
+
+    // Stream one text file; bigrams never span two files (same as separate buildFromFile calls)
+    bool addFile(const std::string& filePath);
+
+    // Merge into an in-memory Graph, or straight into a compressed snapshot on disk
+    bool finishInto(Graph& graph);
+    bool finishToSnapshot(const std::string& snapshotPath);
+
+    const ExternalBuildReport& report() const { return buildReport; }
+
+private:
+    ExternalBuildOptions options;
+    ExternalBuildReport buildReport;
+    std::unordered_map<std::string, uint32_t> vocabulary;
+    std::vector<const std::string*> words; // ID -> key stored in vocabulary
+    std::vector<bool> inPair;              // words that appear in at least one bigram
+    std::vector<uint64_t> pairBuffer;      // (src << 32) | dst
+    size_t pairCapacity;
+    size_t vocabularyBudget;
+    size_t mergeFanIn;
+    std::vector<std::string> runFiles;
+    std::string lookupKey; // reused so known words are resolved without allocating
+    bool finished;
+
+    uint32_t wordId(const char* word, size_t length);
+    bool spillRun();
+    // Merge groups of runs into longer runs until at most mergeFanIn are left
+    bool reduceRuns();
+    // Visits merged (src, dst, count) triples in ascending (src, dst) ID order
+    template <typename Sink>
+    bool mergeRuns(Sink& sink);
+    void removeRuns();
+};
+
+#endif // EXTERNAL_BUILDER_H
@@ -16,6 +16,14 @@
 #include <limits>
 #include <stack>
 #include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <memory>
+
+#include "GraphStats.h"
+#include "VertexOrder.h"
+#include "PathCost.h"
+#include "LazyCache.h"
 
 // For graph visualization
 #include <fstream>
@@ -26,8 +34,20 @@
 #define BLUE    "\033[34m"
 #define YELLOW  "\033[33m"
 
+template <class VertexIdT, class WeightT> class BasicGraph;
+typedef BasicGraph<uint32_t, uint32_t> CsrGraph;
+class ReachabilityIndex;
+class ShortestPathCache;
+class JobControl;
+struct ShortestPathTree;
+struct NegativeLogProbabilityCost;
+class SparseMatrix;
+class ShortestPathStream;
+class RandomWalkStream;
+class GraphBuilder;
+
 class Graph {
-private:
+public:
     struct Edge {
         std::string dest;
         int weight;
@@ -37,29 +57,141 @@ private:
             return dest < other.dest;
         }
     };
+
+    // Corpus counts for TF-IDF: occurrences of a word and number of documents containing it
+    struct TermCounts {
+        uint64_t termFrequency = 0;
+        uint64_t documentFrequency = 0;
+    };
+
+private:
     // Adjacency list representation
     std::map<std::string, std::vector<Edge>> adjacencyList;
     // Random number generator
     std::mt19937 rng;
+    // Per-word counts over every document ingested by buildFromFile / buildFromFiles / merge
+    std::map<std::string, TermCounts> corpusTerms;
+    // Build timings and per-query counters reported by stats()
+    BuildStats buildStats;
+    mutable QueryCounters queryCounters;
+    // Replaced by every change (addEdge, merge, a build) with a process-wide unique number, so
+    // copies that diverge never share a version; derived structures remember the one they came from
+    uint64_t version = 0;
+    // Derived structures built on first use and rebuilt once the version moves on (see
+    // LazyCache.h); safe to fill from concurrent const queries
+    LazyCache<CsrGraph> csrCache;
+    LazyCache<CsrGraph> inEdgeCache; // csrView() transposed: each row lists a word's predecessors
+    LazyCache<ReachabilityIndex> reachabilityCache;
+    LazyCache<NegativeLogProbabilityCost> logProbabilityCache;
+    LazyCache<SparseMatrix> matrixCache; // also holds every word's out-weight sum
+    // Numbering of csrView() and therefore of the rankings' matrix
+    VertexOrder vertexOrder = VertexOrder::Lexicographic;
+    // LRU of shortest-path trees keyed by source and cost; shared by copies, keyed on version
+    std::shared_ptr<ShortestPathCache> pathCache;
+    // Count-cost trees are built by Dijkstra when 1, otherwise by delta-stepping on this many
+    // workers (0 = all cores); both produce the same trees, so the cache does not care.
+    // Breadth-first hop searches use the same worker count
+    unsigned pathThreads = 1;
+    uint32_t pathDelta = 0;
+    // Workers for the matrix products of PageRank, HITS and Katz (0 = all cores); the
+    // products sum every element in a fixed order, so the scores do not depend on it
+    unsigned rankThreads = 1;
+
+    MemoryStats estimateMemory() const;
+    void publishShortestPathCounters(uint64_t settled, uint64_t relaxed) const;
+    // With a target (any ID but CsrGraph::kNoVertex), a source not asked for before at this
+    // version gets a search pruned at the target instead of a full tree (see
+    // ShortestPathCache::seenBefore); only full trees are cached
+    std::shared_ptr<const ShortestPathTree> shortestPathTree(uint32_t sourceId, PathCost cost = PathCost::Count,
+        JobControl* control = nullptr, uint32_t targetId = static_cast<uint32_t>(-1)) const;
+    std::shared_ptr<const NegativeLogProbabilityCost> logProbabilityCosts() const;
+    std::shared_ptr<const SparseMatrix> rankMatrix() const;
+    std::shared_ptr<const CsrGraph> inEdgeView() const;
+    std::map<std::string, double> byWord(const std::vector<double>& values) const;
+    void recordDocument(const std::string& firstWord);
+    std::map<std::string, double> tfIdfFromCounts(const std::map<std::string, TermCounts>& counts, size_t numDocs) const;
 
 public:
-    Graph() : rng(static_cast<unsigned int>(time(nullptr))) {}
+    Graph();
     bool buildFromFile(const std::string& filePath);
-    void addEdge(const std::string& src, const std::string& dest);
+    // Build one partial graph per file on worker threads (0 = all cores) and merge them in order;
+    // no edge links the last word of one file to the first word of the next
+    bool buildFromFiles(const std::vector<std::string>& filePaths, unsigned threads = 0);
+    // Sum edge weights and corpus counts of other into this graph, adding its words as needed
+    void merge(const Graph& other);
+    void addEdge(const std::string& src, const std::string& dest, int weight = 1);
+    // Add every edge counted in builder (see GraphBuilder.h) with a single version bump; an empty
+    // graph is filled directly, otherwise the counts are merged in as with merge
+    void addEdges(const GraphBuilder& builder);
     void displayGraph() const;
     bool saveGraphToFile(const std::string& filename) const;
     std::vector<std::string> findBridgeWords(const std::string& word1, const std::string& word2) const;
     std::string generateTextWithBridges(const std::string& inputText);
-    std::pair<double, std::vector<std::string>> shortestPath(const std::string& start, const std::string& end) const;
-    std::map<std::string, std::pair<double, std::vector<std::string>>> shortestPathsFromSource(const std::string& start) const;
+    // Path searches minimize the given cost (see PathCost.h); the default sums raw counts
+    std::pair<double, std::vector<std::string>> shortestPath(const std::string& start, const std::string& end,
+        PathCost cost = PathCost::Count) const;
+    // The long-running queries take an optional JobControl: they report progress to it, stop
+    // early once it asks them to, and then return an empty result
+    std::map<std::string, std::pair<double, std::vector<std::string>>> shortestPathsFromSource(const std::string& start,
+        JobControl* control = nullptr, PathCost cost = PathCost::Count) const;
+    // Same destinations one at a time, nearest first, as they are settled (see ResultStream.h);
+    // empty when start is not in the graph. Nothing is cached, so a caller may stop at any point
+    ShortestPathStream streamShortestPaths(const std::string& start, PathCost cost = PathCost::Count) const;
     std::map<std::string, double> calculatePageRank(double dampingFactor = 0.85, 
-        std::map<std::string, double> customInitialRanks = std::map<std::string, double>(), int iterations = 100) const;
+        std::map<std::string, double> customInitialRanks = std::map<std::string, double>(), int iterations = 100,
+        JobControl* control = nullptr) const;
     std::map<std::string, double> calculateTfIdfRanks(const std::string& filePath) const;
     std::map<std::string, double> calculatePageRankWithTfIdf(const std::string& filePath,
         double dampingFactor,
-        int iterations) const;
+        int iterations,
+        JobControl* control = nullptr) const;
+    // HITS hub (first) and authority (second) scores of every word, each summing to 1.
+    // Stops early once an iteration changes the authorities by less than 1e-12 in L1
+    std::pair<std::map<std::string, double>, std::map<std::string, double>> calculateHits(int iterations = 100,
+        JobControl* control = nullptr) const;
+    // Katz centrality per word (see katzScores in SparseMatrix.h; alpha 0 picks a safe value),
+    // with the same early stop as calculateHits
+    std::map<std::string, double> calculateKatz(double alpha = 0.0, int iterations = 100,
+        JobControl* control = nullptr) const;
+    // TF-IDF from the per-document counts recorded while building, one document per input file
+    std::map<std::string, double> calculateTfIdfRanks() const;
+    std::map<std::string, double> calculatePageRankWithTfIdf(double dampingFactor, int iterations,
+        JobControl* control = nullptr) const;
+    // Weighted betweenness centrality per word; samples > 0 approximates from that many sources
+    std::map<std::string, double> calculateBetweenness(size_t samples = 0, unsigned threads = 0) const;
     std::vector<std::string> randomWalk();
+    // randomWalk one step at a time; the stream draws from its own generator seeded from this graph's
+    // and adds the walk to stats() when it ends, so it must not outlive the graph
+    RandomWalkStream streamRandomWalk();
     bool containsWord(const std::string& word) const;
+    size_t vertexCount() const;
+    size_t edgeCount() const;
+    GraphStats stats() const;
+    // Read-only view used to build the alternative representations (e.g. CompressedGraph)
+    const std::map<std::string, std::vector<Edge>>& getAdjacencyList() const { return adjacencyList; }
+    uint64_t getVersion() const { return version; }
+    const std::map<std::string, TermCounts>& getCorpusTerms() const { return corpusTerms; }
+    // ID-based CSR copy and SCC reachability index of the current graph (built lazily)
+    std::shared_ptr<const CsrGraph> csrView() const;
+    // Relabel csrView() for locality (see VertexOrder.h). Results stay keyed by word, but
+    // equally short paths are then tie-broken by the new IDs instead of alphabetically
+    void setVertexOrder(VertexOrder order);
+    VertexOrder getVertexOrder() const { return vertexOrder; }
+    std::shared_ptr<const ReachabilityIndex> reachabilityIndex() const;
+    bool isReachable(const std::string& from, const std::string& to) const;
+    // Unweighted queries answered by breadth-first search (see HopSearch.h) on pathThreads
+    // workers. Fewest edges from one word to another, -1 when either is missing or unreachable
+    int hopDistance(const std::string& from, const std::string& to) const;
+    // Words at most hops edges away from word, with their hop counts; word itself is left out
+    std::map<std::string, uint32_t> neighborhood(const std::string& word, uint32_t hops) const;
+    // Every word reachable from word along one or more edges, alphabetically; word itself is left out
+    std::vector<std::string> reachableSet(const std::string& word) const;
+    // Memory budget of the shortest-path tree cache (0 disables caching)
+    void setPathCacheBudget(size_t bytes);
+    // Worker threads for single-source path searches (see pathThreads); delta 0 = automatic
+    void setPathThreads(unsigned threads, uint32_t delta = 0);
+    // Worker threads for the matrix products of the iterative rankings (see rankThreads)
+    void setRankThreads(unsigned threads);
     // std::vector<std::string> getAllVertices() const;
 };
 
@@ -0,0 +1,73 @@
+#ifndef GRAPH_BUILDER_H
+#define GRAPH_BUILDER_H
+
+#include "Graph.h"
+#include <cstdint>
+
+// Bump allocator for word bytes: large blocks are carved front to back and freed together
+class StringArena {
+public:
+    StringArena() : cursor(nullptr), left(0), used(0) {}
+    // Stable copy of the bytes, valid until the arena is destroyed
+    const char* store(const char* data, size_t length);
+    size_t bytesUsed() const { return used; }
+
+private:
+    static const size_t kBlockSize = 64 * 1024;
+    std::vector<std::unique_ptr<char[]>> blocks;
+    char* cursor;
+    size_t left;
+    size_t used;
+};
+
+// Mutable structure a build fills token by token before it becomes Graph's adjacency map.
+// Each word's bytes are copied into the arena once and it is numbered by first appearance;
+// bigram counts live in an open-addressing table keyed by (source ID, target ID). A token
+// whose word and bigram were seen before costs one probe into each table and allocates
+// nothing; the tables grow by doubling, so new entries are amortized O(1) as well.
+class GraphBuilder {
+public:
+    static const uint32_t kNoWord = UINT32_MAX;
+
+    GraphBuilder();
+
+    // ID of the word, adding it on first sight
+    uint32_t intern(const char* data, size_t length);
+    // Add weight to src -> dest
+    void addEdge(uint32_t src, uint32_t dest, uint32_t weight = 1);
+
+    size_t vertexCount() const { return words.size(); }
+    size_t edgeCount() const { return edges.size(); }
+    std::string word(uint32_t id) const { return std::string(words[id].data, words[id].length); }
+    // Current count of src -> dest, 0 if absent
+    uint32_t weight(uint32_t src, uint32_t dest) const;
+
+    // Fill an empty adjacency map: every word that is on an edge becomes a vertex, and each
+    // source lists its targets in first-seen order, the order Graph::addEdge would give
+    void fill(std::map<std::string, std::vector<Graph::Edge>>& adjacency) const;
+
+private:
+    struct Word {
+        const char* data;
+        uint32_t length;
+        uint64_t hash;
+    };
+    struct EdgeEntry {
+        uint32_t src;
+        uint32_t dest;
+        uint32_t weight;
+    };
+
+    StringArena arena;
+    std::vector<Word> words;
+    std::vector<uint32_t> wordSlots; // word IDs, kNoWord when free; size is a power of two
+    std::vector<EdgeEntry> edges;    // in first-seen order
+    std::vector<uint32_t> edgeSlots; // indices into edges, kNoWord when free
+
+    static uint64_t edgeHash(uint32_t src, uint32_t dest);
+    size_t findEdgeSlot(uint32_t src, uint32_t dest) const;
+    void growWords();
+    void growEdges();
+};
+
+#endif // GRAPH_BUILDER_H
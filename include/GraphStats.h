@@ -0,0 +1,120 @@
+#ifndef GRAPH_STATS_H
+#define GRAPH_STATS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Counters are on by default; build with -DTEXTGRAPH_NO_STATS (make STATS=0) to compile them out
+#ifdef TEXTGRAPH_NO_STATS
+#define TG_STATS_ENABLED 0
+#define TG_STAT(stmt) do { } while (0)
+#else
+#define TG_STATS_ENABLED 1
+#define TG_STAT(stmt) do { stmt; } while (0)
+#endif
+
+// Relaxed atomic that stays copyable, so Graph keeps its value semantics
+template <typename T>
+class StatCounter {
+    std::atomic<T> value;
+
+public:
+    StatCounter() : value(T()) {}
+    StatCounter(const StatCounter& other) : value(other.load()) {}
+    StatCounter& operator=(const StatCounter& other) {
+        store(other.load());
+        return *this;
+    }
+
+    T load() const { return value.load(std::memory_order_relaxed); }
+    void store(T v) { value.store(v, std::memory_order_relaxed); }
+    void add(T v) { value.fetch_add(v, std::memory_order_relaxed); }
+};
+
+// Timings of the last build (summed over documents for multi-file builds),
+// token and document counts accumulated over all builds
+struct BuildStats {
+    uint64_t tokens = 0;
+    uint64_t documents = 0;
+    double readMs = 0.0;
+    double tokenizeMs = 0.0;
+    double insertMs = 0.0;
+};
+
+// Estimated heap footprint of the adjacency list and of the derived views built so far, in
+// bytes. A view that has not been built for the current version counts 0
+struct MemoryStats {
+    size_t mapNodes = 0;      // red-black tree nodes holding key + edge vector header
+    size_t vertexStrings = 0; // heap buffers of vertex names (0 when the name fits SSO)
+    size_t edgeArrays = 0;    // capacity of every per-vertex edge vector
+    size_t edgeStrings = 0;   // heap buffers of Edge::dest copies
+
+    size_t csrView = 0;       // CSR arrays, names and the perfect hash over them
+    size_t inEdgeView = 0;    // transposed CSR
+    size_t reachability = 0;  // component DAG plus closure or labels
+    size_t rankMatrix = 0;    // SparseMatrix of PageRank, HITS and Katz
+    size_t logProbabilityCosts = 0;
+    size_t pathTrees = 0;     // shortest-path trees held by the path cache
+
+    size_t adjacency() const { return mapNodes + vertexStrings + edgeArrays + edgeStrings; }
+    size_t derived() const {
+        return csrView + inEdgeView + reachability + rankMatrix + logProbabilityCosts + pathTrees;
+    }
+    size_t total() const { return adjacency() + derived(); }
+};
+
+// Hot-path counters: "last" values describe the most recent call, "total" ones all calls
+struct QueryStats {
+    uint64_t shortestPathCalls = 0;
+    uint64_t lastVerticesSettled = 0;
+    uint64_t lastEdgesRelaxed = 0;
+    uint64_t totalVerticesSettled = 0;
+    uint64_t totalEdgesRelaxed = 0;
+
+    uint64_t pageRankCalls = 0;
+    uint64_t lastPageRankIterations = 0;
+    double lastPageRankResidual = 0.0; // L1 distance between the last two rank vectors
+
+    uint64_t randomWalkCalls = 0;
+    uint64_t lastRandomWalkSteps = 0;
+    uint64_t totalRandomWalkSteps = 0;
+};
+
+// Shortest-path tree cache occupancy and effectiveness
+struct PathCacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+    size_t budgetBytes = 0;
+};
+
+struct GraphStats {
+    size_t vertices = 0;
+    size_t edges = 0;
+    BuildStats build;
+    MemoryStats memory;
+    QueryStats queries;
+    PathCacheStats pathCache;
+};
+
+// Live counters owned by Graph; snapshot them through Graph::stats()
+struct QueryCounters {
+    StatCounter<uint64_t> shortestPathCalls;
+    StatCounter<uint64_t> lastVerticesSettled;
+    StatCounter<uint64_t> lastEdgesRelaxed;
+    StatCounter<uint64_t> totalVerticesSettled;
+    StatCounter<uint64_t> totalEdgesRelaxed;
+
+    StatCounter<uint64_t> pageRankCalls;
+    StatCounter<uint64_t> lastPageRankIterations;
+    StatCounter<double> lastPageRankResidual;
+
+    StatCounter<uint64_t> randomWalkCalls;
+    StatCounter<uint64_t> lastRandomWalkSteps;
+    StatCounter<uint64_t> totalRandomWalkSteps;
+};
+
+#endif // GRAPH_STATS_H
@@ -0,0 +1,35 @@
+#ifndef HOP_SEARCH_H
+#define HOP_SEARCH_H
+
+#include "CsrGraph.h"
+
+struct HopSearchOptions {
+    uint32_t maxHops = UINT32_MAX;          // do not expand past this depth
+    CsrGraph::VertexId target = CsrGraph::kNoVertex; // stop once this vertex is reached
+    unsigned threads = 1;                   // worker threads (0 = all cores)
+    // Beamer's switch points: go bottom-up once the frontier's out-edges exceed the unexplored
+    // edges / alpha, and back top-down once the frontier holds fewer than V / beta vertices
+    double alpha = 14.0;
+    double beta = 24.0;
+};
+
+struct HopSearchResult {
+    static const uint32_t kUnreached = UINT32_MAX;
+    std::vector<uint32_t> hops; // edges on a shortest unweighted path, kUnreached if not found
+    size_t reached = 0;         // vertices with a hop count, the source included
+    uint32_t levels = 0;        // frontiers expanded
+    uint32_t topDownSteps = 0;
+    uint32_t bottomUpSteps = 0;
+};
+
+// Unweighted breadth-first search from one source with direction optimization. A top-down
+// step pushes a sparse frontier (a vertex list) along out-edges, claiming vertices with an
+// atomic visited bitmap. A bottom-up step lets every unvisited vertex scan its in-edges
+// (inEdges is graph.transpose()) for a member of a dense frontier (a bitmap) and stop at the
+// first hit, which wins on the few wide middle levels of a short-diameter word graph. Both
+// steps split the work across threads; small frontiers stay on the calling thread. Hop
+// counts do not depend on the thread count or on which steps were taken.
+HopSearchResult hopSearch(const CsrGraph& graph, const CsrGraph& inEdges, CsrGraph::VertexId source,
+    const HopSearchOptions& options = HopSearchOptions());
+
+#endif // HOP_SEARCH_H
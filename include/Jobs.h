@@ -0,0 +1,99 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Shared between a running computation and the thread watching it. Algorithms poll
+// shouldStop() at natural checkpoints (an iteration, a batch of settled vertices) and
+// report how far they are; nothing is interrupted preemptively.
+class JobControl {
+public:
+    JobControl() : cancelFlag(false), stopSeen(false), deadlineNs(0), done(0), total(0) {}
+
+    void requestCancel() { cancelFlag.store(true); }
+    bool cancelRequested() const { return cancelFlag.load(); }
+    // Stop once this much time has passed from now (0 = no deadline)
+    void setDeadline(std::chrono::milliseconds timeout);
+    bool deadlinePassed() const;
+    bool shouldStop() const;
+    // True once shouldStop() has answered true, i.e. a computation saw the request and gave
+    // up early. A cancel or deadline that lands after the work's last checkpoint leaves it
+    // false, so a finished result is not thrown away
+    bool interrupted() const { return stopSeen.load(); }
+
+    void reportProgress(uint64_t completed, uint64_t outOf) {
+        total.store(outOf, std::memory_order_relaxed);
+        done.store(completed, std::memory_order_relaxed);
+    }
+    uint64_t progressDone() const { return done.load(std::memory_order_relaxed); }
+    uint64_t progressTotal() const { return total.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> cancelFlag;
+    mutable std::atomic<bool> stopSeen;
+    std::atomic<int64_t> deadlineNs; // steady_clock time since epoch, 0 when unset
+    std::atomic<uint64_t> done;
+    std::atomic<uint64_t> total;
+};
+
+enum class JobState { Running, Finished, Cancelled, TimedOut };
+
+const char* jobStateName(JobState state);
+
+// One computation on its own thread. work returns true when it ran to completion and
+// false when it stopped early because the control asked it to.
+class Job {
+public:
+    Job(int id, std::string description, std::chrono::milliseconds deadline,
+        std::function<bool(JobControl&)> work, std::function<void()> presentResult);
+    ~Job();
+
+    int id() const { return jobId; }
+    const std::string& description() const { return text; }
+    JobState state() const { return static_cast<JobState>(currentState.load()); }
+    JobControl& control() { return jobControl; }
+    const JobControl& control() const { return jobControl; }
+    double elapsedSeconds() const;
+    // Runs the presenter given at start; only meaningful once the job has Finished
+    void presentResult() const { present(); }
+    void cancel() { jobControl.requestCancel(); }
+    void wait();
+
+private:
+    int jobId;
+    std::string text;
+    JobControl jobControl;
+    std::function<void()> present;
+    std::atomic<int> currentState;
+    std::chrono::steady_clock::time_point started;
+    std::atomic<int64_t> finishedNs;
+    std::thread worker;
+};
+
+// Jobs started from the interactive menu; cancels and joins whatever is left on exit
+class JobManager {
+public:
+    ~JobManager();
+
+    std::shared_ptr<Job> start(const std::string& description, std::chrono::milliseconds deadline,
+        std::function<bool(JobControl&)> work, std::function<void()> presentResult);
+    std::shared_ptr<Job> find(int id) const;
+    std::vector<std::shared_ptr<Job>> list() const;
+    // Forget a job that is no longer running; false if it is unknown or still running
+    bool remove(int id);
+
+private:
+    mutable std::mutex mutex;
+    std::vector<std::shared_ptr<Job>> jobs;
+    int nextId = 1;
+};
+
+#endif // JOBS_H
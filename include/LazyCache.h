@@ -0,0 +1,61 @@
+#ifndef LAZY_CACHE_H
+#define LAZY_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// Holder of one structure derived from a Graph. It is built on the first get() and tagged
+// with the graph version it came from; a get() with any other version rebuilds it, so a
+// change only has to bump the version. Concurrent const queries may call get() at once: the
+// first builds while the others wait for its result instead of building their own. The
+// structure is immutable, so copies of the holder share it.
+template <class T>
+class LazyCache {
+public:
+    LazyCache() : builtFor(0) {}
+    LazyCache(const LazyCache& other) : builtFor(0) {
+        std::lock_guard<std::mutex> lock(other.mutex);
+        value = other.value;
+        builtFor = other.builtFor;
+    }
+    LazyCache& operator=(const LazyCache& other) {
+        if (this != &other) {
+            std::shared_ptr<const T> otherValue;
+            uint64_t otherVersion = 0;
+            {
+                std::lock_guard<std::mutex> lock(other.mutex);
+                otherValue = other.value;
+                otherVersion = other.builtFor;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            value.swap(otherValue);
+            builtFor = otherVersion;
+        }
+        return *this;
+    }
+
+    // The structure for this version; build() returns a std::shared_ptr<const T> when needed
+    template <class Build>
+    std::shared_ptr<const T> get(uint64_t version, Build build) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!value || builtFor != version) {
+            value.reset(); // let a stale copy go before its replacement is allocated
+            value = build();
+            builtFor = version;
+        }
+        return value;
+    }
+    // The structure if it is already built for this version, otherwise null; never builds
+    std::shared_ptr<const T> peek(uint64_t version) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return builtFor == version ? value : std::shared_ptr<const T>();
+    }
+
+private:
+    mutable std::mutex mutex;
+    mutable std::shared_ptr<const T> value;
+    mutable uint64_t builtFor;
+};
+
+#endif // LAZY_CACHE_H
@@ -0,0 +1,176 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Worker count used when a caller asks for 0 threads: every hardware thread, at least one
+inline unsigned defaultThreadCount() {
+    unsigned count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+// Workers actually started for count items: 0 means all cores, never more than the items
+inline unsigned workerCount(size_t count, unsigned threads) {
+    if (threads == 0) {
+        threads = defaultThreadCount();
+    }
+    if (threads > count) {
+        threads = static_cast<unsigned>(count);
+    }
+    return threads == 0 ? 1 : threads;
+}
+
+// Run body(index, worker) for every index in [0, count) on workerCount(count, threads) threads.
+// worker is in [0, workerCount) so callers can keep per-worker scratch space. Indices are
+// handed out one at a time, so uneven items balance themselves; the calling thread works
+// too and the function returns once every index is done.
+template <class Body>
+void parallelForWorkers(size_t count, unsigned threads, Body body) {
+    const unsigned workers = workerCount(count, threads);
+    if (workers <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            body(i, 0u);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    auto worker = [&](unsigned id) {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            body(i, id);
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (unsigned t = 1; t < workers; ++t) {
+        pool.push_back(std::thread(worker, t));
+    }
+    worker(0);
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+}
+
+// Same as parallelForWorkers for bodies that do not need the worker index
+template <class Body>
+void parallelFor(size_t count, unsigned threads, Body body) {
+    parallelForWorkers(count, threads, [&body](size_t i, unsigned) { body(i); });
+}
+
+// Threads kept for a whole computation made of many short parallel loops, such as one per
+// phase of a search, where parallelForWorkers would spawn and join threads every time. The
+// calling thread is worker 0 and the pool adds size() - 1 threads, started by the first loop
+// that runs in parallel and stopped by the destructor. Loops run one at a time, from the
+// thread that owns the pool.
+class WorkerPool {
+public:
+    // threads as for workerCount: 0 means all cores
+    explicit WorkerPool(unsigned threads)
+        : workers(workerCount(std::numeric_limits<size_t>::max(), threads)) {}
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+    }
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    unsigned size() const { return workers; }
+
+    // parallelForWorkers on the pool's threads: body(index, worker) with worker in [0, size()).
+    // With parallel false, or a single index, the loop runs on the calling thread alone
+    template <class Body>
+    void forEachWorker(size_t count, bool parallel, Body body) {
+        const unsigned active = parallel ? workerCount(count, workers) : 1u;
+        if (active <= 1) {
+            for (size_t i = 0; i < count; ++i) {
+                body(i, 0u);
+            }
+            return;
+        }
+        std::function<void(size_t, unsigned)> task(body);
+        run(count, active, task);
+    }
+
+    // Same as forEachWorker for bodies that do not need the worker index
+    template <class Body>
+    void forEach(size_t count, bool parallel, Body body) {
+        forEachWorker(count, parallel, [&body](size_t i, unsigned) { body(i); });
+    }
+
+private:
+    const unsigned workers;
+    std::vector<std::thread> pool;
+    std::mutex mutex;
+    std::condition_variable wake; // a new loop or the destructor
+    std::condition_variable idle; // the last helper finished its share
+    const std::function<void(size_t, unsigned)>* task = nullptr;
+    size_t taskCount = 0;
+    unsigned taskWorkers = 0;
+    std::atomic<size_t> next{0};
+    uint64_t generation = 0; // loops started so far
+    unsigned busy = 0;       // helpers still working on the current loop
+    bool stopping = false;
+
+    void run(size_t count, unsigned active, const std::function<void(size_t, unsigned)>& body) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (unsigned id = static_cast<unsigned>(pool.size()) + 1; id < workers; ++id) {
+                pool.push_back(std::thread(&WorkerPool::helperLoop, this, id));
+            }
+            task = &body;
+            taskCount = count;
+            taskWorkers = active;
+            next.store(0);
+            busy = active - 1;
+            generation++;
+        }
+        wake.notify_all();
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            body(i, 0u);
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this]() { return busy == 0; });
+        task = nullptr;
+    }
+
+    void helperLoop(unsigned id) {
+        uint64_t seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;) {
+            wake.wait(lock, [this, seen]() { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            if (id >= taskWorkers) {
+                continue; // this loop is too small to need every helper
+            }
+            const std::function<void(size_t, unsigned)>& body = *task;
+            const size_t count = taskCount;
+            lock.unlock();
+            for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+                body(i, id);
+            }
+            lock.lock();
+            if (--busy == 0) {
+                idle.notify_one();
+            }
+        }
+    }
+};
+
+#endif // PARALLEL_H
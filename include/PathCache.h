@@ -0,0 +1,86 @@
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include "CsrGraph.h"
+#include "PathCost.h"
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+// Single-source shortest-path tree over CsrGraph IDs, tagged with the graph version it came from
+struct ShortestPathTree {
+    uint64_t version = 0;
+    CsrGraph::VertexId source = CsrGraph::kNoVertex;
+    PathCost cost = PathCost::Count;       // the metric distances are measured in
+    std::vector<double> distance;          // infinity when unreachable
+    std::vector<CsrGraph::VertexId> parent; // kNoVertex for the source and unreachable vertices
+    uint64_t settled = 0;
+    uint64_t relaxed = 0;
+    bool complete = true; // false when the search stopped early (JobControl or target settled)
+
+    size_t memoryBytes() const {
+        return sizeof(*this) + distance.capacity() * sizeof(double) + parent.capacity() * sizeof(CsrGraph::VertexId);
+    }
+    // Words from the source to target, empty when target is unreachable
+    std::vector<std::string> pathTo(const CsrGraph& graph, CsrGraph::VertexId target) const;
+};
+
+class JobControl;
+
+// Heap-based Dijkstra from one source to every vertex, with edge costs from a policy in
+// EdgeCost.h (instantiated for each of them in PathCache.cpp). Ties settle the smaller ID
+// (in the default numbering the lexicographically smaller word) first, the order
+// Graph::shortestPath always used. With a control, progress is settled vertices out of V
+// and the search may stop early. With a target the search stops once the target is settled:
+// its distance and path are final, the tree is marked incomplete and is not worth caching
+template <class Cost>
+ShortestPathTree buildShortestPathTree(const CsrGraph& graph, CsrGraph::VertexId source, const Cost& cost,
+    JobControl* control = nullptr, CsrGraph::VertexId target = CsrGraph::kNoVertex);
+// Same with CountCost
+ShortestPathTree buildShortestPathTree(const CsrGraph& graph, CsrGraph::VertexId source, JobControl* control = nullptr,
+    CsrGraph::VertexId target = CsrGraph::kNoVertex);
+// Unit-cost fast path: breadth-first search one level at a time, each level expanded in ID
+// order so that parents match what Dijkstra with cost 1 per edge would choose. A target
+// ends the search as soon as it is reached, since its first parent is already final
+ShortestPathTree buildHopTree(const CsrGraph& graph, CsrGraph::VertexId source, JobControl* control = nullptr,
+    CsrGraph::VertexId target = CsrGraph::kNoVertex);
+
+// Thread-safe LRU cache of shortest-path trees keyed by source vertex and cost, bounded by a
+// memory budget. A lookup with a newer graph version drops every tree built from an older one.
+class ShortestPathCache {
+public:
+    explicit ShortestPathCache(size_t memoryBudgetBytes = static_cast<size_t>(64) << 20);
+
+    std::shared_ptr<const ShortestPathTree> find(CsrGraph::VertexId source, uint64_t version, PathCost cost = PathCost::Count);
+    // Whether a search from source with this cost was already asked for at this version; the
+    // first call for a key answers false and remembers it. Lets single-target queries run a
+    // pruned search for a one-off source and pay for the full tree only once it repeats
+    bool seenBefore(CsrGraph::VertexId source, uint64_t version, PathCost cost = PathCost::Count);
+    void insert(const std::shared_ptr<const ShortestPathTree>& tree);
+    void clear();
+    void setMemoryBudget(size_t bytes);
+    PathCacheStats stats() const;
+
+private:
+    typedef std::list<std::shared_ptr<const ShortestPathTree>> LruList;
+
+    mutable std::mutex mutex;
+    LruList lru; // most recently used first
+    std::unordered_map<uint64_t, LruList::iterator> bySource; // key: cost << 32 | source
+    std::unordered_set<uint64_t> seen; // keys passed to seenBefore, bounded by kMaxSeen
+    uint64_t currentVersion;
+    size_t bytes;
+    size_t budget;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+
+    static const size_t kMaxSeen = 1 << 16;
+
+    void dropAllLocked();
+    void syncVersionLocked(uint64_t version);
+    void evictLocked();
+};
+
+#endif // PATH_CACHE_H
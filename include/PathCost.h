@@ -0,0 +1,19 @@
+#ifndef PATH_COST_H
+#define PATH_COST_H
+
+#include <string>
+
+// What a shortest path minimizes. Count sums the raw bigram counts (the historical
+// meaning, under which frequent transitions are "far"); the others make them near.
+enum class PathCost {
+    Count,                  // sum of edge weights
+    InverseFrequency,       // sum of 1 / weight
+    NegativeLogProbability, // -log P(path) with P(dest | src) = weight / out-weight of src
+    Hops                    // number of edges, answered by breadth-first search
+};
+
+const char* pathCostName(PathCost cost);
+// Accepts "count", "inverse", "logprob" and "hops"; returns false for anything else
+bool parsePathCost(const std::string& text, PathCost& cost);
+
+#endif // PATH_COST_H
@@ -0,0 +1,57 @@
+#ifndef PERFECT_HASH_H
+#define PERFECT_HASH_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Perfect hash over a frozen vocabulary (CHD: hash, displace, compress). Keys are hashed
+// once to 64 bits; build() splits them into buckets of about five and finds for each bucket
+// a displacement that sends every one of its keys to a free slot of a table 10% larger than
+// the key count, which keeps the build linear. A lookup is one pass over the word plus two
+// integer mixes. A one-byte fingerprint per slot turns away most absent words without
+// touching the strings, and callers confirm a hit against their own contiguous word storage.
+// About six and a half bytes per key in total.
+class PerfectHash {
+public:
+    static const uint32_t kNotFound = 0xFFFFFFFFu;
+
+    static uint64_t hashKey(const char* data, size_t length);
+    static uint64_t hashKey(const std::string& word) { return hashKey(word.data(), word.size()); }
+
+    // Map keyHashes[i] to i. Fails, leaving the index empty, when two keys share a hash
+    bool build(const std::vector<uint64_t>& keyHashes);
+    // Candidate index for a key hash, or kNotFound; an absent key can still get a candidate
+    uint32_t find(uint64_t keyHash) const;
+    // Give key i the index newIndex[i] instead, without searching again (for a renumbered copy
+    // of the same keys)
+    template <class Index>
+    void renumber(const std::vector<Index>& newIndex) {
+        for (uint32_t& value : slotValues) {
+            if (value != kNotFound) {
+                value = static_cast<uint32_t>(newIndex[value]);
+            }
+        }
+    }
+
+    bool empty() const { return slotValues.empty(); }
+    size_t memoryBytes() const;
+    void clear();
+
+    // Stored after the graph arrays of a snapshot; loadFrom checks the shape against keys
+    void saveTo(std::ofstream& file) const;
+    bool loadFrom(std::ifstream& file, size_t keys);
+
+private:
+    uint64_t seed = 0;
+    std::vector<uint32_t> displacement; // per bucket
+    std::vector<uint8_t> fingerprints;  // per slot
+    std::vector<uint32_t> slotValues;   // per slot: the index given to build()
+
+    size_t bucketOf(uint64_t keyHash) const;
+    size_t slotOf(uint64_t keyHash, uint32_t shift) const;
+    bool place(const std::vector<uint64_t>& keyHashes);
+};
+
+#endif // PERFECT_HASH_H
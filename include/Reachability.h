@@ -0,0 +1,49 @@
+#ifndef REACHABILITY_H
+#define REACHABILITY_H
+
+#include "CsrGraph.h"
+
+// Strongly connected components of a CsrGraph plus a reachability summary over the
+// condensation DAG, so "is there any path from u to v?" is answered without a search.
+//
+// Components are numbered by iterative Tarjan, which emits them sinks first: every DAG
+// edge goes from a higher component number to a lower one. Small DAGs keep a full
+// transitive-closure bitset (exact O(1) answers); large ones keep two interval labels
+// per component (GRAIL-style), which reject most unreachable pairs in O(1) and guide a
+// pruned DFS for the rest.
+class ReachabilityIndex {
+public:
+    typedef CsrGraph::VertexId VertexId;
+    // Components up to this count get a closure bitset (count^2 / 8 bytes)
+    static const size_t kClosureLimit = 8192;
+
+    explicit ReachabilityIndex(const CsrGraph& graph);
+
+    size_t componentCount() const { return dagOffsets.size() - 1; }
+    uint32_t componentOf(VertexId v) const { return component[v]; }
+
+    // Exact answer: is there a (possibly empty) path from u to v? O(1) when usesClosure();
+    // otherwise only pairs the intervals reject are O(1), and the rest pay a pruned DFS
+    bool canReach(VertexId from, VertexId to) const;
+    bool componentReaches(uint32_t from, uint32_t to) const;
+    // O(1) filter with no false negatives: false means component `from` surely cannot reach `to`
+    bool mayReachComponent(uint32_t from, uint32_t to) const;
+
+    bool usesClosure() const { return !closure.empty(); }
+    size_t memoryBytes() const;
+
+private:
+    std::vector<uint32_t> component;  // vertex -> component
+    std::vector<uint32_t> dagOffsets; // C + 1, into dagTargets
+    std::vector<uint32_t> dagTargets; // deduplicated condensation edges
+    std::vector<uint64_t> closure;    // C rows of ceil(C / 64) words, or empty
+    size_t closureWords;
+    // Two interval labels: reach(u, v) implies low[v] >= low[u] && post[v] <= post[u]
+    std::vector<uint32_t> low[2];
+    std::vector<uint32_t> post[2];
+
+    void buildIntervals(int labelSet, bool reverseChildren);
+    bool intervalsContain(uint32_t from, uint32_t to) const;
+};
+
+#endif // REACHABILITY_H
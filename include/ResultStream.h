@@ -0,0 +1,90 @@
+#ifndef RESULT_STREAM_H
+#define RESULT_STREAM_H
+
+#include "CsrGraph.h"
+#include "PathCost.h"
+#include "GraphStats.h"
+#include <queue>
+#include <random>
+#include <unordered_set>
+
+struct NegativeLogProbabilityCost;
+
+// Generator-style view of a single-source shortest-path search: every next() runs Dijkstra
+// just far enough to settle one more word and yields it, nearest first (ties by ID, as in
+// buildShortestPathTree). The first result is ready after one settle instead of after the
+// whole tree, a caller can stop at any point, and nothing per destination is kept beyond the
+// search state itself. Words are references into the CSR view and paths are IDs in a buffer
+// the stream reuses, so streaming every destination copies no strings.
+class ShortestPathStream {
+public:
+    typedef CsrGraph::VertexId VertexId;
+
+    // A stream that yields nothing (e.g. for a word that is not in the graph)
+    ShortestPathStream();
+    // logProbability supplies the edge costs for PathCost::NegativeLogProbability and is
+    // ignored otherwise; the stream holds both views, so later graph changes do not affect it
+    ShortestPathStream(std::shared_ptr<const CsrGraph> graph, VertexId source, PathCost cost,
+        std::shared_ptr<const NegativeLogProbabilityCost> logProbability = std::shared_ptr<const NegativeLogProbabilityCost>());
+
+    // Settle the next-closest word other than the source; false once none is reachable
+    bool next();
+    VertexId target() const { return current; }
+    double distance() const { return distances[current]; }
+    const std::string& word() const { return graph->name(current); }
+    // IDs from the source to target(); valid until the next call
+    const std::vector<VertexId>& pathIds();
+    const CsrGraph& view() const { return *graph; }
+    // Words settled so far, the source included, for progress reporting
+    uint64_t settledCount() const { return settledSoFar; }
+
+private:
+    typedef std::pair<double, VertexId> QueueEntry;
+
+    std::shared_ptr<const CsrGraph> graph;
+    std::shared_ptr<const NegativeLogProbabilityCost> logProbability;
+    PathCost cost;
+    VertexId source;
+    VertexId current;
+    std::vector<double> distances;
+    std::vector<VertexId> parents;
+    std::vector<bool> settled;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    std::vector<VertexId> path;
+    uint64_t settledSoFar;
+
+    bool settleNext();
+    template <class Cost>
+    void relax(VertexId from, const Cost& edgeCost);
+};
+
+// Random walk (see Graph::randomWalk) produced one step at a time: a uniformly drawn start
+// word, then uniformly drawn out-edges until a word has none or an edge repeats
+class RandomWalkStream {
+public:
+    typedef CsrGraph::VertexId VertexId;
+
+    // counters, when given, get the walk's call and step counts once it ends (the next() that
+    // returns false) and must outlive the stream; walks abandoned earlier are not counted
+    RandomWalkStream(std::shared_ptr<const CsrGraph> graph, uint32_t seed, QueryCounters* counters = nullptr);
+
+    // Take the next step (the first call yields the start word); false when the walk is over
+    bool next();
+    VertexId vertex() const { return current; }
+    const std::string& word() const { return graph->name(current); }
+    // Steps yielded so far, the start word included
+    uint64_t length() const { return steps; }
+
+private:
+    std::shared_ptr<const CsrGraph> graph;
+    std::mt19937 rng;
+    std::unordered_set<uint32_t> visitedEdges; // CSR edge indices
+    QueryCounters* counters;
+    VertexId current;
+    uint64_t steps;
+    bool finished;
+
+    bool finish();
+};
+
+#endif // RESULT_STREAM_H
@@ -0,0 +1,82 @@
+#ifndef SKETCH_BUILDER_H
+#define SKETCH_BUILDER_H
+
+#include "Graph.h"
+#include <cstdint>
+#include <unordered_map>
+
+struct SketchBuildOptions {
+    size_t sketchWidth = static_cast<size_t>(1) << 20; // Count-Min counters per row
+    size_t sketchDepth = 4;                             // Count-Min rows, independent hashes (at most 16)
+    size_t heavyHitters = static_cast<size_t>(1) << 16; // bigrams tracked with their words
+    uint64_t minWeight = 2; // materialize tracked bigrams estimated at least this often
+    size_t topK = 0;        // if > 0, keep only the K heaviest of those
+    size_t readChunkBytes = static_cast<size_t>(1) << 20;
+};
+
+struct SketchBuildReport {
+    uint64_t tokens = 0;
+    uint64_t pairs = 0;        // bigrams seen
+    uint64_t tracked = 0;      // bigrams in the heavy-hitter list at the end
+    uint64_t edges = 0;        // bigrams materialized into the graph
+    uint64_t vertices = 0;
+    size_t memoryBytes = 0;    // sketch + heavy-hitter list, fixed by the options
+    // Count-Min guarantee: every weight overestimates its bigram's count by at most
+    // errorBound (= e / width * pairs) with probability confidence (= 1 - e^-depth)
+    double errorBound = 0.0;
+    double confidence = 0.0;
+    // No bigram left out of the list occurred more often than this; with minWeight
+    // above it, every bigram that truly reached minWeight is in the graph
+    uint64_t trackedFloor = 0;
+};
+
+// Approximate graph build in fixed memory for corpora where rare bigrams do not matter.
+// Every bigram is counted in a Count-Min sketch (conservative update) keyed by a hash of
+// the two words, so no vocabulary is kept. A Space-Saving list of heavyHitters entries
+// remembers the words of the most frequent bigrams: a bigram enters once its estimate
+// beats the smallest tracked one, which it then replaces. finishInto adds the tracked
+// bigrams that pass minWeight / topK to a Graph, weighted by their estimates.
+class SketchGraphBuilder {
+public:
+    explicit SketchGraphBuilder(const SketchBuildOptions& options = SketchBuildOptions());
+
+    // Stream one text file; bigrams never span two files
+    bool addFile(const std::string& filePath);
+    // Feed already normalized words one at a time; endDocument() breaks the chain
+    void addWord(const char* word, size_t length);
+    void endDocument() { havePrevious = false; }
+
+    // Count-Min estimate of how often dest followed src
+    uint64_t estimate(const std::string& src, const std::string& dest) const;
+    void finishInto(Graph& graph);
+
+    const SketchBuildReport& report() const { return buildReport; }
+
+private:
+    struct Tracked {
+        uint64_t key;
+        uint64_t count;
+        std::string src;
+        std::string dest;
+    };
+
+    SketchBuildOptions options;
+    SketchBuildReport buildReport;
+    std::vector<uint32_t> counters;                // depth rows of width counters
+    std::vector<Tracked> tracked;
+    std::vector<uint32_t> heap;                    // indices into tracked, min-heap on count
+    std::vector<uint32_t> heapPos;                 // tracked index -> position in heap
+    std::unordered_map<uint64_t, uint32_t> byKey;  // bigram hash -> tracked index
+    std::string previousWord;
+    uint64_t previousHash = 0;
+    bool havePrevious = false;
+
+    uint64_t pairKey(uint64_t srcHash, uint64_t destHash) const;
+    uint64_t update(uint64_t key);
+    uint64_t lookup(uint64_t key) const;
+    void track(uint64_t key, uint64_t count, const char* dest, size_t length);
+    void siftDown(size_t pos);
+    void swapHeap(size_t a, size_t b);
+};
+
+#endif // SKETCH_BUILDER_H
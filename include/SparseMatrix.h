@@ -0,0 +1,126 @@
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include "CsrGraph.h"
+#include "Jobs.h"
+
+// Instruction sets for the vector kernels below (row gathers, L1 distance, sums), chosen like
+// the tokenizer's (see Tokenizer.h): the best one this CPU supports, detected once at runtime.
+// The backends add in different orders, so they agree up to rounding and not bit for bit. Any
+// one backend is still deterministic and gives the same result for every thread count
+enum class VectorBackend {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+VectorBackend vectorBackend();
+const char* vectorBackendName(VectorBackend backend);
+bool vectorBackendSupported(VectorBackend backend);
+
+// Weighted adjacency of a CSR view as a sparse matrix A, A[u][v] = weight of u -> v, kept
+// together with its transpose so that both y = A x and y = A^T x are row-wise gathers:
+// every output element is summed by one worker in a fixed order, so products are race-free
+// and bit-identical for any thread count. Built once per graph version (Graph caches it)
+// and shared by every ranking below.
+class SparseMatrix {
+public:
+    explicit SparseMatrix(const CsrGraph& graph);
+
+    size_t size() const { return outWeights.size(); }
+    size_t memoryBytes() const;
+    // Sum of the weights leaving u; 0 marks a dangling vertex
+    double outWeight(uint32_t u) const { return outWeights[u]; }
+    // Largest weighted in-degree, an upper bound on the spectral radius of A
+    double maxInWeight() const { return largestInWeight; }
+
+    // y = A x, i.e. y[u] = sum over edges u -> v of weight * x[v]
+    void multiply(const std::vector<double>& x, std::vector<double>& y, unsigned threads = 1,
+        VectorBackend backend = vectorBackend()) const;
+    // y = A^T x, i.e. y[v] = sum over edges u -> v of weight * x[u]
+    void multiplyTranspose(const std::vector<double>& x, std::vector<double>& y, unsigned threads = 1,
+        VectorBackend backend = vectorBackend()) const;
+
+private:
+    struct Rows {
+        std::vector<uint32_t> offsets; // V + 1
+        std::vector<uint32_t> columns;
+        std::vector<double> values;
+    };
+    Rows forward;    // rows are sources
+    Rows transposed; // rows are targets, columns sources in ascending ID order
+    std::vector<double> outWeights;
+    double largestInWeight;
+
+    static void gather(const Rows& rows, const std::vector<double>& x, std::vector<double>& y, unsigned threads,
+        VectorBackend backend);
+};
+
+struct IterationOptions {
+    int maxIterations = 100;
+    double tolerance = 0.0; // stop once the L1 change of an iteration drops below it (0 = never)
+    unsigned threads = 1;   // workers for the matrix products (0 = all cores)
+};
+
+struct IterationResult {
+    std::vector<double> values; // empty when a JobControl stopped the run
+    int iterations = 0;
+    double residual = 0.0;      // L1 change of the last iteration
+    bool converged = false;     // the tolerance was met before maxIterations
+};
+
+// L1 distance and in-place scaling of dense vectors, the per-iteration vector work
+double l1Distance(const std::vector<double>& a, const std::vector<double>& b);
+double l1Distance(const std::vector<double>& a, const std::vector<double>& b, VectorBackend backend);
+void scaleToSum(std::vector<double>& x, double sum);
+void scaleToSum(std::vector<double>& x, double sum, VectorBackend backend);
+
+// Power-iteration driver shared by the rankings: step(x, next) writes the next iterate from
+// the current one, and the driver swaps them, tracks the residual, applies the tolerance and
+// polls control once per iteration (progress is iterations out of maxIterations)
+template <class Step>
+IterationResult iterate(std::vector<double> x, const IterationOptions& options, JobControl* control, Step step) {
+    IterationResult result;
+    std::vector<double> next(x.size());
+    for (int i = 0; i < options.maxIterations; ++i) {
+        if (control != nullptr) {
+            control->reportProgress(static_cast<uint64_t>(i), static_cast<uint64_t>(options.maxIterations));
+            if (control->shouldStop()) {
+                return result;
+            }
+        }
+        step(static_cast<const std::vector<double>&>(x), next);
+        result.residual = l1Distance(x, next);
+        x.swap(next);
+        result.iterations = i + 1;
+        if (result.residual < options.tolerance) {
+            result.converged = true;
+            break;
+        }
+    }
+    if (control != nullptr) {
+        control->reportProgress(static_cast<uint64_t>(options.maxIterations), static_cast<uint64_t>(options.maxIterations));
+    }
+    result.values.swap(x);
+    return result;
+}
+
+// PageRank from the given start vector with dangling rank spread evenly over all vertices,
+// the model Graph::calculatePageRank has always used: d A_norm^T x + (1 - d + d dangling) / V
+IterationResult pageRankScores(const SparseMatrix& matrix, double dampingFactor, std::vector<double> start,
+    const IterationOptions& options = IterationOptions(), JobControl* control = nullptr);
+
+struct HitsResult {
+    IterationResult authorities; // principal eigenvector of A^T A, summing to 1
+    std::vector<double> hubs;    // A times the authorities, summing to 1
+};
+// Kleinberg's HITS on the weighted adjacency; words with no edges score 0
+HitsResult hitsScores(const SparseMatrix& matrix, const IterationOptions& options = IterationOptions(),
+    JobControl* control = nullptr);
+
+// Katz centrality x = alpha A^T x + beta, i.e. beta times the attenuated count of weighted
+// walks ending at each word. alpha 0 picks 0.5 / maxInWeight(), which always converges
+IterationResult katzScores(const SparseMatrix& matrix, double alpha = 0.0, double beta = 1.0,
+    const IterationOptions& options = IterationOptions(), JobControl* control = nullptr);
+
+#endif // SPARSE_MATRIX_H
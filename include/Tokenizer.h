@@ -0,0 +1,57 @@
+#ifndef TOKENIZER_H
+#define TOKENIZER_H
+
+#include <cstddef>
+#include <cstring>
+
+// Byte classes used by both the scalar and SIMD tokenizers.
+// They reproduce std::isalpha / std::ispunct / std::isspace in the default "C" locale:
+// separators split words, alpha bytes are kept (lowercased), everything else
+// (digits, control bytes, non-ASCII) stays inside the word but is dropped.
+enum CharClass : unsigned char {
+    CHAR_OTHER = 0,
+    CHAR_ALPHA = 1,
+    CHAR_SEPARATOR = 2
+};
+
+enum class TokenizerBackend {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+// Class of a single byte (table lookup, no locale involved)
+CharClass classifyChar(char c);
+
+// Fastest backend supported by this CPU, detected once at runtime
+TokenizerBackend tokenizerBackend();
+const char* tokenizerBackendName(TokenizerBackend backend);
+bool tokenizerBackendSupported(TokenizerBackend backend);
+
+// Rewrite text in place into its normalized words separated by single spaces,
+// in one pass. Returns the new length; wordCount (optional) receives the number of words.
+size_t normalizeTextInPlace(char* data, size_t size, size_t* wordCount = nullptr);
+size_t normalizeTextInPlace(char* data, size_t size, size_t* wordCount, TokenizerBackend backend);
+
+// Walks the words of a buffer produced by normalizeTextInPlace without copying them
+class WordCursor {
+    const char* pos;
+    const char* end;
+
+public:
+    WordCursor(const char* data, size_t size) : pos(data), end(data + size) {}
+
+    bool next(const char*& word, size_t& length) {
+        if (pos >= end) {
+            return false;
+        }
+        const char* space = static_cast<const char*>(std::memchr(pos, ' ', static_cast<size_t>(end - pos)));
+        const char* wordEnd = space ? space : end;
+        word = pos;
+        length = static_cast<size_t>(wordEnd - pos);
+        pos = wordEnd + 1;
+        return true;
+    }
+};
+
+#endif // TOKENIZER_H
@@ -2,7 +2,12 @@
 #define TOOLS_H
 
 #include "Graph.h"
+#include "Tokenizer.h"
+
 std::string normalizeWord(const std::string& word);
 void displayShortestPath(const std::pair<double, std::vector<std::string>>& pathInfo);
+void displayGraphStats(const GraphStats& stats);
+void displayQueryStats(const QueryStats& queries);
+bool collectInputFiles(const std::string& path, std::vector<std::string>& files);
 
 #endif // TOOLS_H
\ No newline at end of file
@@ -0,0 +1,43 @@
+#ifndef TWO_HOP_H
+#define TWO_HOP_H
+
+#include "CsrGraph.h"
+
+// Output limits for the two-hop product; the defaults keep every non-zero entry
+struct TwoHopOptions {
+    size_t topK = 0;            // keep only the k strongest entries per row (0 = all)
+    uint32_t minBridges = 1;    // drop pairs joined by fewer bridge words
+    uint64_t minWeight = 0;     // drop pairs whose bridge strength is lower
+    unsigned threads = 0;       // worker threads (0 = all cores)
+    bool skipSelfPairs = false; // drop (a, a) entries
+};
+
+// Bridge statistics of one word pair (a, c): how many words b have a -> b -> c,
+// and the sum of w(a, b) * w(b, c) over those bridges
+struct TwoHopEntry {
+    CsrGraph::VertexId target;
+    uint32_t bridges;
+    uint64_t weight;
+};
+
+// Sparse A * A over the weighted adjacency matrix, computed row by row with Gustavson's
+// algorithm and a dense per-thread accumulator. Row a lists every c reachable in exactly
+// two hops, sorted by target ID, so it answers findBridgeWords-style questions for all
+// pairs at once.
+class TwoHopMatrix {
+public:
+    explicit TwoHopMatrix(const CsrGraph& graph, const TwoHopOptions& options = TwoHopOptions());
+
+    size_t rowCount() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    size_t nonZeroCount() const { return entries.size(); }
+    const TwoHopEntry* rowBegin(CsrGraph::VertexId row) const { return entries.data() + offsets[row]; }
+    const TwoHopEntry* rowEnd(CsrGraph::VertexId row) const { return entries.data() + offsets[row + 1]; }
+    // Entry for (from, to); false when the pair has no bridge or was filtered out
+    bool find(CsrGraph::VertexId from, CsrGraph::VertexId to, TwoHopEntry& entry) const;
+
+private:
+    std::vector<uint64_t> offsets; // V + 1
+    std::vector<TwoHopEntry> entries;
+};
+
+#endif // TWO_HOP_H
@@ -0,0 +1,20 @@
+#ifndef VERTEX_ORDER_H
+#define VERTEX_ORDER_H
+
+#include <string>
+
+// How the frozen ID-based views number their vertices. Lexicographic keeps IDs equal to the
+// words' sorted ranks; the others relabel so that vertices visited together sit close
+// together in the CSR arrays and the per-vertex vectors of PageRank and Dijkstra.
+enum class VertexOrder {
+    Lexicographic,
+    ReverseCuthillMcKee, // BFS by increasing degree from a peripheral vertex, reversed
+    Degree,              // most connected first, so hubs share cache lines
+    BreadthFirst         // BFS from the most connected vertex of each component
+};
+
+const char* vertexOrderName(VertexOrder order);
+// Accepts "lex", "rcm", "degree" and "bfs"; returns false for anything else
+bool parseVertexOrder(const std::string& text, VertexOrder& order);
+
+#endif // VERTEX_ORDER_H
@@ -0,0 +1,80 @@
+#ifndef WINDOWED_GRAPH_H
+#define WINDOWED_GRAPH_H
+
+#include "Graph.h"
+#include <deque>
+#include <unordered_map>
+
+struct WindowOptions {
+    uint32_t windowEpochs = 60;       // edges not seen for this many epochs expire
+    uint64_t tokensPerEpoch = 10000;  // the epoch advances every N tokens (0 = only advanceEpoch())
+    double decayPerEpoch = 1.0;       // weight multiplier per elapsed epoch (1 = no decay: a weight
+                                      // then counts every occurrence since the edge last became live)
+};
+
+// Word graph over a continuous feed, bounded by a sliding window of epochs.
+// Each edge remembers the epoch it was last reinforced in; its weight decays by
+// decayPerEpoch for every epoch since, and it expires once windowEpochs have passed.
+// Expired edges and words left without edges are reclaimed a few at a time on every
+// insertion, so each token costs amortized O(1) and memory follows the window, not the
+// feed. Queries never see expired edges, reclaimed or not.
+class WindowedGraph {
+public:
+    explicit WindowedGraph(const WindowOptions& options = WindowOptions());
+
+    // Feed normalized text; consecutive words are linked across calls until endDocument()
+    void addText(const std::string& text);
+    void addToken(const std::string& word);
+    void endDocument();
+    void addEdge(const std::string& src, const std::string& dest, double weight = 1.0);
+    // Move time forward by one epoch (for time-based epochs driven by the caller)
+    void advanceEpoch();
+    // Reclaim every expired edge and orphaned word now instead of incrementally
+    void reclaimExpired();
+
+    uint64_t currentEpoch() const { return epoch; }
+    // Decayed weight of src -> dest as of the current epoch, 0 if absent or expired
+    double edgeWeight(const std::string& src, const std::string& dest) const;
+    // Stored words and edges, including expired ones that are not reclaimed yet
+    size_t vertexCount() const { return vertexIds.size(); }
+    size_t edgeCount() const { return edges.size(); }
+    // Current window as a regular Graph for the full query API; weights are rounded
+    // to integers, and an edge that is live but decayed below 0.5 keeps weight 1
+    Graph snapshot() const;
+
+private:
+    struct Vertex {
+        std::string name;
+        uint32_t liveEdges = 0; // edges touching this word (a self-loop counts twice)
+    };
+    struct EdgeSlot {
+        double weight;  // as of lastEpoch
+        uint64_t lastEpoch;
+    };
+
+    WindowOptions options;
+    uint64_t epoch = 0;
+    uint64_t tokensInEpoch = 0;
+    std::vector<double> decayFactor; // decayPerEpoch^age for age < windowEpochs
+
+    std::unordered_map<std::string, uint32_t> vertexIds;
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> freeIds;
+    std::unordered_map<uint64_t, EdgeSlot> edges; // key: src id << 32 | dest id
+
+    // buckets[i] lists the edges reinforced in epoch firstBucketEpoch + i (once per epoch)
+    std::deque<std::vector<uint64_t>> buckets;
+    uint64_t firstBucketEpoch = 0;
+    size_t sweepCursor = 0;
+
+    std::string previousWord;
+    bool havePrevious = false;
+
+    bool isLive(const EdgeSlot& slot) const { return epoch - slot.lastEpoch < options.windowEpochs; }
+    double decayed(const EdgeSlot& slot) const { return slot.weight * decayFactor[epoch - slot.lastEpoch]; }
+    uint32_t intern(const std::string& word);
+    void release(uint32_t id);
+    void sweep(size_t budget);
+};
+
+#endif // WINDOWED_GRAPH_H
@@ -0,0 +1,56 @@
+#ifndef WORD_STREAM_H
+#define WORD_STREAM_H
+
+#include "Tokenizer.h"
+#include <fstream>
+#include <string>
+
+// Read a text file in fixed-size chunks and hand every normalized word to
+// onWord(const char* word, size_t length), which returns false to stop early.
+// Only the text up to the last separator of a chunk is tokenized; the partial word
+// moves to the front of the next one, so memory stays at about one chunk.
+// Returns false when onWord stopped the stream.
+template <class WordSink>
+bool streamWords(std::ifstream& file, size_t chunkBytes, WordSink& onWord) {
+    std::string buffer;
+    size_t carry = 0;
+    while (true) {
+        if (buffer.size() < carry + chunkBytes) {
+            buffer.resize(carry + chunkBytes);
+        }
+        file.read(&buffer[carry], static_cast<std::streamsize>(chunkBytes));
+        size_t filled = carry + static_cast<size_t>(file.gcount());
+        bool endOfFile = !file;
+
+        size_t cut = filled;
+        if (!endOfFile) {
+            while (cut > 0 && classifyChar(buffer[cut - 1]) != CHAR_SEPARATOR) {
+                --cut;
+            }
+            if (cut == 0) {
+                carry = filled; // a single word longer than the chunk: read more
+                continue;
+            }
+        }
+
+        size_t normalizedLength = normalizeTextInPlace(&buffer[0], cut);
+        WordCursor cursor(buffer.data(), normalizedLength);
+        const char* word = nullptr;
+        size_t length = 0;
+        while (cursor.next(word, length)) {
+            if (!onWord(word, length)) {
+                return false;
+            }
+        }
+
+        carry = filled - cut;
+        if (carry > 0) {
+            std::memmove(&buffer[0], &buffer[cut], carry);
+        }
+        if (endOfFile) {
+            return true;
+        }
+    }
+}
+
+#endif // WORD_STREAM_H
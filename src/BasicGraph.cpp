@@ -0,0 +1,324 @@
+#include "../include/BasicGraph.h"
+#include <numeric>
+
+template <class VertexIdT, class WeightT>
+const VertexIdT BasicGraph<VertexIdT, WeightT>::kNoVertex;
+template <class VertexIdT, class WeightT>
+const typename BasicGraph<VertexIdT, WeightT>::Distance BasicGraph<VertexIdT, WeightT>::kInfinity;
+
+template <class VertexIdT, class WeightT>
+BasicGraph<VertexIdT, WeightT>::BasicGraph() : offsets(1, 0) {}
+
+template <class VertexIdT, class WeightT>
+BasicGraph<VertexIdT, WeightT>::BasicGraph(const Graph& graph) : offsets(1, 0) {
+    const std::map<std::string, std::vector<Graph::Edge>>& adjacency = graph.getAdjacencyList();
+    names.reserve(adjacency.size());
+    for (const auto& entry : adjacency) {
+        names.push_back(entry.first);
+    }
+    buildWordIndex();
+
+    offsets.reserve(adjacency.size() + 1);
+    targets.reserve(graph.edgeCount());
+    weights.reserve(graph.edgeCount());
+    std::vector<std::pair<VertexId, Weight>> row;
+    for (const auto& entry : adjacency) {
+        row.clear();
+        for (const Graph::Edge& edge : entry.second) {
+            VertexId dest = kNoVertex;
+            findVertex(edge.dest, dest);
+            row.emplace_back(dest, static_cast<Weight>(edge.weight));
+        }
+        std::sort(row.begin(), row.end());
+        for (const auto& cell : row) {
+            targets.push_back(cell.first);
+            weights.push_back(cell.second);
+        }
+        offsets.push_back(static_cast<uint32_t>(targets.size()));
+    }
+}
+
+template <class VertexIdT, class WeightT>
+size_t BasicGraph<VertexIdT, WeightT>::memoryBytes() const {
+    size_t bytes = offsets.capacity() * sizeof(uint32_t) + targets.capacity() * sizeof(VertexId) +
+                   weights.capacity() * sizeof(Weight) + names.capacity() * sizeof(std::string) +
+                   byName.capacity() * sizeof(VertexId) + wordIndex.memoryBytes();
+    for (const std::string& word : names) {
+        bytes += word.capacity() + 1;
+    }
+    return bytes;
+}
+
+template <class VertexIdT, class WeightT>
+void BasicGraph<VertexIdT, WeightT>::buildWordIndex() {
+    std::vector<uint64_t> hashes(names.size());
+    for (size_t v = 0; v < names.size(); ++v) {
+        hashes[v] = PerfectHash::hashKey(names[v]);
+    }
+    wordIndex.build(hashes);
+}
+
+template <class VertexIdT, class WeightT>
+bool BasicGraph<VertexIdT, WeightT>::findVertex(const std::string& word, VertexId& id) const {
+    if (!wordIndex.empty()) {
+        uint32_t candidate = wordIndex.find(PerfectHash::hashKey(word));
+        if (candidate == PerfectHash::kNotFound || names[candidate] != word) {
+            return false;
+        }
+        id = static_cast<VertexId>(candidate);
+        return true;
+    }
+    if (byName.empty()) {
+        std::vector<std::string>::const_iterator it = std::lower_bound(names.begin(), names.end(), word);
+        if (it == names.end() || *it != word) {
+            return false;
+        }
+        id = static_cast<VertexId>(it - names.begin());
+        return true;
+    }
+    typename std::vector<VertexId>::const_iterator it = std::lower_bound(byName.begin(), byName.end(), word,
+        [this](VertexId candidate, const std::string& key) { return names[candidate] < key; });
+    if (it == byName.end() || names[*it] != word) {
+        return false;
+    }
+    id = *it;
+    return true;
+}
+
+template <class VertexIdT, class WeightT>
+BasicGraph<VertexIdT, WeightT> BasicGraph<VertexIdT, WeightT>::transpose() const {
+    BasicGraph result;
+    result.names = names;
+    result.byName = byName;
+    result.wordIndex = wordIndex;
+    result.offsets.assign(vertexCount() + 1, 0);
+    for (VertexId target : targets) {
+        result.offsets[target + 1]++;
+    }
+    for (size_t v = 0; v < vertexCount(); ++v) {
+        result.offsets[v + 1] += result.offsets[v];
+    }
+
+    // Sources are visited in increasing order, so every reversed row stays sorted
+    result.targets.resize(edgeCount());
+    result.weights.resize(edgeCount());
+    std::vector<uint32_t> cursor(result.offsets.begin(), result.offsets.end() - 1);
+    for (size_t src = 0; src < vertexCount(); ++src) {
+        for (uint32_t e = offsets[src]; e < offsets[src + 1]; ++e) {
+            uint32_t slot = cursor[targets[e]]++;
+            result.targets[slot] = static_cast<VertexId>(src);
+            result.weights[slot] = weights[e];
+        }
+    }
+    return result;
+}
+
+template <class VertexIdT, class WeightT>
+std::vector<VertexIdT> BasicGraph<VertexIdT, WeightT>::vertexOrder(VertexOrder order) const {
+    const size_t n = vertexCount();
+    std::vector<VertexId> result(n);
+    std::iota(result.begin(), result.end(), static_cast<VertexId>(0));
+    if (order == VertexOrder::Lexicographic) {
+        return result;
+    }
+
+    // Locality is about which vertices are touched together, whatever the edge direction,
+    // so degrees and BFS neighbourhoods count in-edges as well
+    BasicGraph incoming = transpose();
+    std::vector<uint32_t> degree(n);
+    for (size_t v = 0; v < n; ++v) {
+        degree[v] = outDegree(static_cast<VertexId>(v)) + incoming.outDegree(static_cast<VertexId>(v));
+    }
+    // RCM starts each component from a low-degree (peripheral) vertex, the others from a hub
+    const bool lowFirst = order == VertexOrder::ReverseCuthillMcKee;
+    std::stable_sort(result.begin(), result.end(), [&degree, lowFirst](VertexId a, VertexId b) {
+        return lowFirst ? degree[a] < degree[b] : degree[a] > degree[b];
+    });
+    if (order == VertexOrder::Degree) {
+        return result;
+    }
+
+    std::vector<VertexId> starts;
+    starts.swap(result);
+    result.reserve(n);
+    std::vector<bool> placed(n, false);
+    std::vector<VertexId> neighbours;
+    for (VertexId start : starts) {
+        if (placed[start]) {
+            continue;
+        }
+        // result doubles as the BFS queue
+        placed[start] = true;
+        result.push_back(start);
+        for (size_t head = result.size() - 1; head < result.size(); ++head) {
+            VertexId v = result[head];
+            neighbours.assign(targetsBegin(v), targetsEnd(v));
+            neighbours.insert(neighbours.end(), incoming.targetsBegin(v), incoming.targetsEnd(v));
+            if (lowFirst) {
+                std::sort(neighbours.begin(), neighbours.end(), [&degree](VertexId a, VertexId b) {
+                    return degree[a] != degree[b] ? degree[a] < degree[b] : a < b;
+                });
+            }
+            else {
+                std::sort(neighbours.begin(), neighbours.end());
+            }
+            for (VertexId next : neighbours) {
+                if (!placed[next]) {
+                    placed[next] = true;
+                    result.push_back(next);
+                }
+            }
+        }
+    }
+    if (lowFirst) {
+        std::reverse(result.begin(), result.end());
+    }
+    return result;
+}
+
+template <class VertexIdT, class WeightT>
+BasicGraph<VertexIdT, WeightT> BasicGraph<VertexIdT, WeightT>::permuted(const std::vector<VertexId>& order) const {
+    const size_t n = vertexCount();
+    std::vector<VertexId> newId(n);
+    for (size_t i = 0; i < n; ++i) {
+        newId[order[i]] = static_cast<VertexId>(i);
+    }
+
+    BasicGraph result;
+    result.names.reserve(n);
+    for (VertexId old : order) {
+        result.names.push_back(names[old]);
+    }
+    // Word order is unchanged, only the IDs it maps to; an identity permutation needs no index
+    result.byName.resize(n);
+    bool identity = true;
+    for (size_t rank = 0; rank < n; ++rank) {
+        result.byName[rank] = newId[byName.empty() ? static_cast<VertexId>(rank) : byName[rank]];
+        identity = identity && result.byName[rank] == rank;
+    }
+    if (identity) {
+        std::vector<VertexId>().swap(result.byName);
+    }
+    // Same words, so the hash only needs its stored IDs renumbered, not a new search
+    result.wordIndex = wordIndex;
+    result.wordIndex.renumber(newId);
+
+    result.offsets.reserve(n + 1);
+    result.targets.reserve(edgeCount());
+    result.weights.reserve(edgeCount());
+    std::vector<std::pair<VertexId, Weight>> row;
+    for (VertexId old : order) {
+        row.clear();
+        const Weight* weight = weightsBegin(old);
+        for (const VertexId* target = targetsBegin(old); target != targetsEnd(old); ++target, ++weight) {
+            row.emplace_back(newId[*target], *weight);
+        }
+        std::sort(row.begin(), row.end());
+        for (const auto& cell : row) {
+            result.targets.push_back(cell.first);
+            result.weights.push_back(cell.second);
+        }
+        result.offsets.push_back(static_cast<uint32_t>(result.targets.size()));
+    }
+    return result;
+}
+
+template <class VertexIdT, class WeightT>
+size_t BasicGraph<VertexIdT, WeightT>::bandwidth() const {
+    size_t widest = 0;
+    for (size_t v = 0; v < vertexCount(); ++v) {
+        for (uint32_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+            size_t target = targets[e];
+            widest = std::max(widest, target > v ? target - v : v - target);
+        }
+    }
+    return widest;
+}
+
+template <class VertexIdT, class WeightT>
+typename BasicGraph<VertexIdT, WeightT>::Distance
+BasicGraph<VertexIdT, WeightT>::shortestPath(VertexId source, VertexId target, std::vector<VertexId>& path) const {
+    typedef std::pair<Distance, VertexId> QueueEntry;
+    path.clear();
+    std::vector<Distance> distance(vertexCount(), kInfinity);
+    std::vector<VertexId> parent(vertexCount(), kNoVertex);
+    std::vector<bool> settled(vertexCount(), false);
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+
+    distance[source] = 0;
+    queue.push(QueueEntry(0, source));
+    while (!queue.empty()) {
+        VertexId current = queue.top().second;
+        queue.pop();
+        if (settled[current]) {
+            continue;
+        }
+        settled[current] = true;
+        if (current == target) {
+            break;
+        }
+        const Weight* weight = weightsBegin(current);
+        for (const VertexId* next = targetsBegin(current); next != targetsEnd(current); ++next, ++weight) {
+            Distance alt = distance[current] + *weight;
+            if (!settled[*next] && alt < distance[*next]) {
+                distance[*next] = alt;
+                parent[*next] = current;
+                queue.push(QueueEntry(alt, *next));
+            }
+        }
+    }
+
+    if (distance[target] == kInfinity) {
+        return kInfinity;
+    }
+    for (VertexId v = target; v != source; v = parent[v]) {
+        path.push_back(v);
+    }
+    path.push_back(source);
+    std::reverse(path.begin(), path.end());
+    return distance[target];
+}
+
+template <class VertexIdT, class WeightT>
+std::vector<double> BasicGraph<VertexIdT, WeightT>::pageRank(double dampingFactor, int iterations) const {
+    const size_t n = vertexCount();
+    std::vector<double> rank(n, n == 0 ? 0.0 : 1.0 / static_cast<double>(n));
+    if (n == 0) {
+        return rank;
+    }
+    std::vector<double> next(n);
+    std::vector<double> totalWeight(n, 0.0);
+    for (size_t v = 0; v < n; ++v) {
+        for (uint32_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+            totalWeight[v] += weights[e];
+        }
+    }
+
+    double baseRank = (1.0 - dampingFactor) / static_cast<double>(n);
+    for (int i = 0; i < iterations; ++i) {
+        double danglingSum = 0.0;
+        for (size_t v = 0; v < n; ++v) {
+            if (offsets[v] == offsets[v + 1]) {
+                danglingSum += rank[v];
+            }
+        }
+        double danglingContribution = dampingFactor * danglingSum / static_cast<double>(n);
+        std::fill(next.begin(), next.end(), baseRank + danglingContribution);
+
+        for (size_t v = 0; v < n; ++v) {
+            for (uint32_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+                next[targets[e]] += dampingFactor * rank[v] * (weights[e] / totalWeight[v]);
+            }
+        }
+        rank.swap(next);
+    }
+    return rank;
+}
+
+// The supported family; CompactGraph::build chooses among these
+template class BasicGraph<uint16_t, uint8_t>;
+template class BasicGraph<uint16_t, uint16_t>;
+template class BasicGraph<uint16_t, uint32_t>;
+template class BasicGraph<uint32_t, uint8_t>;
+template class BasicGraph<uint32_t, uint16_t>;
+template class BasicGraph<uint32_t, uint32_t>;
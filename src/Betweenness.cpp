@@ -0,0 +1,127 @@
+#include "../include/Betweenness.h"
+#include "../include/Parallel.h"
+
+namespace {
+
+typedef CsrGraph::VertexId VertexId;
+typedef std::pair<double, VertexId> QueueEntry;
+
+// Per-worker state of single-source Brandes; only the vertices a source reached are
+// reset, so a source with a small reachable set costs little on a large graph
+struct BrandesWorkspace {
+    std::vector<double> distance;
+    std::vector<double> sigma; // number of shortest paths from the source
+    std::vector<double> delta; // dependency of the source on each vertex
+    std::vector<bool> settled;
+    std::vector<VertexId> order; // vertices in the order they were settled
+    std::vector<double> centrality;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+
+    explicit BrandesWorkspace(size_t n)
+        : distance(n, std::numeric_limits<double>::infinity()), sigma(n, 0.0), delta(n, 0.0),
+          settled(n, false), centrality(n, 0.0) {}
+
+    void accumulate(const CsrGraph& graph, VertexId source) {
+        // Dijkstra that also counts shortest paths; with positive weights every predecessor
+        // of w is settled before w, so sigma[w] is final when w is popped
+        distance[source] = 0.0;
+        sigma[source] = 1.0;
+        queue.push(QueueEntry(0.0, source));
+        while (!queue.empty()) {
+            VertexId v = queue.top().second;
+            queue.pop();
+            if (settled[v]) {
+                continue;
+            }
+            settled[v] = true;
+            order.push_back(v);
+            const uint32_t* weight = graph.weightsBegin(v);
+            for (const VertexId* w = graph.targetsBegin(v); w != graph.targetsEnd(v); ++w, ++weight) {
+                double alt = distance[v] + *weight;
+                if (alt < distance[*w]) {
+                    distance[*w] = alt;
+                    sigma[*w] = sigma[v];
+                    queue.push(QueueEntry(alt, *w));
+                }
+                else if (alt == distance[*w] && !settled[*w]) {
+                    sigma[*w] += sigma[v];
+                }
+            }
+        }
+
+        // Dependencies in reverse settle order. Instead of predecessor lists, v re-checks its
+        // out-edges: w is a shortest-path successor of v exactly when dist[w] = dist[v] + w(v, w)
+        for (size_t i = order.size(); i-- > 0;) {
+            VertexId v = order[i];
+            const uint32_t* weight = graph.weightsBegin(v);
+            for (const VertexId* w = graph.targetsBegin(v); w != graph.targetsEnd(v); ++w, ++weight) {
+                if (*w != v && distance[*w] == distance[v] + *weight) {
+                    delta[v] += sigma[v] / sigma[*w] * (1.0 + delta[*w]);
+                }
+            }
+            if (v != source) {
+                centrality[v] += delta[v];
+            }
+        }
+
+        for (VertexId v : order) {
+            distance[v] = std::numeric_limits<double>::infinity();
+            sigma[v] = 0.0;
+            delta[v] = 0.0;
+            settled[v] = false;
+        }
+        order.clear();
+    }
+};
+
+} // namespace
+
+std::vector<double> betweennessCentrality(const CsrGraph& graph, const BetweennessOptions& options) {
+    const size_t n = graph.vertexCount();
+    std::vector<double> result(n, 0.0);
+    if (n == 0) {
+        return result;
+    }
+
+    // Exact mode uses every vertex as a source; sampled mode a seeded random subset
+    std::vector<VertexId> sources(n);
+    for (size_t v = 0; v < n; ++v) {
+        sources[v] = static_cast<VertexId>(v);
+    }
+    double scale = 1.0;
+    if (options.samples > 0 && options.samples < n) {
+        std::mt19937 rng(options.seed);
+        for (size_t i = 0; i < options.samples; ++i) {
+            std::uniform_int_distribution<size_t> pick(i, n - 1);
+            std::swap(sources[i], sources[pick(rng)]);
+        }
+        sources.resize(options.samples);
+        scale = static_cast<double>(n) / static_cast<double>(options.samples);
+    }
+
+    const unsigned workers = workerCount(sources.size(), options.threads);
+    std::vector<std::unique_ptr<BrandesWorkspace>> workspaces(workers);
+    parallelForWorkers(sources.size(), workers, [&](size_t i, unsigned worker) {
+        if (!workspaces[worker]) {
+            workspaces[worker].reset(new BrandesWorkspace(n));
+        }
+        workspaces[worker]->accumulate(graph, sources[i]);
+    });
+
+    for (const std::unique_ptr<BrandesWorkspace>& workspace : workspaces) {
+        if (workspace) {
+            for (size_t v = 0; v < n; ++v) {
+                result[v] += workspace->centrality[v];
+            }
+        }
+    }
+    if (options.normalize && n > 2) {
+        scale /= static_cast<double>(n - 1) * static_cast<double>(n - 2);
+    }
+    if (scale != 1.0) {
+        for (double& value : result) {
+            value *= scale;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,92 @@
+#include "../include/CompactGraph.h"
+#include "../include/Tools.h"
+
+namespace {
+
+template <class T> struct TypeName;
+template <> struct TypeName<uint8_t> { static const char* get() { return "uint8_t"; } };
+template <> struct TypeName<uint16_t> { static const char* get() { return "uint16_t"; } };
+template <> struct TypeName<uint32_t> { static const char* get() { return "uint32_t"; } };
+
+// CompactGraph backed by one BasicGraph instantiation; every query runs on its narrow arrays
+template <class VertexIdT, class WeightT>
+class CompactGraphImpl : public CompactGraph {
+public:
+    typedef BasicGraph<VertexIdT, WeightT> Storage;
+
+    explicit CompactGraphImpl(const Graph& graph) : storage(graph) {
+        name = std::string("BasicGraph<") + TypeName<VertexIdT>::get() + ", " + TypeName<WeightT>::get() + ">";
+    }
+
+    const char* typeName() const override { return name.c_str(); }
+    size_t vertexIdBytes() const override { return sizeof(VertexIdT); }
+    size_t weightBytes() const override { return sizeof(WeightT); }
+    size_t vertexCount() const override { return storage.vertexCount(); }
+    size_t edgeCount() const override { return storage.edgeCount(); }
+    size_t memoryBytes() const override { return storage.memoryBytes(); }
+
+    bool containsWord(const std::string& word) const override {
+        VertexIdT id;
+        return storage.findVertex(normalizeWord(word), id);
+    }
+
+    std::pair<double, std::vector<std::string>> shortestPath(const std::string& start, const std::string& end) const override {
+        VertexIdT source, target;
+        if (!storage.findVertex(normalizeWord(start), source) || !storage.findVertex(normalizeWord(end), target)) {
+            return { -1, {} };
+        }
+        std::vector<VertexIdT> ids;
+        typename Storage::Distance distance = storage.shortestPath(source, target, ids);
+        if (distance == Storage::kInfinity) {
+            return { -1, {} };
+        }
+        std::vector<std::string> path;
+        path.reserve(ids.size());
+        for (VertexIdT id : ids) {
+            path.push_back(storage.name(id));
+        }
+        return { static_cast<double>(distance), path };
+    }
+
+    std::map<std::string, double> calculatePageRank(double dampingFactor, int iterations) const override {
+        std::vector<double> rank = storage.pageRank(dampingFactor, iterations);
+        std::map<std::string, double> result;
+        for (size_t v = 0; v < rank.size(); ++v) {
+            result.emplace_hint(result.end(), storage.name(static_cast<VertexIdT>(v)), rank[v]);
+        }
+        return result;
+    }
+
+private:
+    Storage storage;
+    std::string name;
+};
+
+template <class VertexIdT>
+std::unique_ptr<CompactGraph> buildWithIds(const Graph& graph, uint64_t maxWeight) {
+    if (BasicGraph<VertexIdT, uint8_t>::fits(graph.vertexCount(), maxWeight)) {
+        return std::unique_ptr<CompactGraph>(new CompactGraphImpl<VertexIdT, uint8_t>(graph));
+    }
+    if (BasicGraph<VertexIdT, uint16_t>::fits(graph.vertexCount(), maxWeight)) {
+        return std::unique_ptr<CompactGraph>(new CompactGraphImpl<VertexIdT, uint16_t>(graph));
+    }
+    return std::unique_ptr<CompactGraph>(new CompactGraphImpl<VertexIdT, uint32_t>(graph));
+}
+
+} // namespace
+
+std::unique_ptr<CompactGraph> CompactGraph::build(const Graph& graph) {
+    // Weights that are not positive (possible through addEdge) only fit the 32-bit form,
+    // the same reinterpretation CsrGraph has always applied
+    uint64_t maxWeight = 0;
+    for (const auto& entry : graph.getAdjacencyList()) {
+        for (const Graph::Edge& edge : entry.second) {
+            uint64_t weight = edge.weight > 0 ? static_cast<uint64_t>(edge.weight) : 0xFFFFFFFFull;
+            maxWeight = std::max(maxWeight, weight);
+        }
+    }
+    if (BasicGraph<uint16_t, uint32_t>::fits(graph.vertexCount(), 0)) {
+        return buildWithIds<uint16_t>(graph, maxWeight);
+    }
+    return buildWithIds<uint32_t>(graph, maxWeight);
+}
@@ -0,0 +1,608 @@
+#include "../include/CompressedGraph.h"
+#include "../include/Tools.h"
+#include "../include/BinaryIO.h"
+
+#include <cstring>
+
+// LEB128: 7 bits per byte, high bit set on every byte but the last
+static void appendVarint(std::vector<uint8_t>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+static void appendWeight(std::vector<uint8_t>& out, uint32_t weight, unsigned width) {
+    for (unsigned b = 0; b < width; ++b) {
+        out.push_back(static_cast<uint8_t>(weight >> (8 * b)));
+    }
+}
+
+static uint32_t readVarint(const uint8_t*& pos) {
+    uint32_t value = 0;
+    unsigned shift = 0;
+    uint8_t byte;
+    do {
+        byte = *pos++;
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+bool CompressedGraph::NeighborIterator::next(VertexId& dest, uint32_t& weight) {
+    if (remaining == 0) {
+        return false;
+    }
+    current += readVarint(pos);
+    dest = current;
+
+    switch (weightWidth) {
+    case 1:
+        weight = weights[0];
+        break;
+    case 2:
+        weight = static_cast<uint32_t>(weights[0]) | (static_cast<uint32_t>(weights[1]) << 8);
+        break;
+    default:
+        weight = static_cast<uint32_t>(weights[0]) | (static_cast<uint32_t>(weights[1]) << 8) |
+                 (static_cast<uint32_t>(weights[2]) << 16) | (static_cast<uint32_t>(weights[3]) << 24);
+        break;
+    }
+    weights += weightWidth;
+    remaining--;
+    return true;
+}
+
+CompressedGraph::CompressedGraph()
+    : weightBytesPerEdge(1), rng(static_cast<unsigned int>(time(nullptr))) {
+    nameOffsets.push_back(0);
+    neighborOffsets.push_back(0);
+    edgeIndex.push_back(0);
+}
+
+CompressedGraph::CompressedGraph(const Graph& graph) : CompressedGraph() {
+    const std::map<std::string, std::vector<Graph::Edge>>& adjacency = graph.getAdjacencyList();
+
+    // Vocabulary: map order is already lexicographic, so the position is the ID
+    int maxWeight = 0;
+    size_t totalNameBytes = 0;
+    for (const auto& entry : adjacency) {
+        totalNameBytes += entry.first.size();
+        for (const Graph::Edge& edge : entry.second) {
+            maxWeight = std::max(maxWeight, edge.weight);
+        }
+    }
+    weightBytesPerEdge = maxWeight <= 0xFF ? 1 : (maxWeight <= 0xFFFF ? 2 : 4);
+
+    namePool.reserve(totalNameBytes);
+    nameOffsets.reserve(adjacency.size() + 1);
+    for (const auto& entry : adjacency) {
+        namePool += entry.first;
+        nameOffsets.push_back(static_cast<uint32_t>(namePool.size()));
+    }
+    buildWordIndex();
+
+    neighborOffsets.reserve(adjacency.size() + 1);
+    edgeIndex.reserve(adjacency.size() + 1);
+    weightBytes.reserve(graph.edgeCount() * weightBytesPerEdge);
+    std::vector<std::pair<VertexId, uint32_t>> sorted;
+    for (const auto& entry : adjacency) {
+        sorted.clear();
+        for (const Graph::Edge& edge : entry.second) {
+            VertexId dest = 0;
+            findVertex(edge.dest, dest);
+            sorted.emplace_back(dest, static_cast<uint32_t>(edge.weight));
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        VertexId previous = 0;
+        for (const auto& neighbor : sorted) {
+            appendVarint(neighborBytes, neighbor.first - previous);
+            appendWeight(weightBytes, neighbor.second, weightBytesPerEdge);
+            previous = neighbor.first;
+        }
+        neighborOffsets.push_back(neighborBytes.size());
+        edgeIndex.push_back(edgeIndex.back() + static_cast<uint32_t>(sorted.size()));
+    }
+    neighborBytes.shrink_to_fit();
+}
+
+size_t CompressedGraph::memoryBytes() const {
+    return namePool.capacity() + nameOffsets.capacity() * sizeof(uint32_t) +
+           neighborOffsets.capacity() * sizeof(uint64_t) + edgeIndex.capacity() * sizeof(uint32_t) +
+           neighborBytes.capacity() + weightBytes.capacity() + wordIndex.memoryBytes();
+}
+
+// Perfect hash over the finished vocabulary; left empty (binary search) if it cannot be built
+void CompressedGraph::buildWordIndex() {
+    std::vector<uint64_t> hashes(vertexCount());
+    for (size_t v = 0; v < hashes.size(); ++v) {
+        hashes[v] = PerfectHash::hashKey(namePool.data() + nameOffsets[v], nameOffsets[v + 1] - nameOffsets[v]);
+    }
+    wordIndex.build(hashes);
+}
+
+int CompressedGraph::compareName(VertexId id, const std::string& word) const {
+    size_t begin = nameOffsets[id];
+    size_t length = nameOffsets[id + 1] - begin;
+    return namePool.compare(begin, length, word);
+}
+
+// Perfect-hash probe confirmed against the stored word; binary search when there is no index
+bool CompressedGraph::findVertex(const std::string& word, VertexId& id) const {
+    if (!wordIndex.empty()) {
+        uint32_t candidate = wordIndex.find(PerfectHash::hashKey(word));
+        if (candidate == PerfectHash::kNotFound || compareName(candidate, word) != 0) {
+            return false;
+        }
+        id = candidate;
+        return true;
+    }
+    size_t low = 0;
+    size_t high = vertexCount();
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        int cmp = compareName(static_cast<VertexId>(mid), word);
+        if (cmp == 0) {
+            id = static_cast<VertexId>(mid);
+            return true;
+        }
+        if (cmp < 0) {
+            low = mid + 1;
+        }
+        else {
+            high = mid;
+        }
+    }
+    return false;
+}
+
+std::string CompressedGraph::vertexName(VertexId id) const {
+    return namePool.substr(nameOffsets[id], nameOffsets[id + 1] - nameOffsets[id]);
+}
+
+bool CompressedGraph::containsWord(const std::string& word) const {
+    VertexId id;
+    return findVertex(normalizeWord(word), id);
+}
+
+CompressedGraph::NeighborIterator CompressedGraph::neighbors(VertexId id) const {
+    return NeighborIterator(neighborBytes.data() + neighborOffsets[id],
+                            weightBytes.data() + static_cast<size_t>(edgeIndex[id]) * weightBytesPerEdge,
+                            outDegree(id), weightBytesPerEdge);
+}
+
+// Dijkstra with a binary heap; ties pop the smaller ID first, which is the same
+// lexicographic tie-break as Graph::shortestPath, so both return identical paths
+std::pair<double, std::vector<std::string>> CompressedGraph::shortestPath(const std::string& start, const std::string& end) const {
+    VertexId source, target;
+    if (!findVertex(normalizeWord(start), source) || !findVertex(normalizeWord(end), target)) {
+        return { -1, {} };
+    }
+
+    const double infinity = std::numeric_limits<double>::infinity();
+    const VertexId none = std::numeric_limits<VertexId>::max();
+    std::vector<double> distance(vertexCount(), infinity);
+    std::vector<VertexId> previous(vertexCount(), none);
+    std::vector<bool> settled(vertexCount(), false);
+    typedef std::pair<double, VertexId> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+
+    distance[source] = 0;
+    queue.push(QueueEntry(0.0, source));
+    while (!queue.empty()) {
+        VertexId current = queue.top().second;
+        queue.pop();
+        if (settled[current]) {
+            continue;
+        }
+        settled[current] = true;
+        if (current == target) {
+            break;
+        }
+
+        NeighborIterator it = neighbors(current);
+        VertexId dest;
+        uint32_t weight;
+        while (it.next(dest, weight)) {
+            if (settled[dest]) {
+                continue;
+            }
+            double alt = distance[current] + weight;
+            if (alt < distance[dest]) {
+                distance[dest] = alt;
+                previous[dest] = current;
+                queue.push(QueueEntry(alt, dest));
+            }
+        }
+    }
+
+    if (distance[target] == infinity) {
+        return { -1, {} };
+    }
+    std::vector<std::string> path;
+    for (VertexId v = target; v != source; v = previous[v]) {
+        path.push_back(vertexName(v));
+    }
+    path.push_back(vertexName(source));
+    std::reverse(path.begin(), path.end());
+    return { distance[target], path };
+}
+
+// Same walk as Graph::randomWalk: uniform start vertex, uniform outgoing edge,
+// stop at a dead end or on the first repeated edge
+std::vector<std::string> CompressedGraph::randomWalk() {
+    if (vertexCount() == 0) {
+        return {};
+    }
+    std::vector<std::string> path;
+    std::set<std::pair<VertexId, VertexId>> visitedEdges;
+    std::uniform_int_distribution<size_t> dist(0, vertexCount() - 1);
+    VertexId current = static_cast<VertexId>(dist(rng));
+    path.push_back(vertexName(current));
+
+    while (outDegree(current) > 0) {
+        std::uniform_int_distribution<uint32_t> edgeDist(0, outDegree(current) - 1);
+        uint32_t pick = edgeDist(rng);
+        NeighborIterator it = neighbors(current);
+        VertexId dest = 0;
+        uint32_t weight;
+        for (uint32_t k = 0; k <= pick; ++k) {
+            it.next(dest, weight);
+        }
+        if (!visitedEdges.insert(std::make_pair(current, dest)).second) {
+            break;
+        }
+        current = dest;
+        path.push_back(vertexName(current));
+    }
+    return path;
+}
+
+// Uniform-start PageRank with the same dangling-node handling as Graph::calculatePageRank
+std::map<std::string, double> CompressedGraph::calculatePageRank(double dampingFactor, int iterations) const {
+    std::map<std::string, double> result;
+    size_t n = vertexCount();
+    if (n == 0) {
+        return result;
+    }
+
+    std::vector<double> rank(n, 1.0 / static_cast<double>(n));
+    std::vector<double> next(n);
+    std::vector<double> totalWeight(n, 0.0);
+    for (VertexId v = 0; v < n; ++v) {
+        NeighborIterator it = neighbors(v);
+        VertexId dest;
+        uint32_t weight;
+        while (it.next(dest, weight)) {
+            totalWeight[v] += weight;
+        }
+    }
+
+    double baseRank = (1.0 - dampingFactor) / static_cast<double>(n);
+    for (int i = 0; i < iterations; ++i) {
+        double danglingSum = 0.0;
+        for (VertexId v = 0; v < n; ++v) {
+            if (outDegree(v) == 0) {
+                danglingSum += rank[v];
+            }
+        }
+        double danglingContribution = dampingFactor * danglingSum / static_cast<double>(n);
+        std::fill(next.begin(), next.end(), baseRank + danglingContribution);
+
+        for (VertexId v = 0; v < n; ++v) {
+            NeighborIterator it = neighbors(v);
+            VertexId dest;
+            uint32_t weight;
+            while (it.next(dest, weight)) {
+                next[dest] += dampingFactor * rank[v] * (weight / totalWeight[v]);
+            }
+        }
+        rank.swap(next);
+    }
+
+    for (VertexId v = 0; v < n; ++v) {
+        result.emplace_hint(result.end(), vertexName(v), rank[v]);
+    }
+    return result;
+}
+
+static const char kSnapshotMagic[4] = { 'T', 'G', 'C', 'G' };
+// Version 2 appends the perfect-hash vocabulary index; version 1 files rebuild it on load
+static const uint32_t kSnapshotVersion = 2;
+
+bool CompressedGraph::saveToFile(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << filename << " for writing." << '\n';
+        return false;
+    }
+    uint32_t width = weightBytesPerEdge;
+    file.write(kSnapshotMagic, sizeof(kSnapshotMagic));
+    file.write(reinterpret_cast<const char*>(&kSnapshotVersion), sizeof(kSnapshotVersion));
+    file.write(reinterpret_cast<const char*>(&width), sizeof(width));
+    std::vector<char> names(namePool.begin(), namePool.end());
+    writeArray(file, names);
+    writeArray(file, nameOffsets);
+    writeArray(file, neighborOffsets);
+    writeArray(file, edgeIndex);
+    writeArray(file, neighborBytes);
+    writeArray(file, weightBytes);
+    wordIndex.saveTo(file);
+    return static_cast<bool>(file);
+}
+
+CompressedGraph::SnapshotWriter::SnapshotWriter(const std::string& snapshotPath, const std::vector<const std::string*>& words)
+    : path(snapshotPath), neighborPath(snapshotPath + ".neighbors.tmp"), weightPath(snapshotPath + ".weights.tmp"),
+      sortedWords(words), rankOf(words.size()), neighborBytesWritten(0), edgesWritten(0), previousDst(0), maxWeight(0),
+      ok(true) {
+    std::vector<size_t> order(words.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&words](size_t a, size_t b) { return *words[a] < *words[b]; });
+    for (size_t rank = 0; rank < order.size(); ++rank) {
+        sortedWords[rank] = words[order[rank]];
+        rankOf[order[rank]] = static_cast<VertexId>(rank);
+    }
+    neighborOffsets.reserve(words.size() + 1);
+    edgeIndex.reserve(words.size() + 1);
+    neighborOffsets.push_back(0);
+    edgeIndex.push_back(0);
+
+    neighborFile.open(neighborPath, std::ios::binary);
+    weightFile.open(weightPath, std::ios::binary);
+    if (!neighborFile.is_open() || !weightFile.is_open()) {
+        fail("Could not create temporary files next to " + path);
+    }
+}
+
+CompressedGraph::SnapshotWriter::~SnapshotWriter() {
+    neighborFile.close();
+    weightFile.close();
+    std::remove(neighborPath.c_str());
+    std::remove(weightPath.c_str());
+}
+
+bool CompressedGraph::SnapshotWriter::fail(const std::string& message) {
+    if (ok) {
+        std::cerr << "Error: " << message << '\n';
+    }
+    ok = false;
+    return false;
+}
+
+void CompressedGraph::SnapshotWriter::closeRowsBefore(size_t vertex) {
+    while (edgeIndex.size() < vertex + 1) {
+        neighborOffsets.push_back(neighborBytesWritten);
+        edgeIndex.push_back(edgesWritten);
+    }
+}
+
+bool CompressedGraph::SnapshotWriter::addEdge(VertexId src, VertexId dst, uint32_t weight) {
+    if (!ok) {
+        return false;
+    }
+    if (src >= vertexCount() || dst >= vertexCount() || edgeIndex.size() > static_cast<size_t>(src) + 1) {
+        return fail("snapshot edges out of order");
+    }
+    closeRowsBefore(src);
+    bool rowStarted = edgesWritten > edgeIndex.back();
+    if (rowStarted && dst <= previousDst) {
+        return fail("snapshot edges out of order");
+    }
+    if (edgesWritten == std::numeric_limits<uint32_t>::max()) {
+        return fail("too many edges for a snapshot");
+    }
+
+    uint8_t bytes[5];
+    uint8_t* pos = bytes;
+    uint32_t delta = dst - (rowStarted ? previousDst : 0);
+    while (delta >= 0x80) {
+        *pos++ = static_cast<uint8_t>(delta | 0x80);
+        delta >>= 7;
+    }
+    *pos++ = static_cast<uint8_t>(delta);
+    neighborFile.write(reinterpret_cast<const char*>(bytes), pos - bytes);
+    neighborBytesWritten += static_cast<uint64_t>(pos - bytes);
+
+    uint8_t weightBytes[4] = { static_cast<uint8_t>(weight), static_cast<uint8_t>(weight >> 8),
+                               static_cast<uint8_t>(weight >> 16), static_cast<uint8_t>(weight >> 24) };
+    weightFile.write(reinterpret_cast<const char*>(weightBytes), sizeof(weightBytes));
+    maxWeight = std::max(maxWeight, weight);
+    previousDst = dst;
+    edgesWritten++;
+    if (!neighborFile || !weightFile) {
+        return fail("Could not write temporary files next to " + path);
+    }
+    return true;
+}
+
+bool CompressedGraph::SnapshotWriter::finish() {
+    if (ok) {
+        closeRowsBefore(vertexCount());
+        neighborFile.close();
+        weightFile.close();
+        if (neighborFile.fail() || weightFile.fail()) {
+            fail("Could not write temporary files next to " + path);
+        }
+    }
+    bool written = ok && writeSnapshot();
+    neighborFile.close();
+    weightFile.close();
+    std::remove(neighborPath.c_str());
+    std::remove(weightPath.c_str());
+    return written;
+}
+
+// Same layout as saveToFile, section by section: names and their offsets from the word
+// order, the offset arrays, the two edge sections copied from the temporary files (weights
+// narrowed on the way) and the perfect hash over the names
+bool CompressedGraph::SnapshotWriter::writeSnapshot() {
+    uint64_t nameBytes = 0;
+    for (const std::string* word : sortedWords) {
+        nameBytes += word->size();
+    }
+    if (nameBytes > std::numeric_limits<uint32_t>::max()) {
+        return fail("vocabulary too large for a snapshot");
+    }
+    std::ofstream file(path, std::ios::binary);
+    std::ifstream neighbors(neighborPath, std::ios::binary);
+    std::ifstream weights(weightPath, std::ios::binary);
+    if (!file.is_open()) {
+        return fail("Could not open file " + path + " for writing.");
+    }
+    if (!neighbors.is_open() || !weights.is_open()) {
+        return fail("Could not reopen temporary files next to " + path);
+    }
+
+    uint32_t width = maxWeight <= 0xFF ? 1 : (maxWeight <= 0xFFFF ? 2 : 4);
+    file.write(kSnapshotMagic, sizeof(kSnapshotMagic));
+    file.write(reinterpret_cast<const char*>(&kSnapshotVersion), sizeof(kSnapshotVersion));
+    file.write(reinterpret_cast<const char*>(&width), sizeof(width));
+
+    file.write(reinterpret_cast<const char*>(&nameBytes), sizeof(nameBytes));
+    for (const std::string* word : sortedWords) {
+        file.write(word->data(), static_cast<std::streamsize>(word->size()));
+    }
+    uint64_t offsetCount = sortedWords.size() + 1;
+    uint32_t nameOffset = 0;
+    file.write(reinterpret_cast<const char*>(&offsetCount), sizeof(offsetCount));
+    file.write(reinterpret_cast<const char*>(&nameOffset), sizeof(nameOffset));
+    for (const std::string* word : sortedWords) {
+        nameOffset += static_cast<uint32_t>(word->size());
+        file.write(reinterpret_cast<const char*>(&nameOffset), sizeof(nameOffset));
+    }
+    writeArray(file, neighborOffsets);
+    writeArray(file, edgeIndex);
+
+    std::vector<char> buffer(static_cast<size_t>(1) << 16);
+    file.write(reinterpret_cast<const char*>(&neighborBytesWritten), sizeof(neighborBytesWritten));
+    while (neighbors.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || neighbors.gcount() > 0) {
+        file.write(buffer.data(), neighbors.gcount());
+    }
+    uint64_t weightByteCount = static_cast<uint64_t>(edgesWritten) * width;
+    file.write(reinterpret_cast<const char*>(&weightByteCount), sizeof(weightByteCount));
+    while (weights.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || weights.gcount() > 0) {
+        // Keep the low width bytes of each 4-byte little-endian weight, in place
+        size_t edges = static_cast<size_t>(weights.gcount()) / 4;
+        for (size_t k = 0; k < edges; ++k) {
+            std::memmove(buffer.data() + k * width, buffer.data() + k * 4, width);
+        }
+        file.write(buffer.data(), static_cast<std::streamsize>(edges * width));
+    }
+
+    std::vector<uint64_t> hashes(sortedWords.size());
+    for (size_t v = 0; v < hashes.size(); ++v) {
+        hashes[v] = PerfectHash::hashKey(*sortedWords[v]);
+    }
+    PerfectHash wordIndex;
+    wordIndex.build(hashes);
+    wordIndex.saveTo(file);
+    if (!file) {
+        return fail("Could not write file " + path);
+    }
+    return true;
+}
+
+template <class T>
+static bool isPrefixSum(const std::vector<T>& offsets, size_t total) {
+    if (offsets.empty() || offsets.front() != 0 || offsets.back() != total) {
+        return false;
+    }
+    for (size_t i = 1; i < offsets.size(); ++i) {
+        if (offsets[i] < offsets[i - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CompressedGraph::hasValidLayout() const {
+    const size_t vertices = vertexCount();
+    if (!isPrefixSum(nameOffsets, namePool.size()) || !isPrefixSum(neighborOffsets, neighborBytes.size()) ||
+        !isPrefixSum(edgeIndex, edgeIndex.back())) {
+        return false;
+    }
+    // Decode with bounds checks, so the unchecked readVarint never leaves a row
+    for (size_t v = 0; v < vertices; ++v) {
+        const uint8_t* pos = neighborBytes.data() + neighborOffsets[v];
+        const uint8_t* end = neighborBytes.data() + neighborOffsets[v + 1];
+        uint64_t current = 0;
+        for (uint32_t k = edgeIndex[v]; k < edgeIndex[v + 1]; ++k) {
+            uint64_t delta = 0;
+            unsigned shift = 0;
+            uint8_t byte = 0x80;
+            while (byte & 0x80) {
+                if (pos == end || shift > 28) {
+                    return false;
+                }
+                byte = *pos++;
+                delta |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                shift += 7;
+            }
+            current += delta;
+            if (current >= vertices) {
+                return false;
+            }
+        }
+        if (pos != end) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool CompressedGraph::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << filename << '\n';
+        return false;
+    }
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t width = 0;
+    file.read(magic, sizeof(magic));
+    file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    file.read(reinterpret_cast<char*>(&width), sizeof(width));
+    if (!file || std::memcmp(magic, kSnapshotMagic, sizeof(magic)) != 0 || (version != 1 && version != kSnapshotVersion) ||
+        (width != 1 && width != 2 && width != 4)) {
+        std::cerr << "Error: " << filename << " is not a compressed graph snapshot." << '\n';
+        return false;
+    }
+
+    CompressedGraph loaded;
+    std::vector<char> names;
+    bool intact = readArray(file, names) && readArray(file, loaded.nameOffsets) && readArray(file, loaded.neighborOffsets) &&
+        readArray(file, loaded.edgeIndex) && readArray(file, loaded.neighborBytes) && readArray(file, loaded.weightBytes) &&
+        !loaded.nameOffsets.empty() && loaded.nameOffsets.size() == loaded.neighborOffsets.size() &&
+        loaded.nameOffsets.size() == loaded.edgeIndex.size() &&
+        loaded.weightBytes.size() == static_cast<size_t>(loaded.edgeIndex.back()) * width &&
+        (version < 2 || loaded.wordIndex.loadFrom(file, loaded.nameOffsets.size() - 1));
+    if (intact) {
+        loaded.namePool.assign(names.begin(), names.end());
+        intact = loaded.hasValidLayout();
+    }
+    if (!intact) {
+        std::cerr << "Error: " << filename << " is truncated or corrupt." << '\n';
+        return false;
+    }
+    loaded.weightBytesPerEdge = width;
+
+    namePool.swap(loaded.namePool);
+    nameOffsets.swap(loaded.nameOffsets);
+    neighborOffsets.swap(loaded.neighborOffsets);
+    edgeIndex.swap(loaded.edgeIndex);
+    neighborBytes.swap(loaded.neighborBytes);
+    weightBytes.swap(loaded.weightBytes);
+    weightBytesPerEdge = width;
+    if (version >= 2) {
+        std::swap(wordIndex, loaded.wordIndex);
+    }
+    else {
+        buildWordIndex();
+    }
+    return true;
+}
@@ -0,0 +1,208 @@
+#include "../include/DeltaStepping.h"
+#include "../include/Jobs.h"
+#include "../include/Parallel.h"
+#include <atomic>
+
+namespace {
+
+typedef CsrGraph::VertexId VertexId;
+
+const uint64_t kUnreached = std::numeric_limits<uint64_t>::max();
+const uint64_t kNotQueued = std::numeric_limits<uint64_t>::max();
+// Frontier vertices per work item, and the smallest frontier worth waking the workers for
+const size_t kChunk = 256;
+const size_t kParallelFrontier = 4 * kChunk;
+
+// Lower target to value if that is an improvement; true when this call lowered it
+bool fetchMin(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value < current) {
+        if (target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+class DeltaStepper {
+public:
+    DeltaStepper(const CsrGraph& g, const DeltaSteppingOptions& options)
+        : graph(g), n(g.vertexCount()), delta(options.delta), workers(options.threads),
+          distance(n), queuedIn(n, kNotQueued), inBucket(n, false), relaxed(0) {
+        uint64_t totalWeight = 0;
+        uint32_t maxWeight = 1;
+        for (size_t v = 0; v < n; ++v) {
+            distance[v].store(kUnreached, std::memory_order_relaxed);
+            const uint32_t* weight = graph.weightsBegin(static_cast<VertexId>(v));
+            for (uint32_t e = 0; e < graph.outDegree(static_cast<VertexId>(v)); ++e) {
+                totalWeight += weight[e];
+                maxWeight = std::max(maxWeight, weight[e]);
+            }
+        }
+        if (delta == 0) {
+            delta = graph.edgeCount() == 0 ? 1 : static_cast<uint32_t>(totalWeight / graph.edgeCount());
+            delta = std::max<uint32_t>(delta, 1);
+        }
+        // A relaxation lands at most maxWeight past the current bucket, so this many
+        // slots reused in a circle never hold two different buckets at once
+        buckets.resize(maxWeight / delta + 2);
+        workerOutput.resize(workers.size());
+    }
+
+    bool run(VertexId source, JobControl* control, uint64_t& settledCount) {
+        distance[source].store(0, std::memory_order_relaxed);
+        enqueue(source);
+        std::vector<VertexId> frontier, settledHere;
+        settledCount = 0;
+        for (uint64_t current = 0; pending > 0; ++current) {
+            std::vector<VertexId>& slot = buckets[current % buckets.size()];
+            if (slot.empty()) {
+                continue;
+            }
+            // Light edges can refill the current bucket; repeat until it stays empty
+            while (!slot.empty()) {
+                frontier.swap(slot);
+                slot.clear();
+                pending -= frontier.size();
+                size_t kept = 0;
+                for (VertexId v : frontier) {
+                    queuedIn[v] = kNotQueued;
+                    if (distance[v].load(std::memory_order_relaxed) / delta != current) {
+                        continue; // moved to an earlier bucket after it was queued here
+                    }
+                    frontier[kept++] = v;
+                    if (!inBucket[v]) {
+                        inBucket[v] = true;
+                        settledHere.push_back(v);
+                    }
+                }
+                frontier.resize(kept);
+                relax(frontier, true);
+            }
+            relax(settledHere, false);
+
+            settledCount += settledHere.size();
+            for (VertexId v : settledHere) {
+                inBucket[v] = false;
+            }
+            settledHere.clear();
+            if (control != nullptr) {
+                control->reportProgress(settledCount, n);
+                if (control->shouldStop()) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    void fillTree(ShortestPathTree& tree) const {
+        tree.distance.resize(n);
+        for (size_t v = 0; v < n; ++v) {
+            uint64_t d = distance[v].load(std::memory_order_relaxed);
+            tree.distance[v] = d == kUnreached ? std::numeric_limits<double>::infinity() : static_cast<double>(d);
+        }
+        tree.relaxed = relaxed.load();
+
+        // Dijkstra keeps the first predecessor to reach the final distance, and it settles
+        // vertices by (distance, ID): among all tight in-edges, take the smallest such pair
+        std::vector<std::atomic<uint32_t>> parent(n);
+        for (size_t v = 0; v < n; ++v) {
+            parent[v].store(CsrGraph::kNoVertex, std::memory_order_relaxed);
+        }
+        const std::vector<double>& dist = tree.distance;
+        workers.forEach((n + kChunk - 1) / kChunk, n >= kParallelFrontier, [&](size_t chunk) {
+            size_t end = std::min(n, (chunk + 1) * kChunk);
+            for (size_t u = chunk * kChunk; u < end; ++u) {
+                if (dist[u] == std::numeric_limits<double>::infinity()) {
+                    continue;
+                }
+                const uint32_t* weight = graph.weightsBegin(static_cast<VertexId>(u));
+                for (const VertexId* v = graph.targetsBegin(static_cast<VertexId>(u)); v != graph.targetsEnd(static_cast<VertexId>(u)); ++v, ++weight) {
+                    if (*v == tree.source || dist[u] + *weight != dist[*v]) {
+                        continue;
+                    }
+                    uint32_t current = parent[*v].load(std::memory_order_relaxed);
+                    while (current == CsrGraph::kNoVertex || dist[u] < dist[current] || (dist[u] == dist[current] && u < current)) {
+                        if (parent[*v].compare_exchange_weak(current, static_cast<uint32_t>(u), std::memory_order_relaxed)) {
+                            break;
+                        }
+                    }
+                }
+            }
+        });
+        tree.parent.resize(n);
+        for (size_t v = 0; v < n; ++v) {
+            tree.parent[v] = parent[v].load(std::memory_order_relaxed);
+        }
+    }
+
+private:
+    const CsrGraph& graph;
+    const size_t n;
+    uint32_t delta;
+    mutable WorkerPool workers; // one set of threads for every phase of this search, fillTree included
+    std::vector<std::atomic<uint64_t>> distance;
+    std::vector<std::vector<VertexId>> buckets; // circular, indexed by bucket % size
+    size_t pending = 0;                         // entries across all buckets, stale ones included
+    std::vector<uint64_t> queuedIn;             // bucket a vertex was last queued in, to skip duplicates
+    std::vector<bool> inBucket;                 // already among the current bucket's settled vertices
+    std::vector<std::vector<VertexId>> workerOutput;
+    std::atomic<uint64_t> relaxed;
+
+    void enqueue(VertexId v) {
+        uint64_t bucket = distance[v].load(std::memory_order_relaxed) / delta;
+        if (queuedIn[v] == bucket) {
+            return;
+        }
+        queuedIn[v] = bucket;
+        buckets[bucket % buckets.size()].push_back(v);
+        pending++;
+    }
+
+    // Relax the light or heavy out-edges of vertices on the workers, then queue every
+    // target that improved under its final distance of this round
+    void relax(const std::vector<VertexId>& vertices, bool light) {
+        size_t chunks = (vertices.size() + kChunk - 1) / kChunk;
+        workers.forEachWorker(chunks, vertices.size() >= kParallelFrontier, [&](size_t chunk, unsigned worker) {
+            std::vector<VertexId>& improved = workerOutput[worker];
+            uint64_t attempts = 0;
+            size_t end = std::min(vertices.size(), (chunk + 1) * kChunk);
+            for (size_t i = chunk * kChunk; i < end; ++i) {
+                VertexId u = vertices[i];
+                uint64_t base = distance[u].load(std::memory_order_relaxed);
+                const uint32_t* weight = graph.weightsBegin(u);
+                for (const VertexId* v = graph.targetsBegin(u); v != graph.targetsEnd(u); ++v, ++weight) {
+                    if ((*weight <= delta) != light) {
+                        continue;
+                    }
+                    attempts++;
+                    if (fetchMin(distance[*v], base + *weight)) {
+                        improved.push_back(*v);
+                    }
+                }
+            }
+            relaxed.fetch_add(attempts, std::memory_order_relaxed);
+        });
+        for (std::vector<VertexId>& improved : workerOutput) {
+            for (VertexId v : improved) {
+                enqueue(v);
+            }
+            improved.clear();
+        }
+    }
+};
+
+} // namespace
+
+ShortestPathTree deltaSteppingTree(const CsrGraph& graph, CsrGraph::VertexId source,
+    const DeltaSteppingOptions& options, JobControl* control) {
+    ShortestPathTree tree;
+    tree.source = source;
+    DeltaStepper stepper(graph, options);
+    uint64_t settled = 0;
+    tree.complete = stepper.run(source, control, settled);
+    tree.settled = settled;
+    stepper.fillTree(tree);
+    return tree;
+}
@@ -0,0 +1,49 @@
+#include "../include/EdgeCost.h"
+
+const char* pathCostName(PathCost cost) {
+    switch (cost) {
+    case PathCost::Count:
+        return "count";
+    case PathCost::InverseFrequency:
+        return "inverse frequency";
+    case PathCost::NegativeLogProbability:
+        return "negative log probability";
+    case PathCost::Hops:
+        return "hops";
+    }
+    return "unknown";
+}
+
+bool parsePathCost(const std::string& text, PathCost& cost) {
+    if (text == "count") {
+        cost = PathCost::Count;
+    }
+    else if (text == "inverse") {
+        cost = PathCost::InverseFrequency;
+    }
+    else if (text == "logprob") {
+        cost = PathCost::NegativeLogProbability;
+    }
+    else if (text == "hops") {
+        cost = PathCost::Hops;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+NegativeLogProbabilityCost::NegativeLogProbabilityCost(const CsrGraph& graph) : costs(graph.edgeCount()) {
+    const std::vector<uint32_t>& offsets = graph.rowOffsets();
+    for (size_t v = 0; v < graph.vertexCount(); ++v) {
+        double total = 0.0;
+        for (uint32_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+            total += graph.edgeWeight(e);
+        }
+        double logTotal = std::log(total);
+        for (uint32_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+            // An only successor has probability 1: clamp rounding so costs never go negative
+            costs[e] = std::max(0.0, logTotal - std::log(static_cast<double>(graph.edgeWeight(e))));
+        }
+    }
+}
@@ -0,0 +1,429 @@
+#include "../include/ExternalBuilder.h"
+#include "../include/GraphBuilder.h"
+#include "../include/Tools.h"
+#include "../include/WordStream.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <unistd.h>
+
+// Approximate per-word overhead of the vocabulary: hash node, bucket slot, ID -> word pointer
+static const size_t kVocabularyEntryOverhead = 64;
+// Per-word arrays of finishToSnapshot: used-word list, ranks, sorted order, offsets, hashes
+static const size_t kFinishBytesPerWord = 56;
+// Stream buffer of every run open in a merge
+static const size_t kRunReadBuffer = static_cast<size_t>(1) << 16;
+
+static std::string newRunPath(const std::string& tempDir) {
+    static std::atomic<unsigned> runSerial(0);
+    return tempDir + "/textgraph-run-" + std::to_string(getpid()) + "-" + std::to_string(runSerial.fetch_add(1)) + ".bin";
+}
+
+namespace {
+
+// One sorted input of the k-way merge
+class RunReader {
+    std::ifstream file;
+    std::vector<char> streamBuffer;
+
+public:
+    uint64_t key = 0;
+    uint32_t count = 0;
+
+    explicit RunReader(const std::string& path) : streamBuffer(kRunReadBuffer) {
+        file.rdbuf()->pubsetbuf(streamBuffer.data(), static_cast<std::streamsize>(streamBuffer.size()));
+        file.open(path, std::ios::binary);
+    }
+
+    bool isOpen() const { return file.is_open(); }
+
+    bool next() {
+        file.read(reinterpret_cast<char*>(&key), sizeof(key));
+        file.read(reinterpret_cast<char*>(&count), sizeof(count));
+        return static_cast<bool>(file);
+    }
+};
+
+// Appends (key, count) records to a run; counts summed past 32 bits saturate
+class RunWriter {
+    std::ofstream file;
+
+public:
+    explicit RunWriter(const std::string& path) : file(path, std::ios::binary) {}
+
+    bool isOpen() const { return file.is_open(); }
+
+    bool write(uint64_t key, uint64_t count) {
+        uint32_t stored = static_cast<uint32_t>(std::min<uint64_t>(count, 0xFFFFFFFFu));
+        file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+        file.write(reinterpret_cast<const char*>(&stored), sizeof(stored));
+        return static_cast<bool>(file);
+    }
+
+    bool close() {
+        file.close();
+        return !file.fail();
+    }
+};
+
+// k-way merge of sorted runs and, if given, sorted in-memory keys (each occurrence counts
+// once). Calls emit(key, count) for every distinct key in ascending order with the counts
+// summed, and stops as soon as emit returns false
+template <typename Emit>
+bool mergeSorted(const std::vector<std::string>& paths, const std::vector<uint64_t>* memory, Emit& emit) {
+    std::vector<std::unique_ptr<RunReader>> readers;
+    typedef std::pair<uint64_t, size_t> HeapEntry; // (key, reader index); index == readers.size() is memory
+    std::priority_queue<HeapEntry, std::vector<HeapEntry>, std::greater<HeapEntry>> heap;
+    for (const std::string& path : paths) {
+        readers.push_back(std::unique_ptr<RunReader>(new RunReader(path)));
+        if (!readers.back()->isOpen()) {
+            std::cerr << "Error: Could not reopen run file " << path << '\n';
+            return false;
+        }
+    }
+    for (size_t r = 0; r < readers.size(); ++r) {
+        if (readers[r]->next()) {
+            heap.push(HeapEntry(readers[r]->key, r));
+        }
+    }
+    const size_t memorySource = readers.size();
+    size_t memoryPos = 0;
+    if (memory != nullptr && memoryPos < memory->size()) {
+        heap.push(HeapEntry((*memory)[memoryPos], memorySource));
+    }
+
+    uint64_t currentKey = 0;
+    uint64_t currentCount = 0;
+    bool haveKey = false;
+    while (!heap.empty()) {
+        HeapEntry top = heap.top();
+        heap.pop();
+        uint64_t count = 0;
+        if (top.second == memorySource) {
+            while (memoryPos < memory->size() && (*memory)[memoryPos] == top.first) {
+                ++memoryPos;
+                ++count;
+            }
+            if (memoryPos < memory->size()) {
+                heap.push(HeapEntry((*memory)[memoryPos], memorySource));
+            }
+        }
+        else {
+            RunReader* reader = readers[top.second].get();
+            count = reader->count;
+            if (reader->next()) {
+                heap.push(HeapEntry(reader->key, top.second));
+            }
+        }
+
+        if (haveKey && top.first != currentKey) {
+            if (!emit(currentKey, currentCount)) {
+                return false;
+            }
+            currentCount = 0;
+        }
+        currentKey = top.first;
+        currentCount += count;
+        haveKey = true;
+    }
+    return !haveKey || emit(currentKey, currentCount);
+}
+
+} // namespace
+
+ExternalGraphBuilder::ExternalGraphBuilder(const ExternalBuildOptions& buildOptions)
+    : options(buildOptions), pairCapacity(0), vocabularyBudget(0), mergeFanIn(2), finished(false) {
+    if (options.tempDir.empty()) {
+        const char* tmp = std::getenv("TMPDIR");
+        options.tempDir = (tmp && *tmp) ? tmp : "/tmp";
+    }
+    if (options.readChunkBytes == 0) {
+        options.readChunkBytes = static_cast<size_t>(1) << 20;
+    }
+    // Half of the budget goes to the run buffer, the rest is left for the vocabulary. The
+    // buffer is empty while runs are merged: its half then holds the read buffers of the open
+    // runs and, for a snapshot, the buffer of re-keyed edges
+    pairCapacity = std::max<size_t>(4096, options.memoryBudgetBytes / 2 / sizeof(uint64_t));
+    size_t pairBytes = pairCapacity * sizeof(uint64_t);
+    vocabularyBudget = options.memoryBudgetBytes > pairBytes ? options.memoryBudgetBytes - pairBytes : 0;
+    mergeFanIn = std::max<size_t>(2, std::min(options.maxMergeFanIn, pairBytes / 2 / kRunReadBuffer));
+}
+
+ExternalGraphBuilder::~ExternalGraphBuilder() {
+    removeRuns();
+}
+
+uint32_t ExternalGraphBuilder::wordId(const char* word, size_t length) {
+    lookupKey.assign(word, length);
+    std::unordered_map<std::string, uint32_t>::iterator it = vocabulary.find(lookupKey);
+    if (it != vocabulary.end()) {
+        return it->second;
+    }
+    uint32_t id = static_cast<uint32_t>(words.size());
+    it = vocabulary.emplace(lookupKey, id).first;
+    words.push_back(&it->first);
+    inPair.push_back(false);
+    buildReport.vocabularyBytes += length + 1 + kVocabularyEntryOverhead + kFinishBytesPerWord;
+    return id;
+}
+
+bool ExternalGraphBuilder::addFile(const std::string& filePath) {
+    if (finished) {
+        std::cerr << "Error: external build already finished" << '\n';
+        return false;
+    }
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << filePath << '\n';
+        return false;
+    }
+    if (pairBuffer.capacity() < pairCapacity) {
+        pairBuffer.reserve(pairCapacity);
+    }
+
+    bool havePrevious = false;
+    uint32_t previous = 0;
+    auto onWord = [this, &havePrevious, &previous](const char* word, size_t length) {
+        uint32_t id = wordId(word, length);
+        if (buildReport.vocabularyBytes > vocabularyBudget) {
+            std::cerr << "Error: the vocabulary needs more than the " << vocabularyBudget
+                      << " bytes the memory budget leaves it; raise the budget" << '\n';
+            return false;
+        }
+        buildReport.tokens++;
+        if (havePrevious) {
+            pairBuffer.push_back((static_cast<uint64_t>(previous) << 32) | id);
+            inPair[previous] = true;
+            inPair[id] = true;
+            buildReport.pairs++;
+            if (pairBuffer.size() >= pairCapacity && !spillRun()) {
+                return false;
+            }
+        }
+        previous = id;
+        havePrevious = true;
+        return true;
+    };
+    return streamWords(file, options.readChunkBytes, onWord);
+}
+
+// Sort the buffer, collapse duplicates and append the run as (key, count) records
+bool ExternalGraphBuilder::spillRun() {
+    std::sort(pairBuffer.begin(), pairBuffer.end());
+
+    std::string runPath = newRunPath(options.tempDir);
+    RunWriter run(runPath);
+    if (!run.isOpen()) {
+        std::cerr << "Error: Could not create run file " << runPath << '\n';
+        return false;
+    }
+    runFiles.push_back(runPath);
+
+    bool written = true;
+    for (size_t i = 0; i < pairBuffer.size();) {
+        uint64_t key = pairBuffer[i];
+        size_t j = i;
+        while (j < pairBuffer.size() && pairBuffer[j] == key) {
+            ++j;
+        }
+        written = run.write(key, j - i) && written;
+        i = j;
+    }
+    pairBuffer.clear();
+    buildReport.runs++;
+    if (!run.close() || !written) {
+        std::cerr << "Error: Could not write run file " << runPath << '\n';
+        return false;
+    }
+    return true;
+}
+
+namespace {
+
+// Edges arrive sorted and already summed, so each one is a single insert into the builder's
+// tables; the graph takes them all at once in finishInto
+struct GraphSink {
+    const std::vector<const std::string*>& words;
+    std::vector<uint32_t> builderIds; // external word ID -> builder ID, kNoWord until first used
+    GraphBuilder builder;
+
+    explicit GraphSink(const std::vector<const std::string*>& w) : words(w), builderIds(w.size(), GraphBuilder::kNoWord) {}
+
+    bool operator()(uint32_t src, uint32_t dst, uint64_t count) {
+        uint32_t weight = static_cast<uint32_t>(std::min<uint64_t>(count, static_cast<uint64_t>(std::numeric_limits<int>::max())));
+        builder.addEdge(idOf(src), idOf(dst), weight);
+        return true;
+    }
+    uint32_t idOf(uint32_t id) {
+        if (builderIds[id] == GraphBuilder::kNoWord) {
+            builderIds[id] = builder.intern(words[id]->data(), words[id]->size());
+        }
+        return builderIds[id];
+    }
+    bool flush() { return true; }
+};
+
+// First pass of finishToSnapshot: the runs are in external-ID order, so each summed edge is
+// re-keyed by the snapshot IDs of its words and spilled again; merging these runs yields the
+// rows in the order the snapshot stores them
+struct RankedRunSink {
+    typedef std::pair<uint64_t, uint32_t> Record;
+
+    const std::vector<CompressedGraph::VertexId>& snapshotIds; // external word ID -> snapshot ID
+    const std::string& tempDir;
+    size_t capacity;
+    std::vector<Record> records;
+    std::vector<std::string> runs;
+
+    RankedRunSink(const std::vector<CompressedGraph::VertexId>& ids, const std::string& dir, size_t recordCapacity)
+        : snapshotIds(ids), tempDir(dir), capacity(std::max<size_t>(1, recordCapacity)) {
+        records.reserve(capacity);
+    }
+
+    bool operator()(uint32_t src, uint32_t dst, uint64_t count) {
+        uint64_t key = (static_cast<uint64_t>(snapshotIds[src]) << 32) | snapshotIds[dst];
+        records.push_back(Record(key, static_cast<uint32_t>(std::min<uint64_t>(count, 0xFFFFFFFFu))));
+        return records.size() < capacity || flush();
+    }
+    // The mapping is one-to-one, so every key is distinct and keeps its count
+    bool flush() {
+        if (records.empty()) {
+            return true;
+        }
+        std::sort(records.begin(), records.end());
+        std::string runPath = newRunPath(tempDir);
+        RunWriter run(runPath);
+        if (!run.isOpen()) {
+            std::cerr << "Error: Could not create run file " << runPath << '\n';
+            return false;
+        }
+        runs.push_back(runPath);
+        bool written = true;
+        for (const Record& record : records) {
+            written = run.write(record.first, record.second) && written;
+        }
+        records.clear();
+        if (!run.close() || !written) {
+            std::cerr << "Error: Could not write run file " << runPath << '\n';
+            return false;
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+bool ExternalGraphBuilder::reduceRuns() {
+    while (runFiles.size() > mergeFanIn) {
+        std::vector<std::string> merged;
+        for (size_t first = 0; first < runFiles.size(); first += mergeFanIn) {
+            std::vector<std::string> group(runFiles.begin() + first,
+                                           runFiles.begin() + std::min(first + mergeFanIn, runFiles.size()));
+            if (group.size() == 1) {
+                merged.push_back(group[0]);
+                continue;
+            }
+            std::string runPath = newRunPath(options.tempDir);
+            RunWriter run(runPath);
+            merged.push_back(runPath);
+            auto write = [&run](uint64_t key, uint64_t count) { return run.write(key, count); };
+            bool ok = run.isOpen() && mergeSorted(group, nullptr, write);
+            ok = run.close() && ok;
+            if (!ok) {
+                std::cerr << "Error: Could not write run file " << runPath << '\n';
+                // Leave every file of the pass to removeRuns
+                runFiles.insert(runFiles.end(), merged.begin(), merged.end());
+                return false;
+            }
+            for (const std::string& path : group) {
+                std::remove(path.c_str());
+            }
+        }
+        runFiles.swap(merged);
+        buildReport.mergePasses++;
+    }
+    return true;
+}
+
+template <typename Sink>
+bool ExternalGraphBuilder::mergeRuns(Sink& sink) {
+    // Once there are runs, the tail of the buffer becomes one more, so the buffer's memory is
+    // free for the merge; otherwise the whole input is merged from memory
+    bool ok = runFiles.empty() || pairBuffer.empty() || spillRun();
+    std::sort(pairBuffer.begin(), pairBuffer.end());
+    ok = ok && reduceRuns();
+
+    auto emit = [this, &sink](uint64_t key, uint64_t count) {
+        buildReport.edges++;
+        return sink(static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key), count);
+    };
+    ok = ok && mergeSorted(runFiles, &pairBuffer, emit) && sink.flush();
+
+    std::vector<uint64_t>().swap(pairBuffer);
+    removeRuns();
+    finished = true;
+    return ok;
+}
+
+bool ExternalGraphBuilder::finishInto(Graph& graph) {
+    if (finished) {
+        return false;
+    }
+    GraphSink sink(words);
+    if (!mergeRuns(sink)) {
+        return false;
+    }
+    graph.addEdges(sink.builder);
+    buildReport.vertices = graph.vertexCount();
+    return true;
+}
+
+bool ExternalGraphBuilder::finishToSnapshot(const std::string& snapshotPath) {
+    if (finished) {
+        return false;
+    }
+    // Words that never appeared in a bigram are not vertices (as with buildFromFile)
+    std::vector<const std::string*> usedWords;
+    for (size_t id = 0; id < words.size(); ++id) {
+        if (inPair[id]) {
+            usedWords.push_back(words[id]);
+        }
+    }
+    CompressedGraph::SnapshotWriter writer(snapshotPath, usedWords);
+    std::vector<CompressedGraph::VertexId> snapshotIds(words.size(), 0);
+    for (size_t id = 0, used = 0; id < words.size(); ++id) {
+        if (inPair[id]) {
+            snapshotIds[id] = writer.idOf(used++);
+        }
+    }
+    std::vector<const std::string*>().swap(usedWords);
+
+    // The re-keyed records (16 bytes each) share the merge's half of the budget with the
+    // read buffers of the open runs
+    RankedRunSink ranked(snapshotIds, options.tempDir, pairCapacity * sizeof(uint64_t) / 2 / sizeof(RankedRunSink::Record));
+    bool ok = writer.good() && mergeRuns(ranked);
+    finished = true;
+    // From here on removeRuns (or the destructor) cleans up the second set of runs
+    runFiles.insert(runFiles.end(), ranked.runs.begin(), ranked.runs.end());
+    std::vector<CompressedGraph::VertexId>().swap(snapshotIds);
+
+    auto emit = [&writer](uint64_t key, uint64_t count) {
+        uint32_t weight = static_cast<uint32_t>(std::min<uint64_t>(count, 0xFFFFFFFFu));
+        return writer.addEdge(static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key), weight);
+    };
+    // An unfinished writer leaves no snapshot behind, only its temporary files to remove
+    ok = ok && reduceRuns() && mergeSorted(runFiles, nullptr, emit) && writer.finish();
+    removeRuns();
+    buildReport.vertices = writer.vertexCount();
+    return ok;
+}
+
+void ExternalGraphBuilder::removeRuns() {
+    for (const std::string& path : runFiles) {
+        std::remove(path.c_str());
+    }
+    runFiles.clear();
+}
@@ -1,7 +1,43 @@
 #include "../include/Tools.h"
+#include "../include/Reachability.h"
+#include "../include/PathCache.h"
+#include "../include/DeltaStepping.h"
+#include "../include/EdgeCost.h"
+#include "../include/SparseMatrix.h"
+#include "../include/HopSearch.h"
+#include "../include/GraphBuilder.h"
+#include "../include/Parallel.h"
+#include "../include/Betweenness.h"
+#include "../include/Jobs.h"
+#include "../include/ResultStream.h"
+#include <unordered_set>
+
+// Milliseconds elapsed since start, used for the build phase timings
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Source of graph versions, shared by all graphs so diverging copies never collide
+static std::atomic<uint64_t> nextVersion(1);
+
+Graph::Graph() : rng(static_cast<unsigned int>(time(nullptr))), pathCache(std::make_shared<ShortestPathCache>()) {}
 
 // Process text file and build graph
 bool Graph::buildFromFile(const std::string& filePath) {
+    // Later documents are built on their own and merged, so each keeps its own term counts
+    if (!adjacencyList.empty() || !corpusTerms.empty()) {
+        Graph document;
+        if (!document.buildFromFile(filePath)) {
+            return false;
+        }
+        merge(document);
+        buildStats.readMs = document.buildStats.readMs;
+        buildStats.tokenizeMs = document.buildStats.tokenizeMs;
+        buildStats.insertMs = document.buildStats.insertMs;
+        return true;
+    }
+
+    std::chrono::steady_clock::time_point phaseStart = std::chrono::steady_clock::now();
     std::ifstream file(filePath);
     if (!file.is_open()) {
         std::cerr << "Error: Could not open file " << filePath << '\n';
@@ -13,50 +49,192 @@ bool Graph::buildFromFile(const std::string& filePath) {
     buffer << file.rdbuf();
     std::string content = buffer.str();
     file.close();
+    buildStats.readMs = elapsedMs(phaseStart);
+
+    // Single pass: split on punctuation/whitespace, keep letters and lowercase them in place.
+    // The vectorized tokenizer matches the old ispunct + normalizeWord pipeline byte for byte
+    phaseStart = std::chrono::steady_clock::now();
+    size_t wordCount = 0;
+    content.resize(normalizeTextInPlace(&content[0], content.size(), &wordCount));
+    buildStats.tokenizeMs = elapsedMs(phaseStart);
+
+    // Count bigrams by word ID in the builder's hash tables, then turn them into the
+    // adjacency map once; the graph is empty here, so that is all addEdge would have done
+    phaseStart = std::chrono::steady_clock::now();
+    WordCursor cursor(content.data(), content.size());
+    const char* wordData = nullptr;
+    size_t wordLength = 0;
+    GraphBuilder builder;
+    uint32_t prevWord = GraphBuilder::kNoWord;
+    std::string leadingWord;
 
-    // Replace all punctuation with spaces
-    // ispunct() is a function that returns true if the given character is a punctuation mark（标点符号）
-    for (char& c : content) {
-        if (std::ispunct(c) || c == '\n' || c == '\r') {
-            c = ' ';
+    // Process words
+    while (cursor.next(wordData, wordLength)) {
+        uint32_t word = builder.intern(wordData, wordLength);
+        if (prevWord != GraphBuilder::kNoWord) {
+            // Add edge from prevWord to current word
+            builder.addEdge(prevWord, word);
+        }
+        else {
+            leadingWord.assign(wordData, wordLength);
         }
+        prevWord = word;
+    }
+    if (builder.edgeCount() > 0) {
+        version = nextVersion.fetch_add(1, std::memory_order_relaxed);
+        builder.fill(adjacencyList);
     }
+    recordDocument(leadingWord);
+    buildStats.tokens += wordCount;
+    buildStats.insertMs = elapsedMs(phaseStart);
 
-    std::stringstream ss(content);
-    std::string word, prevWord;
-    bool firstWord = true;
+    return true;
+}
 
-    // Process words
-    while (ss >> word) {
-        std::string normalizedWord = normalizeWord(word);
-        if (normalizedWord.empty()) continue;
+// Term counts of the single document just built into this (empty) graph: every word occurs once
+// per incoming edge weight, plus once more for the word the document starts with
+void Graph::recordDocument(const std::string& firstWord) {
+    for (const auto& entry : adjacencyList) {
+        corpusTerms.emplace_hint(corpusTerms.end(), entry.first, TermCounts())->second.documentFrequency = 1;
+    }
+    for (const auto& entry : adjacencyList) {
+        for (const Edge& edge : entry.second) {
+            corpusTerms.find(edge.dest)->second.termFrequency += static_cast<uint64_t>(edge.weight);
+        }
+    }
+    std::map<std::string, TermCounts>::iterator first = corpusTerms.find(firstWord);
+    if (first != corpusTerms.end()) {
+        first->second.termFrequency++;
+    }
+    buildStats.documents++;
+}
 
-        if (!firstWord) {
-            // Add edge from prevWord to current word
-            addEdge(prevWord, normalizedWord);
+// Build every file into its own partial graph on worker threads, then merge them in order
+bool Graph::buildFromFiles(const std::vector<std::string>& filePaths, unsigned threads) {
+    if (threads == 0) {
+        threads = defaultThreadCount();
+    }
+    // Contiguous runs of files, a few per thread so slow files even out; merging the runs in
+    // order gives the same graph, edge order included, as building the files one by one
+    const size_t chunkCount = std::min(filePaths.size(), static_cast<size_t>(threads) * 4);
+    std::vector<Graph> partials(chunkCount);
+    std::atomic<bool> failed(false);
+    parallelFor(chunkCount, threads, [&](size_t chunk) {
+        size_t begin = filePaths.size() * chunk / chunkCount;
+        size_t end = filePaths.size() * (chunk + 1) / chunkCount;
+        for (size_t i = begin; i < end; ++i) {
+            if (!partials[chunk].buildFromFile(filePaths[i])) {
+                failed = true;
+            }
+        }
+    });
+
+    buildStats.readMs = buildStats.tokenizeMs = buildStats.insertMs = 0.0;
+    for (Graph& partial : partials) {
+        merge(partial);
+        partial = Graph(); // release each partial as soon as it is merged
+    }
+    return !failed;
+}
+
+// Add the weights of incoming into edges; destinations seen for the first time are appended
+static void mergeEdgeList(std::vector<Graph::Edge>& edges, const std::vector<Graph::Edge>& incoming) {
+    if (edges.empty()) {
+        edges = incoming;
+        return;
+    }
+    const size_t existing = edges.size();
+    if (existing * incoming.size() <= 256) {
+        for (const Graph::Edge& edge : incoming) {
+            size_t i = 0;
+            while (i < existing && edges[i].dest != edge.dest) {
+                ++i;
+            }
+            if (i < existing) {
+                edges[i].weight += edge.weight;
+            }
+            else {
+                edges.push_back(edge);
+            }
+        }
+        return;
+    }
+
+    // Long lists: binary search an index sorted by destination instead of scanning
+    std::vector<uint32_t> order(existing);
+    for (size_t i = 0; i < existing; ++i) {
+        order[i] = static_cast<uint32_t>(i);
+    }
+    std::sort(order.begin(), order.end(), [&edges](uint32_t a, uint32_t b) { return edges[a].dest < edges[b].dest; });
+    for (const Graph::Edge& edge : incoming) {
+        std::vector<uint32_t>::iterator it = std::lower_bound(order.begin(), order.end(), edge.dest,
+            [&edges](uint32_t index, const std::string& dest) { return edges[index].dest < dest; });
+        if (it != order.end() && edges[*it].dest == edge.dest) {
+            edges[*it].weight += edge.weight;
         }
         else {
-            firstWord = false;
+            edges.push_back(edge);
         }
+    }
+}
 
-        prevWord = normalizedWord;
+// Merge another graph (e.g. one document) into this one
+void Graph::merge(const Graph& other) {
+    if (&other == this) {
+        Graph copy(other);
+        merge(copy);
+        return;
     }
+    version = nextVersion.fetch_add(1, std::memory_order_relaxed);
 
-    return true;
+    if (adjacencyList.empty()) {
+        adjacencyList = other.adjacencyList;
+    }
+    else {
+        for (const auto& entry : other.adjacencyList) {
+            auto it = adjacencyList.lower_bound(entry.first);
+            if (it == adjacencyList.end() || it->first != entry.first) {
+                adjacencyList.emplace_hint(it, entry.first, entry.second);
+            }
+            else {
+                mergeEdgeList(it->second, entry.second);
+            }
+        }
+    }
+
+    for (const auto& entry : other.corpusTerms) {
+        auto it = corpusTerms.lower_bound(entry.first);
+        if (it == corpusTerms.end() || it->first != entry.first) {
+            corpusTerms.emplace_hint(it, entry.first, entry.second);
+        }
+        else {
+            it->second.termFrequency += entry.second.termFrequency;
+            it->second.documentFrequency += entry.second.documentFrequency;
+        }
+    }
+
+    buildStats.tokens += other.buildStats.tokens;
+    buildStats.documents += other.buildStats.documents;
+    buildStats.readMs += other.buildStats.readMs;
+    buildStats.tokenizeMs += other.buildStats.tokenizeMs;
+    buildStats.insertMs += other.buildStats.insertMs;
 }
 
 // Add edge or increase weight if it already exists
-void Graph::addEdge(const std::string& src, const std::string& dest) {
-    // Ensure src is in the adjacency list
-    if (adjacencyList.find(src) == adjacencyList.end()) {
-        adjacencyList[src] = std::vector<Edge>();
+void Graph::addEdge(const std::string& src, const std::string& dest, int weight) {
+    version = nextVersion.fetch_add(1, std::memory_order_relaxed);
+
+    // Ensure src is in the adjacency list; one lookup finds it or where it goes
+    std::map<std::string, std::vector<Edge>>::iterator source = adjacencyList.lower_bound(src);
+    if (source == adjacencyList.end() || source->first != src) {
+        source = adjacencyList.emplace_hint(source, src, std::vector<Edge>());
     }
 
     // Check if edge already exists
     bool found = false;
-    for (Edge& edge : adjacencyList[src]) {
+    for (Edge& edge : source->second) {
         if (edge.dest == dest) {
-            edge.weight++;
+            edge.weight += weight;
             found = true;
             break;
         }
@@ -64,13 +242,29 @@ void Graph::addEdge(const std::string& src, const std::string& dest) {
 
     // If edge doesn't exist, add it
     if (!found) {
-        adjacencyList[src].emplace_back(std::string(dest), 1);
+        source->second.emplace_back(dest, weight);
     }
 
     // Ensure dest is in the adjacency list (even if it has no outgoing edges)
-    if (adjacencyList.find(dest) == adjacencyList.end()) {
-        adjacencyList[dest] = std::vector<Edge>();
+    std::map<std::string, std::vector<Edge>>::iterator target = adjacencyList.lower_bound(dest);
+    if (target == adjacencyList.end() || target->first != dest) {
+        adjacencyList.emplace_hint(target, dest, std::vector<Edge>());
+    }
+}
+
+// Bulk insertion of counted edges, e.g. the sorted output of the out-of-core merge
+void Graph::addEdges(const GraphBuilder& builder) {
+    if (builder.edgeCount() == 0) {
+        return;
+    }
+    if (!adjacencyList.empty()) {
+        Graph counted;
+        counted.addEdges(builder);
+        merge(counted);
+        return;
     }
+    version = nextVersion.fetch_add(1, std::memory_order_relaxed);
+    builder.fill(adjacencyList);
 }
 
 // Display the graph
@@ -136,34 +330,36 @@ std::vector<std::string> Graph::findBridgeWords(const std::string& word1, const
     std::string normalizedWord2 = normalizeWord(word2);
 
     // Check if both words exist in the graph
-    if (adjacencyList.find(normalizedWord1) == adjacencyList.end() ||
-        adjacencyList.find(normalizedWord2) == adjacencyList.end()) {
+    std::shared_ptr<const CsrGraph> csr = csrView();
+    CsrGraph::VertexId from = 0, to = 0;
+    if (!csr->findVertex(normalizedWord1, from) || !csr->findVertex(normalizedWord2, to)) {
         return bridges; // Empty vector indicates words not found
     }
 
-    // Find potential bridge words
-    for (const auto& entry : adjacencyList) {
-        const std::string& potentialBridge = entry.first;
-
-        // Check if word1 connects to potentialBridge
-        bool word1ConnectsToBridge = false;
-        for (const Edge& edge : adjacencyList.at(normalizedWord1)) {
-            if (edge.dest == potentialBridge) {
-                word1ConnectsToBridge = true;
-                break;
-            }
+    // Bridges are successors of word1 that are also predecessors of word2; both rows are
+    // sorted by ID, so one merge pass over them finds every bridge
+    std::shared_ptr<const CsrGraph> in = inEdgeView();
+    const CsrGraph::VertexId* successor = csr->targetsBegin(from);
+    const CsrGraph::VertexId* successorEnd = csr->targetsEnd(from);
+    const CsrGraph::VertexId* predecessor = in->targetsBegin(to);
+    const CsrGraph::VertexId* predecessorEnd = in->targetsEnd(to);
+    while (successor != successorEnd && predecessor != predecessorEnd) {
+        if (*successor < *predecessor) {
+            ++successor;
         }
-
-        if (!word1ConnectsToBridge) continue;
-
-        // Check if potentialBridge connects to word2
-        for (const Edge& edge : adjacencyList.at(potentialBridge)) {
-            if (edge.dest == normalizedWord2) {
-                bridges.push_back(potentialBridge);
-                break;
-            }
+        else if (*predecessor < *successor) {
+            ++predecessor;
+        }
+        else {
+            bridges.push_back(csr->name(*successor));
+            ++successor;
+            ++predecessor;
         }
     }
+    // IDs follow the words alphabetically unless the view was renumbered
+    if (vertexOrder != VertexOrder::Lexicographic) {
+        std::sort(bridges.begin(), bridges.end());
+    }
 
     return bridges;
 }
@@ -211,155 +407,384 @@ std::string Graph::generateTextWithBridges(const std::string& inputText) {
     return result.str();
 }
 
+// Record the work done by one Dijkstra run
+void Graph::publishShortestPathCounters(uint64_t settled, uint64_t relaxed) const {
+    TG_STAT(queryCounters.shortestPathCalls.add(1));
+    TG_STAT(queryCounters.lastVerticesSettled.store(settled));
+    TG_STAT(queryCounters.lastEdgesRelaxed.store(relaxed));
+    TG_STAT(queryCounters.totalVerticesSettled.add(settled));
+    TG_STAT(queryCounters.totalEdgesRelaxed.add(relaxed));
+    (void)settled;
+    (void)relaxed;
+}
+
+// Shortest-path tree from one source, served from the cache when the graph has not changed
+std::shared_ptr<const ShortestPathTree> Graph::shortestPathTree(uint32_t sourceId, PathCost cost, JobControl* control,
+    uint32_t targetId) const {
+    std::shared_ptr<const ShortestPathTree> tree = pathCache->find(sourceId, version, cost);
+    if (tree) {
+        publishShortestPathCounters(0, 0);
+        return tree;
+    }
+    // A one-off pair settles only what is closer than the target; a repeated source pays for
+    // the whole tree once so that its later targets are answered from the cache
+    if (targetId != CsrGraph::kNoVertex && pathCache->seenBefore(sourceId, version, cost)) {
+        targetId = CsrGraph::kNoVertex;
+    }
+    // The metric is chosen here, once per search; each branch runs its own instantiation
+    std::shared_ptr<ShortestPathTree> built;
+    if (cost == PathCost::Hops) {
+        built = std::make_shared<ShortestPathTree>(buildHopTree(*csrView(), sourceId, control, targetId));
+    }
+    else if (cost == PathCost::InverseFrequency) {
+        built = std::make_shared<ShortestPathTree>(buildShortestPathTree(*csrView(), sourceId, InverseFrequencyCost(),
+            control, targetId));
+    }
+    else if (cost == PathCost::NegativeLogProbability) {
+        built = std::make_shared<ShortestPathTree>(buildShortestPathTree(*csrView(), sourceId, *logProbabilityCosts(),
+            control, targetId));
+    }
+    else if (pathThreads == 1 || targetId != CsrGraph::kNoVertex) {
+        built = std::make_shared<ShortestPathTree>(buildShortestPathTree(*csrView(), sourceId, control, targetId));
+    }
+    else {
+        DeltaSteppingOptions options;
+        options.delta = pathDelta;
+        options.threads = pathThreads;
+        built = std::make_shared<ShortestPathTree>(deltaSteppingTree(*csrView(), sourceId, options, control));
+    }
+    built->version = version;
+    publishShortestPathCounters(built->settled, built->relaxed);
+    if (built->complete) {
+        pathCache->insert(built);
+    }
+    return built;
+}
+
+// Per-edge -log P(dest | src) of the CSR view, computed on first use after a change
+std::shared_ptr<const NegativeLogProbabilityCost> Graph::logProbabilityCosts() const {
+    return logProbabilityCache.get(version, [this]() {
+        return std::make_shared<const NegativeLogProbabilityCost>(*csrView());
+    });
+}
+
+// Weighted adjacency matrix of the CSR view for the iterative rankings, built on first use after a change
+std::shared_ptr<const SparseMatrix> Graph::rankMatrix() const {
+    return matrixCache.get(version, [this]() { return std::make_shared<const SparseMatrix>(*csrView()); });
+}
+
+// Predecessor lists of the CSR view, built on first use after a change
+std::shared_ptr<const CsrGraph> Graph::inEdgeView() const {
+    return inEdgeCache.get(version, [this]() { return std::make_shared<const CsrGraph>(csrView()->transpose()); });
+}
+
 // Find shortest path using Dijkstra's algorithm
-std::pair<double, std::vector<std::string>> Graph::shortestPath(const std::string& start, const std::string& end) const {
+std::pair<double, std::vector<std::string>> Graph::shortestPath(const std::string& start, const std::string& end,
+    PathCost cost) const {
     std::string normalizedStart = normalizeWord(start);
     std::string normalizedEnd = normalizeWord(end);
 
-    // Check if both words exist in the graph
-    if (adjacencyList.find(normalizedStart) == adjacencyList.end() ||
-        adjacencyList.find(normalizedEnd) == adjacencyList.end()) {
+    // Check if both words exist in the graph (perfect-hash lookups on the CSR view)
+    std::shared_ptr<const CsrGraph> csr = csrView();
+    CsrGraph::VertexId startId = 0, endId = 0;
+    if (!csr->findVertex(normalizedStart, startId) || !csr->findVertex(normalizedEnd, endId)) {
         return { -1, {} }; // Indicate words not found
     }
 
-    // Initialize distances with infinity
-    std::map<std::string, double> distance;
-    std::map<std::string, std::string> previous;
-    std::set<std::string> unvisited;
+    // Unreachable pairs are answered from the condensation index without searching. Only its
+    // O(1) tests are used: with interval labels an exact answer may need a DFS of its own, so
+    // pairs the labels cannot rule out go straight to the path search
+    std::shared_ptr<const ReachabilityIndex> index = reachabilityIndex();
+    bool reachable = index->usesClosure() ? index->canReach(startId, endId)
+        : index->mayReachComponent(index->componentOf(startId), index->componentOf(endId));
+    if (!reachable) {
+        publishShortestPathCounters(0, 0);
+        return { -1, {} };
+    }
 
-    for (const auto& entry : adjacencyList) {
-        const std::string& vertex = entry.first;
-        distance[vertex] = std::numeric_limits<double>::infinity();
-        unvisited.insert(vertex);
+    // The first query from a source stops once the target is settled; a second one builds and
+    // caches the full tree, after which its targets only walk parent links
+    std::shared_ptr<const ShortestPathTree> tree = shortestPathTree(startId, cost, nullptr, endId);
+    if (tree->distance[endId] == std::numeric_limits<double>::infinity()) {
+        return { -1, {} }; // unreachable after all
     }
+    return { tree->distance[endId], tree->pathTo(*csr, endId) };
+}
 
-    distance[normalizedStart] = 0;
+// Compute shortest paths from a single source to all other vertices
+std::map<std::string, std::pair<double, std::vector<std::string>>> Graph::shortestPathsFromSource(const std::string& start,
+    JobControl* control, PathCost cost) const {
+    std::map<std::string, std::pair<double, std::vector<std::string>>> result;
+    std::string normalizedStart = normalizeWord(start);
 
-    // Dijkstra's algorithm
-    while (!unvisited.empty()) {
-        // Find vertex with minimum distance
-        std::string current;
-        double minDist = std::numeric_limits<double>::infinity();
+    // Check if start word exists in the graph
+    std::shared_ptr<const CsrGraph> csr = csrView();
+    CsrGraph::VertexId startId = 0;
+    if (!csr->findVertex(normalizedStart, startId)) {
+        return result; // Empty map indicates word not found
+    }
 
-        for (const std::string& vertex : unvisited) {
-            if (distance[vertex] < minDist) {
-                minDist = distance[vertex];
-                current = vertex;
-            }
+    // One tree answers every destination
+    std::shared_ptr<const ShortestPathTree> tree = shortestPathTree(startId, cost, control);
+    if (!tree->complete) {
+        return result;
+    }
+    for (CsrGraph::VertexId destId = 0; destId < csr->vertexCount(); ++destId) {
+        if (control != nullptr && destId % 4096 == 0 && control->shouldStop()) {
+            return std::map<std::string, std::pair<double, std::vector<std::string>>>();
         }
-
-        if (minDist == std::numeric_limits<double>::infinity()) {
-            break; // No path exists
+        if (destId != startId && tree->distance[destId] != std::numeric_limits<double>::infinity()) {
+            result.insert(result.end(), std::make_pair(csr->name(destId),
+                std::make_pair(tree->distance[destId], tree->pathTo(*csr, destId))));
         }
+    }
 
-        // Remove current from unvisited
-        unvisited.erase(current);
+    return result;
+}
 
-        // If we reached the end, break
-        if (current == normalizedEnd) {
-            break;
-        }
+// Incremental Dijkstra from start; the stream keeps the views it searches alive
+ShortestPathStream Graph::streamShortestPaths(const std::string& start, PathCost cost) const {
+    std::shared_ptr<const CsrGraph> csr = csrView();
+    CsrGraph::VertexId startId = 0;
+    if (!csr->findVertex(normalizeWord(start), startId)) {
+        return ShortestPathStream();
+    }
+    std::shared_ptr<const NegativeLogProbabilityCost> logProbability;
+    if (cost == PathCost::NegativeLogProbability) {
+        logProbability = logProbabilityCosts();
+    }
+    return ShortestPathStream(csr, startId, cost, logProbability);
+}
 
-        // Update distances to neighbors
-        if (adjacencyList.find(current) != adjacencyList.end()) {
-            for (const Edge& edge : adjacencyList.at(current)) {
-                if (unvisited.find(edge.dest) != unvisited.end()) {
-                    // double alt = distance[current] + (1.0 / edge.weight); // Use inverse of weight for shortest path
-                    double alt = distance[current] + edge.weight;
-                    if (alt < distance[edge.dest]) {
-                        distance[edge.dest] = alt;
-                        previous[edge.dest] = current;
-                    }
-                }
-            }
-        }
+// Betweenness centrality of every word, keyed like calculatePageRank's result
+std::map<std::string, double> Graph::calculateBetweenness(size_t samples, unsigned threads) const {
+    std::shared_ptr<const CsrGraph> csr = csrView();
+    BetweennessOptions options;
+    options.samples = samples;
+    options.threads = threads;
+    std::vector<double> scores = betweennessCentrality(*csr, options);
+
+    std::map<std::string, double> result;
+    for (CsrGraph::VertexId v = 0; v < csr->vertexCount(); ++v) {
+        result.insert(result.end(), std::make_pair(csr->name(v), scores[v]));
+    }
+    return result;
+}
+
+// Perform random walk on the graph
+std::vector<std::string> Graph::randomWalk() {
+    std::vector<std::string> path;
+    RandomWalkStream walk = streamRandomWalk();
+    while (walk.next()) {
+        path.push_back(walk.word());
     }
+    return path; // empty for an empty graph; the stream has published the step counts
+}
 
-    // Reconstruct path if end was reached
-    if (distance[normalizedEnd] != std::numeric_limits<double>::infinity()) {
-        std::vector<std::string> path;
-        std::string current = normalizedEnd;
+// Walk the CSR view: its rows are the per-word tables the next step is drawn from
+RandomWalkStream Graph::streamRandomWalk() {
+    return RandomWalkStream(csrView(), static_cast<uint32_t>(rng()), &queryCounters);
+}
 
-        while (current != normalizedStart) {
-            path.push_back(current);
-            current = previous[current];
-        }
+// Check if a word exists in the graph
+bool Graph::containsWord(const std::string& word) const {
+    std::string normalizedWord = normalizeWord(word);
+    // Once the CSR view exists its perfect hash answers without walking the map
+    std::shared_ptr<const CsrGraph> csr = csrCache.peek(version);
+    if (csr) {
+        CsrGraph::VertexId id = 0;
+        return csr->findVertex(normalizedWord, id);
+    }
+    return adjacencyList.find(normalizedWord) != adjacencyList.end();
+}
 
-        path.push_back(normalizedStart);
-        std::reverse(path.begin(), path.end());
+// CSR copy of the adjacency list, rebuilt on the first call after a change
+std::shared_ptr<const CsrGraph> Graph::csrView() const {
+    return csrCache.get(version, [this]() {
+        CsrGraph csr(*this);
+        if (vertexOrder != VertexOrder::Lexicographic) {
+            csr = csr.permuted(csr.vertexOrder(vertexOrder));
+        }
+        return std::make_shared<const CsrGraph>(std::move(csr));
+    });
+}
 
-        return { distance[normalizedEnd], path };
+// Renumber the ID-based views; cached trees and indexes use the old IDs, so take a new version
+void Graph::setVertexOrder(VertexOrder order) {
+    if (order == vertexOrder) {
+        return;
     }
+    vertexOrder = order;
+    version = nextVersion.fetch_add(1, std::memory_order_relaxed);
+}
 
-    return { -1, {} }; // No path found
+// Strongly connected components + reachability summary, rebuilt on the first call after a change
+std::shared_ptr<const ReachabilityIndex> Graph::reachabilityIndex() const {
+    return reachabilityCache.get(version, [this]() { return std::make_shared<const ReachabilityIndex>(*csrView()); });
 }
 
-// Compute shortest paths from a single source to all other vertices
-std::map<std::string, std::pair<double, std::vector<std::string>>> Graph::shortestPathsFromSource(const std::string& start) const {
-    std::map<std::string, std::pair<double, std::vector<std::string>>> result;
-    std::string normalizedStart = normalizeWord(start);
+// Check whether any path leads from one word to another, without running a search
+bool Graph::isReachable(const std::string& from, const std::string& to) const {
+    std::shared_ptr<const CsrGraph> csr = csrView();
+    CsrGraph::VertexId fromId = 0, toId = 0;
+    if (!csr->findVertex(normalizeWord(from), fromId) || !csr->findVertex(normalizeWord(to), toId)) {
+        return false;
+    }
+    return reachabilityIndex()->canReach(fromId, toId);
+}
 
-    // Check if start word exists in the graph
-    if (adjacencyList.find(normalizedStart) == adjacencyList.end()) {
-        return result; // Empty map indicates word not found
+// Breadth-first search that stops as soon as the target's level is reached
+int Graph::hopDistance(const std::string& from, const std::string& to) const {
+    std::shared_ptr<const CsrGraph> csr = csrView();
+    CsrGraph::VertexId fromId = 0, toId = 0;
+    if (!csr->findVertex(normalizeWord(from), fromId) || !csr->findVertex(normalizeWord(to), toId)) {
+        return -1;
     }
+    HopSearchOptions options;
+    options.target = toId;
+    options.threads = pathThreads;
+    HopSearchResult result = hopSearch(*csr, *inEdgeView(), fromId, options);
+    return result.hops[toId] == HopSearchResult::kUnreached ? -1 : static_cast<int>(result.hops[toId]);
+}
 
-    // Find shortest path to each vertex
-    for (const auto& entry : adjacencyList) {
-        const std::string& dest = entry.first;
-        if (dest != normalizedStart) {
-            std::pair<double, std::vector<std::string>> path = shortestPath(normalizedStart, dest);
-            if (path.first != -1) {
-                result[dest] = path;
-            }
+// Breadth-first search cut off after the given number of levels
+std::map<std::string, uint32_t> Graph::neighborhood(const std::string& word, uint32_t hops) const {
+    std::map<std::string, uint32_t> result;
+    std::shared_ptr<const CsrGraph> csr = csrView();
+    CsrGraph::VertexId source = 0;
+    if (!csr->findVertex(normalizeWord(word), source)) {
+        return result;
+    }
+    HopSearchOptions options;
+    options.maxHops = hops;
+    options.threads = pathThreads;
+    HopSearchResult search = hopSearch(*csr, *inEdgeView(), source, options);
+    for (CsrGraph::VertexId v = 0; v < search.hops.size(); ++v) {
+        if (v != source && search.hops[v] != HopSearchResult::kUnreached) {
+            result.emplace(csr->name(v), search.hops[v]);
         }
     }
-
     return result;
 }
 
-// Perform random walk on the graph
-std::vector<std::string> Graph::randomWalk() {
-    if (adjacencyList.empty()) {
-        return {}; // Empty graph
+// Full breadth-first search from one word
+std::vector<std::string> Graph::reachableSet(const std::string& word) const {
+    std::vector<std::string> result;
+    std::shared_ptr<const CsrGraph> csr = csrView();
+    CsrGraph::VertexId source = 0;
+    if (!csr->findVertex(normalizeWord(word), source)) {
+        return result;
     }
-    std::vector<std::string> path;
-    std::set<std::pair<std::string, std::string>> visitedEdges;
-    // Choose a random starting vertex
-    std::vector<std::string> vertices;
-    vertices.reserve(adjacencyList.size()); // 预分配容量
+    HopSearchOptions options;
+    options.threads = pathThreads;
+    HopSearchResult search = hopSearch(*csr, *inEdgeView(), source, options);
+    result.reserve(search.reached);
+    for (CsrGraph::VertexId v = 0; v < search.hops.size(); ++v) {
+        if (v != source && search.hops[v] != HopSearchResult::kUnreached) {
+            result.push_back(csr->name(v));
+        }
+    }
+    // IDs follow the words alphabetically unless the view was renumbered
+    if (vertexOrder != VertexOrder::Lexicographic) {
+        std::sort(result.begin(), result.end());
+    }
+    return result;
+}
+
+// Change the memory budget of the shortest-path tree cache, evicting trees as needed
+void Graph::setPathCacheBudget(size_t bytes) {
+    pathCache->setMemoryBudget(bytes);
+}
+
+// Choose between sequential Dijkstra and parallel delta-stepping for new path trees
+void Graph::setPathThreads(unsigned threads, uint32_t delta) {
+    pathThreads = threads;
+    pathDelta = delta;
+}
+
+void Graph::setRankThreads(unsigned threads) {
+    rankThreads = threads;
+}
+
+// Number of distinct words in the graph
+size_t Graph::vertexCount() const {
+    return adjacencyList.size();
+}
+
+// Number of distinct directed edges (word pairs)
+size_t Graph::edgeCount() const {
+    size_t count = 0;
     for (const auto& entry : adjacencyList) {
-        vertices.push_back(entry.first);
+        count += entry.second.size();
     }
-    std::uniform_int_distribution<size_t> dist(0, vertices.size() - 1);
-    std::string current = vertices[dist(rng)];
-    path.push_back(current);
-    while (true) {
-        // Check if current vertex has outgoing edges
-        if (adjacencyList.at(current).empty()) {
-            break; // Stop if no outgoing edges
-        }
-        // Choose a random outgoing edge
-        const std::vector<Edge>& edges = adjacencyList.at(current);
-        std::uniform_int_distribution<size_t> edgeDist(0, edges.size() - 1);
-        const Edge& edge = edges[edgeDist(rng)];
-        // Check if this edge has been visited
-        std::pair<std::string, std::string> edgePair = { current, edge.dest };
-        if (visitedEdges.find(edgePair) != visitedEdges.end()) {
-            break; // Stop if edge already visited
+    return count;
+}
+
+// Heap bytes owned by a string, 0 when it lives in the small-string buffer
+static size_t stringHeapBytes(const std::string& s) {
+    const char* object = reinterpret_cast<const char*>(&s);
+    if (s.data() >= object && s.data() < object + sizeof(std::string)) {
+        return 0;
+    }
+    return s.capacity() + 1;
+}
+
+// Estimate the heap footprint of the adjacency list component by component, plus whatever
+// derived views are currently built (peek never builds one just to measure it)
+MemoryStats Graph::estimateMemory() const {
+    // libstdc++/libc++ tree nodes carry color + 3 pointers ahead of the value
+    const size_t nodeHeader = sizeof(void*) * 4;
+    MemoryStats memory;
+    for (const auto& entry : adjacencyList) {
+        memory.mapNodes += nodeHeader + sizeof(std::pair<const std::string, std::vector<Edge>>);
+        memory.vertexStrings += stringHeapBytes(entry.first);
+        memory.edgeArrays += entry.second.capacity() * sizeof(Edge);
+        for (const Edge& edge : entry.second) {
+            memory.edgeStrings += stringHeapBytes(edge.dest);
         }
-        // Add edge to visited and add destination to path
-        visitedEdges.insert(edgePair);
-        current = edge.dest;
-        path.push_back(current);
     }
-    return path;
+
+    if (std::shared_ptr<const CsrGraph> csr = csrCache.peek(version)) {
+        memory.csrView = csr->memoryBytes();
+    }
+    if (std::shared_ptr<const CsrGraph> inEdges = inEdgeCache.peek(version)) {
+        memory.inEdgeView = inEdges->memoryBytes();
+    }
+    if (std::shared_ptr<const ReachabilityIndex> reachability = reachabilityCache.peek(version)) {
+        memory.reachability = reachability->memoryBytes();
+    }
+    if (std::shared_ptr<const SparseMatrix> matrix = matrixCache.peek(version)) {
+        memory.rankMatrix = matrix->memoryBytes();
+    }
+    if (std::shared_ptr<const NegativeLogProbabilityCost> costs = logProbabilityCache.peek(version)) {
+        memory.logProbabilityCosts = costs->memoryBytes();
+    }
+    memory.pathTrees = pathCache->stats().bytes;
+    return memory;
 }
 
-// Check if a word exists in the graph
-bool Graph::containsWord(const std::string& word) const {
-    std::string normalizedWord = normalizeWord(word);
-    return adjacencyList.find(normalizedWord) != adjacencyList.end();
+// Snapshot sizes, memory estimate, build timings and query counters
+GraphStats Graph::stats() const {
+    GraphStats result;
+    result.vertices = vertexCount();
+    result.edges = edgeCount();
+    result.build = buildStats;
+    result.memory = estimateMemory();
+    result.pathCache = pathCache->stats();
+
+    QueryStats& q = result.queries;
+    q.shortestPathCalls = queryCounters.shortestPathCalls.load();
+    q.lastVerticesSettled = queryCounters.lastVerticesSettled.load();
+    q.lastEdgesRelaxed = queryCounters.lastEdgesRelaxed.load();
+    q.totalVerticesSettled = queryCounters.totalVerticesSettled.load();
+    q.totalEdgesRelaxed = queryCounters.totalEdgesRelaxed.load();
+    q.pageRankCalls = queryCounters.pageRankCalls.load();
+    q.lastPageRankIterations = queryCounters.lastPageRankIterations.load();
+    q.lastPageRankResidual = queryCounters.lastPageRankResidual.load();
+    q.randomWalkCalls = queryCounters.randomWalkCalls.load();
+    q.lastRandomWalkSteps = queryCounters.lastRandomWalkSteps.load();
+    q.totalRandomWalkSteps = queryCounters.totalRandomWalkSteps.load();
+    return result;
 }
 
 // // Get all vertices (words) in the graph
@@ -374,7 +799,7 @@ bool Graph::containsWord(const std::string& word) const {
 
 // Calculate PageRank with custom initial ranks
 std::map<std::string, double> Graph::calculatePageRank(double dampingFactor, 
-    std::map<std::string, double> customInitialRanks, int iterations) const {
+    std::map<std::string, double> customInitialRanks, int iterations, JobControl* control) const {
     std::map<std::string, double> pageRank;
 
     // Initialize PageRank values - use custom ranks if provided, or default to uniform distribution
@@ -403,75 +828,76 @@ std::map<std::string, double> Graph::calculatePageRank(double dampingFactor,
     else {
         // Use traditional uniform distribution
         double initialRank = 1.0 / static_cast<double>(adjacencyList.size());
-        printf("initialRank: %f\n", initialRank);
+        // Background jobs (control set) must not write over the interactive prompt
+        if (control == nullptr) {
+            printf("initialRank: %f\n", initialRank);
+        }
         for (const auto& entry : adjacencyList) {
             pageRank[entry.first] = initialRank;
         }
     }
 
-    // Get the total number of vertices in the graph
-    size_t totalVertices = adjacencyList.size();
-
-    // Iterate to refine PageRank values
-    for (int i = 0; i < iterations; ++i) {
-        std::map<std::string, double> newRank;
-        double danglingSum = 0.0;
-
-        // Initialize new ranks with (1-d)/N
-        double baseRank = (1.0 - dampingFactor) / static_cast<double>(totalVertices);
-        for (const auto& entry : adjacencyList) {
-            newRank[entry.first] = baseRank;
-        }
-
-        // First, collect the sum of PageRank values from dangling nodes (nodes with no outgoing edges)
-        for (const auto& entry : adjacencyList) {
-            const std::string& vertex = entry.first;
-            const std::vector<Edge>& edges = entry.second;
-
-            if (edges.empty()) {
-                // This is a dangling node, add its contribution to danglingSum
-                danglingSum += pageRank[vertex];
-            }
-        }
-
-        // Distribute the dangling node PageRank values evenly to all vertices
-        double danglingContribution = dampingFactor * danglingSum / static_cast<double>(totalVertices);
-        for (auto& entry : newRank) {
-            entry.second += danglingContribution;
-        }
+    // Iterate on the shared matrix engine; csrView() numbers the words, byWord() maps back
+    std::shared_ptr<const CsrGraph> csr = csrView();
+    std::vector<double> start(csr->vertexCount());
+    for (CsrGraph::VertexId v = 0; v < csr->vertexCount(); ++v) {
+        start[v] = pageRank[csr->name(v)];
+    }
+    IterationOptions options;
+    options.maxIterations = iterations;
+    options.threads = rankThreads;
+    IterationResult result = pageRankScores(*rankMatrix(), dampingFactor, std::move(start), options, control);
+
+    TG_STAT(queryCounters.pageRankCalls.add(1));
+    TG_STAT(queryCounters.lastPageRankIterations.store(static_cast<uint64_t>(result.iterations)));
+    TG_STAT(queryCounters.lastPageRankResidual.store(result.residual));
+    if (result.values.empty()) {
+        return std::map<std::string, double>(); // stopped by the job control
+    }
+    return byWord(result.values);
+}
 
-        // Calculate influence from each non-dangling vertex
-        for (const auto& entry : adjacencyList) {
-            const std::string& vertex = entry.first;
-            const std::vector<Edge>& edges = entry.second;
-
-            if (!edges.empty()) {
-                // Calculate total weight of outgoing edges
-                double totalWeight = 0;
-                for (const Edge& edge : edges) {
-                    totalWeight += edge.weight;
-                }
-
-                // Distribute rank to neighbors
-                for (const Edge& edge : edges) {
-                    double contribution = dampingFactor * pageRank[vertex] * (edge.weight / totalWeight);
-                    newRank[edge.dest] += contribution;
-                }
-            }
-        }
+// HITS hub and authority scores on the shared matrix engine
+std::pair<std::map<std::string, double>, std::map<std::string, double>> Graph::calculateHits(int iterations,
+    JobControl* control) const {
+    IterationOptions options;
+    options.maxIterations = iterations;
+    options.tolerance = 1e-12;
+    options.threads = rankThreads;
+    HitsResult result = hitsScores(*rankMatrix(), options, control);
+    if (result.authorities.values.empty()) {
+        return std::pair<std::map<std::string, double>, std::map<std::string, double>>();
+    }
+    return std::make_pair(byWord(result.hubs), byWord(result.authorities.values));
+}
 
-        // Update PageRank values
-        pageRank = newRank;
+// Katz centrality on the shared matrix engine
+std::map<std::string, double> Graph::calculateKatz(double alpha, int iterations, JobControl* control) const {
+    IterationOptions options;
+    options.maxIterations = iterations;
+    options.tolerance = 1e-12;
+    options.threads = rankThreads;
+    IterationResult result = katzScores(*rankMatrix(), alpha, 1.0, options, control);
+    if (result.values.empty()) {
+        return std::map<std::string, double>();
     }
+    return byWord(result.values);
+}
 
-    return pageRank;
+// Key a per-ID vector of the CSR view by word
+std::map<std::string, double> Graph::byWord(const std::vector<double>& values) const {
+    std::shared_ptr<const CsrGraph> csr = csrView();
+    std::map<std::string, double> result;
+    for (CsrGraph::VertexId v = 0; v < values.size(); ++v) {
+        result.emplace(csr->name(v), values[v]);
+    }
+    return result;
 }
 
 // Helper function to calculate TF-IDF initial ranks
 std::map<std::string, double> Graph::calculateTfIdfRanks(const std::string& filePath) const {
     std::map<std::string, double> tfIdfRanks;
-    std::map<std::string, int> termFrequency; // Term frequency
-    std::map<std::string, int> docFrequency;  // Document frequency
+    std::map<std::string, TermCounts> counts; // Term and document frequency
 
     // Use the original text to calculate TF-IDF
     std::ifstream file(filePath);
@@ -541,17 +967,29 @@ std::map<std::string, double> Graph::calculateTfIdfRanks(const std::string& file
         while (ss >> word) {
             std::string normalizedWord = normalizeWord(word);
             if (!normalizedWord.empty()) {
-                termFrequency[normalizedWord]++;
+                counts[normalizedWord].termFrequency++;
                 uniqueWordsInDoc.insert(normalizedWord);
             }
         }
 
         // Update document frequency
         for (const auto& uniqueWord : uniqueWordsInDoc) {
-            docFrequency[uniqueWord]++;
+            counts[uniqueWord].documentFrequency++;
         }
     }
 
+    return tfIdfFromCounts(counts, numDocs);
+}
+
+// TF-IDF from the document counts recorded while the graph was built
+std::map<std::string, double> Graph::calculateTfIdfRanks() const {
+    return tfIdfFromCounts(corpusTerms, static_cast<size_t>(buildStats.documents));
+}
+
+// Turn term/document frequencies into initial ranks that sum to 1
+std::map<std::string, double> Graph::tfIdfFromCounts(const std::map<std::string, TermCounts>& counts, size_t numDocs) const {
+    std::map<std::string, double> tfIdfRanks;
+
     // Calculate TF-IDF for each word
     for (const auto& entry : adjacencyList) {
         const std::string& vertex = entry.first;
@@ -559,12 +997,13 @@ std::map<std::string, double> Graph::calculateTfIdfRanks(const std::string& file
         // Default value for cases where TF-IDF calculation isn't reliable
         double tfidf = 0.5; // Start with a reasonable default
 
-        if (termFrequency.find(vertex) != termFrequency.end()) {
-            auto tf = static_cast<double>(termFrequency[vertex]);
+        auto found = counts.find(vertex);
+        if (found != counts.end() && found->second.termFrequency > 0) {
+            auto tf = static_cast<double>(found->second.termFrequency);
 
             // Avoid division by zero and log(1) = 0 issues
-            if (docFrequency.find(vertex) != docFrequency.end() && docFrequency[vertex] > 0 && numDocs > 1) {
-                double idf = log(static_cast<double>(numDocs) / docFrequency[vertex]);
+            if (found->second.documentFrequency > 0 && numDocs > 1) {
+                double idf = log(static_cast<double>(numDocs) / static_cast<double>(found->second.documentFrequency));
                 tfidf = tf * idf;
             }
             else {
@@ -590,7 +1029,6 @@ std::map<std::string, double> Graph::calculateTfIdfRanks(const std::string& file
     if (sum > 0) {
         for (auto& entry : tfIdfRanks) {
             entry.second /= sum;
-            printf("\"%s\" TF-IDF initialRank: %f\n", entry.first.c_str(), entry.second);
         }
     }
     else {
@@ -604,10 +1042,30 @@ std::map<std::string, double> Graph::calculateTfIdfRanks(const std::string& file
     return tfIdfRanks;
 }
 
+// Echo the TF-IDF start vector, unless a background job (control set) is running
+static void printTfIdfRanks(const std::map<std::string, double>& tfIdfRanks, const JobControl* control) {
+    if (control != nullptr) {
+        return;
+    }
+    for (const auto& entry : tfIdfRanks) {
+        printf("\"%s\" TF-IDF initialRank: %f\n", entry.first.c_str(), entry.second);
+    }
+}
+
 // Calculate PageRank with TF-IDF as initial ranks
 std::map<std::string, double> Graph::calculatePageRankWithTfIdf(const std::string& filePath,
     double dampingFactor,
-    int iterations) const {
+    int iterations,
+    JobControl* control) const {
     std::map<std::string, double> tfIdfRanks = calculateTfIdfRanks(filePath);
-    return calculatePageRank(dampingFactor, tfIdfRanks, iterations);
+    printTfIdfRanks(tfIdfRanks, control);
+    return calculatePageRank(dampingFactor, tfIdfRanks, iterations, control);
+}
+
+// Calculate PageRank with TF-IDF of the ingested documents as initial ranks
+std::map<std::string, double> Graph::calculatePageRankWithTfIdf(double dampingFactor, int iterations,
+    JobControl* control) const {
+    std::map<std::string, double> tfIdfRanks = calculateTfIdfRanks();
+    printTfIdfRanks(tfIdfRanks, control);
+    return calculatePageRank(dampingFactor, tfIdfRanks, iterations, control);
 }
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "../include/GraphBuilder.h"
+#include "../include/PerfectHash.h"
+#include <cstring>
+
+const size_t StringArena::kBlockSize;
+const uint32_t GraphBuilder::kNoWord;
+
+// Tables start with this many slots and double once they are half full
+static const size_t kInitialSlots = 1024;
+
+const char* StringArena::store(const char* data, size_t length) {
+    if (length > left) {
+        // Oversized words get a block of their own so the current block keeps its space
+        size_t size = std::max(kBlockSize, length);
+        blocks.push_back(std::unique_ptr<char[]>(new char[size]));
+        if (size > kBlockSize) {
+            used += length;
+            std::memcpy(blocks.back().get(), data, length);
+            return blocks.back().get();
+        }
+        cursor = blocks.back().get();
+        left = size;
+    }
+    char* copy = cursor;
+    std::memcpy(copy, data, length);
+    cursor += length;
+    left -= length;
+    used += length;
+    return copy;
+}
+
+GraphBuilder::GraphBuilder() : wordSlots(kInitialSlots, kNoWord), edgeSlots(kInitialSlots, kNoWord) {}
+
+uint32_t GraphBuilder::intern(const char* data, size_t length) {
+    uint64_t hash = PerfectHash::hashKey(data, length);
+    const size_t mask = wordSlots.size() - 1;
+    for (size_t slot = static_cast<size_t>(hash) & mask;; slot = (slot + 1) & mask) {
+        uint32_t id = wordSlots[slot];
+        if (id == kNoWord) {
+            Word entry;
+            entry.data = arena.store(data, length);
+            entry.length = static_cast<uint32_t>(length);
+            entry.hash = hash;
+            id = static_cast<uint32_t>(words.size());
+            words.push_back(entry);
+            wordSlots[slot] = id;
+            if (words.size() * 2 > wordSlots.size()) {
+                growWords();
+            }
+            return id;
+        }
+        const Word& candidate = words[id];
+        if (candidate.hash == hash && candidate.length == length && std::memcmp(candidate.data, data, length) == 0) {
+            return id;
+        }
+    }
+}
+
+void GraphBuilder::addEdge(uint32_t src, uint32_t dest, uint32_t weight) {
+    size_t slot = findEdgeSlot(src, dest);
+    if (edgeSlots[slot] != kNoWord) {
+        edges[edgeSlots[slot]].weight += weight;
+        return;
+    }
+    EdgeEntry entry;
+    entry.src = src;
+    entry.dest = dest;
+    entry.weight = weight;
+    edgeSlots[slot] = static_cast<uint32_t>(edges.size());
+    edges.push_back(entry);
+    if (edges.size() * 2 > edgeSlots.size()) {
+        growEdges();
+    }
+}
+
+uint32_t GraphBuilder::weight(uint32_t src, uint32_t dest) const {
+    size_t slot = findEdgeSlot(src, dest);
+    return edgeSlots[slot] == kNoWord ? 0 : edges[edgeSlots[slot]].weight;
+}
+
+// splitmix64 finalizer over the packed pair, so consecutive IDs spread over the table
+uint64_t GraphBuilder::edgeHash(uint32_t src, uint32_t dest) {
+    uint64_t x = (static_cast<uint64_t>(src) << 32) | dest;
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Slot holding src -> dest, or the free slot where it belongs
+size_t GraphBuilder::findEdgeSlot(uint32_t src, uint32_t dest) const {
+    const size_t mask = edgeSlots.size() - 1;
+    for (size_t slot = static_cast<size_t>(edgeHash(src, dest)) & mask;; slot = (slot + 1) & mask) {
+        uint32_t index = edgeSlots[slot];
+        if (index == kNoWord || (edges[index].src == src && edges[index].dest == dest)) {
+            return slot;
+        }
+    }
+}
+
+void GraphBuilder::growWords() {
+    wordSlots.assign(wordSlots.size() * 2, kNoWord);
+    const size_t mask = wordSlots.size() - 1;
+    for (uint32_t id = 0; id < words.size(); ++id) {
+        size_t slot = static_cast<size_t>(words[id].hash) & mask;
+        while (wordSlots[slot] != kNoWord) {
+            slot = (slot + 1) & mask;
+        }
+        wordSlots[slot] = id;
+    }
+}
+
+void GraphBuilder::growEdges() {
+    edgeSlots.assign(edgeSlots.size() * 2, kNoWord);
+    const size_t mask = edgeSlots.size() - 1;
+    for (uint32_t index = 0; index < edges.size(); ++index) {
+        size_t slot = static_cast<size_t>(edgeHash(edges[index].src, edges[index].dest)) & mask;
+        while (edgeSlots[slot] != kNoWord) {
+            slot = (slot + 1) & mask;
+        }
+        edgeSlots[slot] = index;
+    }
+}
+
+void GraphBuilder::fill(std::map<std::string, std::vector<Graph::Edge>>& adjacency) const {
+    // Group the edges by source with a stable counting sort, keeping first-seen order
+    std::vector<uint32_t> offsets(words.size() + 1, 0);
+    std::vector<bool> linked(words.size(), false);
+    for (const EdgeEntry& edge : edges) {
+        offsets[edge.src + 1]++;
+        linked[edge.src] = true;
+        linked[edge.dest] = true;
+    }
+    for (size_t id = 0; id < words.size(); ++id) {
+        offsets[id + 1] += offsets[id];
+    }
+    std::vector<uint32_t> bySource(edges.size());
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (uint32_t index = 0; index < edges.size(); ++index) {
+        bySource[cursor[edges[index].src]++] = index;
+    }
+
+    // Words in map order, so every insertion is a hinted append
+    std::vector<std::string> names(words.size());
+    std::vector<uint32_t> order;
+    order.reserve(words.size());
+    for (uint32_t id = 0; id < words.size(); ++id) {
+        if (linked[id]) {
+            names[id] = word(id);
+            order.push_back(id);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&names](uint32_t a, uint32_t b) { return names[a] < names[b]; });
+    for (uint32_t id : order) {
+        std::vector<Graph::Edge>& row = adjacency.emplace_hint(adjacency.end(), names[id], std::vector<Graph::Edge>())->second;
+        row.reserve(offsets[id + 1] - offsets[id]);
+        for (uint32_t i = offsets[id]; i < offsets[id + 1]; ++i) {
+            const EdgeEntry& edge = edges[bySource[i]];
+            row.emplace_back(names[edge.dest], static_cast<int>(edge.weight));
+        }
+    }
+}
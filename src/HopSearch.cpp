@@ -0,0 +1,188 @@
+#include "../include/HopSearch.h"
+#include "../include/Parallel.h"
+#include <atomic>
+
+const uint32_t HopSearchResult::kUnreached;
+
+namespace {
+
+typedef CsrGraph::VertexId VertexId;
+
+// Frontier vertices per top-down work item, bitmap words (64 vertices each) per bottom-up
+// work item, and the smallest step worth waking the workers for
+const size_t kChunk = 256;
+const size_t kBlockWords = 16;
+const size_t kParallelFrontier = 4 * kChunk;
+
+inline bool testBit(const std::vector<uint64_t>& bits, VertexId v) {
+    return (bits[v >> 6] >> (v & 63)) & 1;
+}
+
+class HopSearcher {
+public:
+    HopSearcher(const CsrGraph& g, const CsrGraph& in, const HopSearchOptions& o)
+        : graph(g), inEdges(in), options(o), n(g.vertexCount()), words((n + 63) / 64), visited(words),
+          workers(o.threads), local(workers.size()) {
+        for (std::atomic<uint64_t>& word : visited) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void run(VertexId source, HopSearchResult& result) {
+        result.hops.assign(n, HopSearchResult::kUnreached);
+        if (source >= n) {
+            return;
+        }
+        hops = &result.hops;
+        visited[source >> 6].store(uint64_t(1) << (source & 63), std::memory_order_relaxed);
+        (*hops)[source] = 0;
+        result.reached = 1;
+        queue.assign(1, source);
+
+        bool bottomUp = false;
+        size_t frontierSize = 1;
+        uint64_t frontierEdges = graph.outDegree(source);
+        uint64_t unexploredEdges = graph.edgeCount() - frontierEdges;
+        for (uint32_t level = 1; frontierSize > 0 && level <= options.maxHops; ++level) {
+            if (options.target != CsrGraph::kNoVertex && (*hops)[options.target] != HopSearchResult::kUnreached) {
+                break;
+            }
+            if (!bottomUp && static_cast<double>(frontierEdges) > static_cast<double>(unexploredEdges) / options.alpha) {
+                queueToBits();
+                bottomUp = true;
+            }
+            else if (bottomUp && static_cast<double>(frontierSize) < static_cast<double>(n) / options.beta) {
+                bitsToQueue();
+                bottomUp = false;
+            }
+
+            uint64_t nextSize = 0, nextEdges = 0;
+            if (bottomUp) {
+                bottomUpStep(level, nextSize, nextEdges);
+                result.bottomUpSteps++;
+            }
+            else {
+                topDownStep(level, nextSize, nextEdges);
+                result.topDownSteps++;
+            }
+            result.levels++;
+            result.reached += nextSize;
+            unexploredEdges -= std::min(unexploredEdges, nextEdges);
+            frontierSize = nextSize;
+            frontierEdges = nextEdges;
+        }
+    }
+
+private:
+    const CsrGraph& graph;
+    const CsrGraph& inEdges;
+    const HopSearchOptions& options;
+    const size_t n;
+    const size_t words;
+    std::vector<std::atomic<uint64_t>> visited;
+    std::vector<uint32_t>* hops = nullptr;
+    std::vector<VertexId> queue;          // sparse frontier (top-down)
+    std::vector<uint64_t> frontierBits;   // dense frontier (bottom-up)
+    std::vector<uint64_t> nextBits;
+    WorkerPool workers; // one set of threads for every level of this search
+    std::vector<std::vector<VertexId>> local; // per-worker output of a top-down step
+
+    // Push the queued frontier along out-edges; the first worker to set a vertex's visited
+    // bit owns it and writes its hop count
+    void topDownStep(uint32_t level, uint64_t& nextSize, uint64_t& nextEdges) {
+        std::atomic<uint64_t> edges(0);
+        workers.forEachWorker((queue.size() + kChunk - 1) / kChunk, queue.size() >= kParallelFrontier,
+            [&](size_t chunk, unsigned worker) {
+                std::vector<VertexId>& out = local[worker];
+                uint64_t found = 0;
+                size_t end = std::min(queue.size(), (chunk + 1) * kChunk);
+                for (size_t i = chunk * kChunk; i < end; ++i) {
+                    for (const VertexId* t = graph.targetsBegin(queue[i]); t != graph.targetsEnd(queue[i]); ++t) {
+                        uint64_t bit = uint64_t(1) << (*t & 63);
+                        std::atomic<uint64_t>& word = visited[*t >> 6];
+                        if ((word.load(std::memory_order_relaxed) & bit) != 0 ||
+                            (word.fetch_or(bit, std::memory_order_relaxed) & bit) != 0) {
+                            continue;
+                        }
+                        (*hops)[*t] = level;
+                        out.push_back(*t);
+                        found += graph.outDegree(*t);
+                    }
+                }
+                edges.fetch_add(found, std::memory_order_relaxed);
+            });
+        queue.clear();
+        for (std::vector<VertexId>& out : local) {
+            queue.insert(queue.end(), out.begin(), out.end());
+            out.clear();
+        }
+        nextSize = queue.size();
+        nextEdges = edges.load();
+    }
+
+    // Every unvisited vertex looks for a predecessor in the frontier bitmap. A work item owns
+    // whole bitmap words, so it updates visited and the next frontier without contention
+    void bottomUpStep(uint32_t level, uint64_t& nextSize, uint64_t& nextEdges) {
+        std::atomic<uint64_t> size(0), edges(0);
+        nextBits.assign(words, 0);
+        workers.forEach((words + kBlockWords - 1) / kBlockWords, n >= kParallelFrontier, [&](size_t block) {
+            uint64_t count = 0, found = 0;
+            size_t end = std::min(words, (block + 1) * kBlockWords);
+            for (size_t w = block * kBlockWords; w < end; ++w) {
+                uint64_t seen = visited[w].load(std::memory_order_relaxed);
+                uint64_t unseen = ~seen;
+                if (w == words - 1 && n % 64 != 0) {
+                    unseen &= (uint64_t(1) << (n % 64)) - 1;
+                }
+                uint64_t added = 0;
+                for (; unseen != 0; unseen &= unseen - 1) {
+                    VertexId v = static_cast<VertexId>(w * 64 + static_cast<size_t>(__builtin_ctzll(unseen)));
+                    for (const VertexId* p = inEdges.targetsBegin(v); p != inEdges.targetsEnd(v); ++p) {
+                        if (testBit(frontierBits, *p)) {
+                            added |= uint64_t(1) << (v & 63);
+                            (*hops)[v] = level;
+                            count++;
+                            found += graph.outDegree(v);
+                            break;
+                        }
+                    }
+                }
+                if (added != 0) {
+                    visited[w].store(seen | added, std::memory_order_relaxed);
+                    nextBits[w] = added;
+                }
+            }
+            size.fetch_add(count, std::memory_order_relaxed);
+            edges.fetch_add(found, std::memory_order_relaxed);
+        });
+        frontierBits.swap(nextBits);
+        nextSize = size.load();
+        nextEdges = edges.load();
+    }
+
+    void queueToBits() {
+        frontierBits.assign(words, 0);
+        for (VertexId v : queue) {
+            frontierBits[v >> 6] |= uint64_t(1) << (v & 63);
+        }
+    }
+
+    void bitsToQueue() {
+        queue.clear();
+        for (size_t w = 0; w < words; ++w) {
+            for (uint64_t bits = frontierBits[w]; bits != 0; bits &= bits - 1) {
+                queue.push_back(static_cast<VertexId>(w * 64 + static_cast<size_t>(__builtin_ctzll(bits))));
+            }
+        }
+    }
+};
+
+} // namespace
+
+HopSearchResult hopSearch(const CsrGraph& graph, const CsrGraph& inEdges, CsrGraph::VertexId source,
+    const HopSearchOptions& options) {
+    HopSearchResult result;
+    HopSearcher searcher(graph, inEdges, options);
+    searcher.run(source, result);
+    return result;
+}
@@ -0,0 +1,120 @@
+#include "../include/Jobs.h"
+
+static int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void JobControl::setDeadline(std::chrono::milliseconds timeout) {
+    if (timeout.count() <= 0) {
+        deadlineNs.store(0);
+        return;
+    }
+    deadlineNs.store(steadyNowNs() + std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count());
+}
+
+bool JobControl::deadlinePassed() const {
+    int64_t deadline = deadlineNs.load();
+    return deadline != 0 && steadyNowNs() >= deadline;
+}
+
+bool JobControl::shouldStop() const {
+    if (cancelRequested() || deadlinePassed()) {
+        stopSeen.store(true);
+        return true;
+    }
+    return false;
+}
+
+const char* jobStateName(JobState state) {
+    switch (state) {
+    case JobState::Running:
+        return "running";
+    case JobState::Finished:
+        return "finished";
+    case JobState::Cancelled:
+        return "cancelled";
+    case JobState::TimedOut:
+        return "timed out";
+    }
+    return "unknown";
+}
+
+Job::Job(int id, std::string description, std::chrono::milliseconds deadline,
+    std::function<bool(JobControl&)> work, std::function<void()> presentResult)
+    : jobId(id), text(std::move(description)), present(std::move(presentResult)),
+      currentState(static_cast<int>(JobState::Running)), started(std::chrono::steady_clock::now()), finishedNs(0) {
+    jobControl.setDeadline(deadline);
+    worker = std::thread([this, work]() {
+        bool completed = work(jobControl);
+        JobState outcome = completed ? JobState::Finished
+                         : jobControl.cancelRequested() ? JobState::Cancelled : JobState::TimedOut;
+        finishedNs.store(steadyNowNs());
+        currentState.store(static_cast<int>(outcome));
+    });
+}
+
+Job::~Job() {
+    cancel();
+    wait();
+}
+
+void Job::wait() {
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+double Job::elapsedSeconds() const {
+    int64_t end = finishedNs.load();
+    int64_t begin = std::chrono::duration_cast<std::chrono::nanoseconds>(started.time_since_epoch()).count();
+    return static_cast<double>((end != 0 ? end : steadyNowNs()) - begin) / 1e9;
+}
+
+JobManager::~JobManager() {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const std::shared_ptr<Job>& job : jobs) {
+        job->cancel();
+    }
+    for (const std::shared_ptr<Job>& job : jobs) {
+        job->wait();
+    }
+}
+
+std::shared_ptr<Job> JobManager::start(const std::string& description, std::chrono::milliseconds deadline,
+    std::function<bool(JobControl&)> work, std::function<void()> presentResult) {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<Job> job = std::make_shared<Job>(nextId++, description, deadline, std::move(work), std::move(presentResult));
+    jobs.push_back(job);
+    return job;
+}
+
+std::shared_ptr<Job> JobManager::find(int id) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const std::shared_ptr<Job>& job : jobs) {
+        if (job->id() == id) {
+            return job;
+        }
+    }
+    return std::shared_ptr<Job>();
+}
+
+std::vector<std::shared_ptr<Job>> JobManager::list() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return jobs;
+}
+
+bool JobManager::remove(int id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::vector<std::shared_ptr<Job>>::iterator it = jobs.begin(); it != jobs.end(); ++it) {
+        if ((*it)->id() == id) {
+            if ((*it)->state() == JobState::Running) {
+                return false;
+            }
+            (*it)->wait();
+            jobs.erase(it);
+            return true;
+        }
+    }
+    return false;
+}
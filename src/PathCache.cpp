@@ -0,0 +1,248 @@
+#include "../include/PathCache.h"
+#include "../include/EdgeCost.h"
+#include "../include/Jobs.h"
+
+// Settled vertices between two looks at the job control
+static const uint64_t kControlInterval = 4096;
+
+std::vector<std::string> ShortestPathTree::pathTo(const CsrGraph& graph, CsrGraph::VertexId target) const {
+    std::vector<std::string> path;
+    if (distance[target] == std::numeric_limits<double>::infinity()) {
+        return path;
+    }
+    // Count the words first so the path is allocated once and filled back to front
+    size_t length = 1;
+    for (CsrGraph::VertexId v = target; v != source; v = parent[v]) {
+        length++;
+    }
+    path.resize(length);
+    for (CsrGraph::VertexId v = target; length > 0; v = parent[v]) {
+        path[--length] = graph.name(v);
+    }
+    return path;
+}
+
+template <class Cost>
+ShortestPathTree buildShortestPathTree(const CsrGraph& graph, CsrGraph::VertexId source, const Cost& cost, JobControl* control,
+    CsrGraph::VertexId target) {
+    typedef CsrGraph::VertexId VertexId;
+    typedef std::pair<double, VertexId> QueueEntry;
+
+    ShortestPathTree tree;
+    tree.source = source;
+    tree.cost = Cost::kind;
+    tree.distance.assign(graph.vertexCount(), std::numeric_limits<double>::infinity());
+    tree.parent.assign(graph.vertexCount(), CsrGraph::kNoVertex);
+    std::vector<bool> settled(graph.vertexCount(), false);
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+
+    tree.distance[source] = 0;
+    queue.push(QueueEntry(0.0, source));
+    while (!queue.empty()) {
+        VertexId current = queue.top().second;
+        queue.pop();
+        if (settled[current]) {
+            continue;
+        }
+        settled[current] = true;
+        tree.settled++;
+        if (current == target) {
+            tree.complete = false;
+            return tree;
+        }
+        if (control != nullptr && tree.settled % kControlInterval == 0) {
+            control->reportProgress(tree.settled, graph.vertexCount());
+            if (control->shouldStop()) {
+                tree.complete = false;
+                return tree;
+            }
+        }
+
+        const VertexId* next = graph.targetsBegin(current);
+        const VertexId* end = graph.targetsEnd(current);
+        const uint32_t* weight = graph.weightsBegin(current);
+        uint32_t edge = graph.rowOffsets()[current];
+        for (; next != end; ++next, ++weight, ++edge) {
+            if (settled[*next]) {
+                continue;
+            }
+            tree.relaxed++;
+            double alt = tree.distance[current] + cost(edge, *weight);
+            if (alt < tree.distance[*next]) {
+                tree.distance[*next] = alt;
+                tree.parent[*next] = current;
+                queue.push(QueueEntry(alt, *next));
+            }
+        }
+    }
+    if (control != nullptr) {
+        control->reportProgress(graph.vertexCount(), graph.vertexCount());
+    }
+    return tree;
+}
+
+ShortestPathTree buildShortestPathTree(const CsrGraph& graph, CsrGraph::VertexId source, JobControl* control,
+    CsrGraph::VertexId target) {
+    return buildShortestPathTree(graph, source, CountCost(), control, target);
+}
+
+template ShortestPathTree buildShortestPathTree<CountCost>(const CsrGraph&, CsrGraph::VertexId, const CountCost&, JobControl*,
+    CsrGraph::VertexId);
+template ShortestPathTree buildShortestPathTree<InverseFrequencyCost>(const CsrGraph&, CsrGraph::VertexId,
+    const InverseFrequencyCost&, JobControl*, CsrGraph::VertexId);
+template ShortestPathTree buildShortestPathTree<NegativeLogProbabilityCost>(const CsrGraph&, CsrGraph::VertexId,
+    const NegativeLogProbabilityCost&, JobControl*, CsrGraph::VertexId);
+
+ShortestPathTree buildHopTree(const CsrGraph& graph, CsrGraph::VertexId source, JobControl* control, CsrGraph::VertexId target) {
+    typedef CsrGraph::VertexId VertexId;
+
+    ShortestPathTree tree;
+    tree.source = source;
+    tree.cost = PathCost::Hops;
+    tree.distance.assign(graph.vertexCount(), std::numeric_limits<double>::infinity());
+    tree.parent.assign(graph.vertexCount(), CsrGraph::kNoVertex);
+
+    // Dijkstra with unit costs settles a level in ID order and keeps the first parent to
+    // reach a vertex; sorting each level before expanding it reproduces exactly that
+    std::vector<VertexId> level(1, source), next;
+    tree.distance[source] = 0;
+    if (source == target) {
+        tree.complete = false;
+        return tree;
+    }
+    for (double depth = 1; !level.empty(); ++depth) {
+        std::sort(level.begin(), level.end());
+        for (VertexId current : level) {
+            tree.settled++;
+            if (control != nullptr && tree.settled % kControlInterval == 0) {
+                control->reportProgress(tree.settled, graph.vertexCount());
+                if (control->shouldStop()) {
+                    tree.complete = false;
+                    return tree;
+                }
+            }
+            for (const VertexId* reached = graph.targetsBegin(current); reached != graph.targetsEnd(current); ++reached) {
+                if (tree.distance[*reached] <= depth) {
+                    continue;
+                }
+                tree.relaxed++;
+                tree.distance[*reached] = depth;
+                tree.parent[*reached] = current;
+                if (*reached == target) {
+                    tree.complete = false;
+                    return tree;
+                }
+                next.push_back(*reached);
+            }
+        }
+        level.swap(next);
+        next.clear();
+    }
+    if (control != nullptr) {
+        control->reportProgress(graph.vertexCount(), graph.vertexCount());
+    }
+    return tree;
+}
+
+ShortestPathCache::ShortestPathCache(size_t memoryBudgetBytes)
+    : currentVersion(0), bytes(0), budget(memoryBudgetBytes), hits(0), misses(0), evictions(0) {}
+
+// Trees for different costs from the same source are separate entries
+static uint64_t cacheKey(CsrGraph::VertexId source, PathCost cost) {
+    return (static_cast<uint64_t>(cost) << 32) | source;
+}
+
+std::shared_ptr<const ShortestPathTree> ShortestPathCache::find(CsrGraph::VertexId source, uint64_t version, PathCost cost) {
+    std::lock_guard<std::mutex> lock(mutex);
+    syncVersionLocked(version);
+    std::unordered_map<uint64_t, LruList::iterator>::iterator it = bySource.find(cacheKey(source, cost));
+    if (it == bySource.end()) {
+        misses++;
+        return std::shared_ptr<const ShortestPathTree>();
+    }
+    hits++;
+    lru.splice(lru.begin(), lru, it->second);
+    return *it->second;
+}
+
+bool ShortestPathCache::seenBefore(CsrGraph::VertexId source, uint64_t version, PathCost cost) {
+    std::lock_guard<std::mutex> lock(mutex);
+    syncVersionLocked(version);
+    if (seen.size() >= kMaxSeen) {
+        seen.clear(); // forget one-off sources rather than grow without bound
+    }
+    return !seen.insert(cacheKey(source, cost)).second;
+}
+
+void ShortestPathCache::insert(const std::shared_ptr<const ShortestPathTree>& tree) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tree->version != currentVersion) {
+        if (tree->version < currentVersion) {
+            return; // computed against a graph that has changed since
+        }
+        dropAllLocked();
+        currentVersion = tree->version;
+    }
+    size_t treeBytes = tree->memoryBytes();
+    if (treeBytes > budget) {
+        return;
+    }
+
+    std::unordered_map<uint64_t, LruList::iterator>::iterator it = bySource.find(cacheKey(tree->source, tree->cost));
+    if (it != bySource.end()) {
+        bytes -= (*it->second)->memoryBytes();
+        lru.erase(it->second);
+        bySource.erase(it);
+    }
+    lru.push_front(tree);
+    bySource[cacheKey(tree->source, tree->cost)] = lru.begin();
+    bytes += treeBytes;
+    evictLocked();
+}
+
+void ShortestPathCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    dropAllLocked();
+}
+
+void ShortestPathCache::setMemoryBudget(size_t budgetBytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    budget = budgetBytes;
+    evictLocked();
+}
+
+PathCacheStats ShortestPathCache::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    PathCacheStats result;
+    result.hits = hits;
+    result.misses = misses;
+    result.evictions = evictions;
+    result.entries = lru.size();
+    result.bytes = bytes;
+    result.budgetBytes = budget;
+    return result;
+}
+
+void ShortestPathCache::dropAllLocked() {
+    lru.clear();
+    bySource.clear();
+    seen.clear();
+    bytes = 0;
+}
+
+// A lookup with another version means the graph changed: every cached tree is stale
+void ShortestPathCache::syncVersionLocked(uint64_t version) {
+    if (version != currentVersion) {
+        dropAllLocked();
+        currentVersion = version;
+    }
+}
+
+void ShortestPathCache::evictLocked() {
+    while (bytes > budget && !lru.empty()) {
+        bytes -= lru.back()->memoryBytes();
+        bySource.erase(cacheKey(lru.back()->source, lru.back()->cost));
+        lru.pop_back();
+        evictions++;
+    }
+}
@@ -0,0 +1,183 @@
+#include "../include/PerfectHash.h"
+#include "../include/BinaryIO.h"
+#include <algorithm>
+
+const uint32_t PerfectHash::kNotFound;
+
+// Average keys per bucket: larger buckets mean fewer displacements to store but a longer search
+static const size_t kKeysPerBucket = 5;
+// Keys per 100 slots. A completely full table makes the last buckets search through about
+// n / (free slots) shifts each, so the build grew faster than the key count; 10% spare slots
+// bound every search and cost under half a byte per key
+static const size_t kLoadPercent = 90;
+// Seeds tried before giving up; one almost always suffices
+static const unsigned kMaxSeeds = 8;
+
+// splitmix64 finalizer: every input bit affects every output bit
+static uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static size_t slotCount(size_t keys) {
+    return (keys * 100 + kLoadPercent - 1) / kLoadPercent;
+}
+
+// Map a 64-bit value onto [0, range) without a division
+static size_t reduce(uint64_t x, size_t range) {
+    return static_cast<size_t>(((x >> 32) * static_cast<uint64_t>(range)) >> 32);
+}
+
+// FNV-1a over the bytes, then mixed; stable across platforms so snapshots stay valid
+uint64_t PerfectHash::hashKey(const char* data, size_t length) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 0x100000001B3ULL;
+    }
+    return mix(hash ^ length);
+}
+
+size_t PerfectHash::bucketOf(uint64_t keyHash) const {
+    return reduce(mix(keyHash ^ seed), displacement.size());
+}
+
+size_t PerfectHash::slotOf(uint64_t keyHash, uint32_t shift) const {
+    return reduce(mix(keyHash + seed + (static_cast<uint64_t>(shift) + 1) * 0x9E3779B97F4A7C15ULL), slotValues.size());
+}
+
+bool PerfectHash::build(const std::vector<uint64_t>& keyHashes) {
+    clear();
+    if (keyHashes.empty()) {
+        return true;
+    }
+    // Equal hashes can never be told apart, whatever the seed
+    std::vector<uint64_t> sorted(keyHashes);
+    std::sort(sorted.begin(), sorted.end());
+    if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+        return false;
+    }
+    for (unsigned attempt = 0; attempt < kMaxSeeds; ++attempt) {
+        seed = mix(0x5EED0000ULL + attempt);
+        if (place(keyHashes)) {
+            return true;
+        }
+    }
+    clear();
+    return false;
+}
+
+// Place the biggest buckets first while the table is empty; singletons fill the gaps last
+bool PerfectHash::place(const std::vector<uint64_t>& keyHashes) {
+    const size_t n = keyHashes.size();
+    displacement.assign((n + kKeysPerBucket - 1) / kKeysPerBucket, 0);
+    slotValues.assign(slotCount(n), kNotFound);
+    fingerprints.assign(slotCount(n), 0);
+
+    // Counting sort of the keys by bucket
+    std::vector<uint32_t> bucketStart(displacement.size() + 1, 0);
+    for (uint64_t hash : keyHashes) {
+        bucketStart[bucketOf(hash) + 1]++;
+    }
+    for (size_t b = 0; b < displacement.size(); ++b) {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+    std::vector<uint32_t> members(n);
+    std::vector<uint32_t> cursor(bucketStart.begin(), bucketStart.end() - 1);
+    for (size_t i = 0; i < n; ++i) {
+        members[cursor[bucketOf(keyHashes[i])]++] = static_cast<uint32_t>(i);
+    }
+    std::vector<uint32_t> order(displacement.size());
+    for (size_t b = 0; b < order.size(); ++b) {
+        order[b] = static_cast<uint32_t>(b);
+    }
+    std::stable_sort(order.begin(), order.end(), [&bucketStart](uint32_t a, uint32_t b) {
+        return bucketStart[a + 1] - bucketStart[a] > bucketStart[b + 1] - bucketStart[b];
+    });
+
+    // With F slots left a singleton needs about slots / F tries; this bound only trips on a bad seed
+    const uint64_t maxShift = std::min<uint64_t>(64 * static_cast<uint64_t>(n) + 64, 0xFFFFFFFFULL);
+    std::vector<size_t> slots;
+    for (uint32_t bucket : order) {
+        const uint32_t begin = bucketStart[bucket];
+        const uint32_t end = bucketStart[bucket + 1];
+        if (begin == end) {
+            break;
+        }
+        bool placed = false;
+        for (uint64_t shift = 0; shift < maxShift && !placed; ++shift) {
+            slots.clear();
+            placed = true;
+            for (uint32_t m = begin; m < end && placed; ++m) {
+                size_t slot = slotOf(keyHashes[members[m]], static_cast<uint32_t>(shift));
+                placed = slotValues[slot] == kNotFound && std::find(slots.begin(), slots.end(), slot) == slots.end();
+                slots.push_back(slot);
+            }
+            if (placed) {
+                displacement[bucket] = static_cast<uint32_t>(shift);
+                for (uint32_t m = begin; m < end; ++m) {
+                    slotValues[slots[m - begin]] = members[m];
+                    fingerprints[slots[m - begin]] = static_cast<uint8_t>(keyHashes[members[m]]);
+                }
+            }
+        }
+        if (!placed) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint32_t PerfectHash::find(uint64_t keyHash) const {
+    if (slotValues.empty()) {
+        return kNotFound;
+    }
+    size_t slot = slotOf(keyHash, displacement[bucketOf(keyHash)]);
+    return fingerprints[slot] == static_cast<uint8_t>(keyHash) ? slotValues[slot] : kNotFound;
+}
+
+size_t PerfectHash::memoryBytes() const {
+    return displacement.capacity() * sizeof(uint32_t) + fingerprints.capacity() + slotValues.capacity() * sizeof(uint32_t);
+}
+
+void PerfectHash::clear() {
+    seed = 0;
+    std::vector<uint32_t>().swap(displacement);
+    std::vector<uint8_t>().swap(fingerprints);
+    std::vector<uint32_t>().swap(slotValues);
+}
+
+void PerfectHash::saveTo(std::ofstream& file) const {
+    file.write(reinterpret_cast<const char*>(&seed), sizeof(seed));
+    writeArray(file, displacement);
+    writeArray(file, fingerprints);
+    writeArray(file, slotValues);
+}
+
+bool PerfectHash::loadFrom(std::ifstream& file, size_t keys) {
+    PerfectHash loaded;
+    if (!file.read(reinterpret_cast<char*>(&loaded.seed), sizeof(loaded.seed)) || !readArray(file, loaded.displacement) ||
+        !readArray(file, loaded.fingerprints) || !readArray(file, loaded.slotValues)) {
+        return false;
+    }
+    // An empty index is valid (the writer fell back to binary search). Snapshots written before
+    // the spare slots have exactly one slot per key; both shapes hold every key once
+    const size_t slots = loaded.slotValues.size();
+    bool shaped = slots == 0 ||
+        ((slots == slotCount(keys) || slots == keys) && loaded.fingerprints.size() == slots &&
+         loaded.displacement.size() == (keys + kKeysPerBucket - 1) / kKeysPerBucket);
+    size_t filled = 0;
+    for (size_t i = 0; shaped && i < slots; ++i) {
+        shaped = loaded.slotValues[i] < keys || loaded.slotValues[i] == kNotFound;
+        filled += loaded.slotValues[i] != kNotFound;
+    }
+    if (!shaped || (slots != 0 && filled != keys)) {
+        return false;
+    }
+    *this = loaded;
+    return true;
+}
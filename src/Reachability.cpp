@@ -0,0 +1,217 @@
+#include "../include/Reachability.h"
+
+const size_t ReachabilityIndex::kClosureLimit;
+
+ReachabilityIndex::ReachabilityIndex(const CsrGraph& graph) : closureWords(0) {
+    const size_t n = graph.vertexCount();
+    const uint32_t unvisited = 0xFFFFFFFFu;
+    component.assign(n, unvisited);
+
+    // Iterative Tarjan: an explicit frame stack replaces recursion so long chains
+    // of words cannot overflow the call stack
+    std::vector<uint32_t> index(n, unvisited);
+    std::vector<uint32_t> lowlink(n, 0);
+    std::vector<bool> onStack(n, false);
+    std::vector<VertexId> sccStack;
+    std::vector<std::pair<VertexId, uint32_t>> frames; // (vertex, next edge offset)
+    uint32_t counter = 0;
+    uint32_t componentCounter = 0;
+
+    for (VertexId root = 0; root < n; ++root) {
+        if (index[root] != unvisited) {
+            continue;
+        }
+        frames.push_back(std::make_pair(root, graph.rowOffsets()[root]));
+        index[root] = lowlink[root] = counter++;
+        sccStack.push_back(root);
+        onStack[root] = true;
+
+        while (!frames.empty()) {
+            VertexId v = frames.back().first;
+            uint32_t& edge = frames.back().second;
+            bool descended = false;
+            while (edge < graph.rowOffsets()[v + 1]) {
+                VertexId w = graph.edgeTarget(edge++);
+                if (index[w] == unvisited) {
+                    index[w] = lowlink[w] = counter++;
+                    sccStack.push_back(w);
+                    onStack[w] = true;
+                    frames.push_back(std::make_pair(w, graph.rowOffsets()[w]));
+                    descended = true;
+                    break;
+                }
+                if (onStack[w]) {
+                    lowlink[v] = std::min(lowlink[v], index[w]);
+                }
+            }
+            if (descended) {
+                continue;
+            }
+
+            if (lowlink[v] == index[v]) {
+                VertexId member;
+                do {
+                    member = sccStack.back();
+                    sccStack.pop_back();
+                    onStack[member] = false;
+                    component[member] = componentCounter;
+                } while (member != v);
+                componentCounter++;
+            }
+            frames.pop_back();
+            if (!frames.empty()) {
+                VertexId parent = frames.back().first;
+                lowlink[parent] = std::min(lowlink[parent], lowlink[v]);
+            }
+        }
+    }
+
+    // Condensation DAG, deduplicated, in CSR form
+    std::vector<std::pair<uint32_t, uint32_t>> dagEdges;
+    for (VertexId u = 0; u < n; ++u) {
+        for (const VertexId* t = graph.targetsBegin(u); t != graph.targetsEnd(u); ++t) {
+            if (component[u] != component[*t]) {
+                dagEdges.push_back(std::make_pair(component[u], component[*t]));
+            }
+        }
+    }
+    std::sort(dagEdges.begin(), dagEdges.end());
+    dagEdges.erase(std::unique(dagEdges.begin(), dagEdges.end()), dagEdges.end());
+    dagOffsets.assign(componentCounter + 1, 0);
+    dagTargets.reserve(dagEdges.size());
+    for (const auto& e : dagEdges) {
+        dagOffsets[e.first + 1]++;
+        dagTargets.push_back(e.second);
+    }
+    for (uint32_t c = 0; c < componentCounter; ++c) {
+        dagOffsets[c + 1] += dagOffsets[c];
+    }
+
+    if (componentCounter <= kClosureLimit) {
+        // Successors always have smaller numbers, so one ascending sweep completes every row
+        closureWords = (componentCounter + 63) / 64;
+        closure.assign(static_cast<size_t>(componentCounter) * closureWords, 0);
+        for (uint32_t c = 0; c < componentCounter; ++c) {
+            uint64_t* row = &closure[static_cast<size_t>(c) * closureWords];
+            row[c / 64] |= uint64_t(1) << (c % 64);
+            for (uint32_t e = dagOffsets[c]; e < dagOffsets[c + 1]; ++e) {
+                const uint64_t* succ = &closure[static_cast<size_t>(dagTargets[e]) * closureWords];
+                for (size_t w = 0; w < closureWords; ++w) {
+                    row[w] |= succ[w];
+                }
+            }
+        }
+    }
+    else {
+        buildIntervals(0, false);
+        buildIntervals(1, true);
+    }
+}
+
+// Post-order DFS over the DAG; low = smallest post number among all descendants
+void ReachabilityIndex::buildIntervals(int labelSet, bool reverseChildren) {
+    const uint32_t count = static_cast<uint32_t>(componentCount());
+    const uint32_t unset = 0xFFFFFFFFu;
+    std::vector<uint32_t>& lowLabel = low[labelSet];
+    std::vector<uint32_t>& postLabel = post[labelSet];
+    lowLabel.assign(count, unset);
+    postLabel.assign(count, unset);
+    std::vector<bool> visited(count, false);
+    std::vector<std::pair<uint32_t, uint32_t>> frames; // (component, children visited)
+    uint32_t postCounter = 0;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        // Roots have the largest numbers; start from the top, or the bottom for the second label
+        uint32_t root = reverseChildren ? i : count - 1 - i;
+        if (visited[root]) {
+            continue;
+        }
+        visited[root] = true;
+        frames.push_back(std::make_pair(root, 0u));
+        while (!frames.empty()) {
+            uint32_t c = frames.back().first;
+            uint32_t degree = dagOffsets[c + 1] - dagOffsets[c];
+            if (frames.back().second < degree) {
+                uint32_t k = frames.back().second++;
+                uint32_t child = dagTargets[dagOffsets[c] + (reverseChildren ? degree - 1 - k : k)];
+                if (!visited[child]) {
+                    visited[child] = true;
+                    frames.push_back(std::make_pair(child, 0u));
+                }
+                continue;
+            }
+
+            postLabel[c] = postCounter++;
+            uint32_t lowest = postLabel[c];
+            for (uint32_t e = dagOffsets[c]; e < dagOffsets[c + 1]; ++e) {
+                lowest = std::min(lowest, lowLabel[dagTargets[e]]);
+            }
+            lowLabel[c] = lowest;
+            frames.pop_back();
+        }
+    }
+}
+
+bool ReachabilityIndex::intervalsContain(uint32_t from, uint32_t to) const {
+    for (int k = 0; k < 2; ++k) {
+        if (low[k][to] < low[k][from] || post[k][to] > post[k][from]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ReachabilityIndex::mayReachComponent(uint32_t from, uint32_t to) const {
+    if (from == to) {
+        return true;
+    }
+    if (from < to) {
+        return false; // DAG edges only go to smaller component numbers
+    }
+    if (!closure.empty()) {
+        return (closure[static_cast<size_t>(from) * closureWords + to / 64] >> (to % 64)) & 1;
+    }
+    return intervalsContain(from, to);
+}
+
+bool ReachabilityIndex::componentReaches(uint32_t from, uint32_t to) const {
+    if (!mayReachComponent(from, to)) {
+        return false;
+    }
+    if (from == to || !closure.empty()) {
+        return true;
+    }
+
+    // Labels could not decide: DFS over the DAG, skipping branches the labels rule out
+    std::vector<bool> visited(componentCount(), false);
+    std::vector<uint32_t> stack(1, from);
+    visited[from] = true;
+    while (!stack.empty()) {
+        uint32_t c = stack.back();
+        stack.pop_back();
+        for (uint32_t e = dagOffsets[c]; e < dagOffsets[c + 1]; ++e) {
+            uint32_t next = dagTargets[e];
+            if (next == to) {
+                return true;
+            }
+            if (!visited[next] && mayReachComponent(next, to)) {
+                visited[next] = true;
+                stack.push_back(next);
+            }
+        }
+    }
+    return false;
+}
+
+bool ReachabilityIndex::canReach(VertexId from, VertexId to) const {
+    return componentReaches(component[from], component[to]);
+}
+
+size_t ReachabilityIndex::memoryBytes() const {
+    size_t bytes = (component.capacity() + dagOffsets.capacity() + dagTargets.capacity()) * sizeof(uint32_t) +
+                   closure.capacity() * sizeof(uint64_t);
+    for (int k = 0; k < 2; ++k) {
+        bytes += (low[k].capacity() + post[k].capacity()) * sizeof(uint32_t);
+    }
+    return bytes;
+}
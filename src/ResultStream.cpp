@@ -0,0 +1,134 @@
+#include "../include/ResultStream.h"
+#include "../include/EdgeCost.h"
+
+namespace {
+// PathCost::Hops as a Dijkstra policy: with unit costs and ties by ID the stream yields
+// the distances and parents buildHopTree would give
+struct UnitCost {
+    double operator()(uint32_t, uint32_t) const { return 1.0; }
+};
+}
+
+ShortestPathStream::ShortestPathStream()
+    : cost(PathCost::Count), source(CsrGraph::kNoVertex), current(CsrGraph::kNoVertex), settledSoFar(0) {}
+
+ShortestPathStream::ShortestPathStream(std::shared_ptr<const CsrGraph> graph, VertexId source, PathCost cost,
+    std::shared_ptr<const NegativeLogProbabilityCost> logProbability)
+    : graph(graph), logProbability(logProbability), cost(cost), source(source), current(CsrGraph::kNoVertex),
+      distances(graph->vertexCount(), std::numeric_limits<double>::infinity()),
+      parents(graph->vertexCount(), CsrGraph::kNoVertex), settled(graph->vertexCount(), false), settledSoFar(0) {
+    if (cost == PathCost::NegativeLogProbability && !this->logProbability) {
+        this->logProbability = std::make_shared<const NegativeLogProbabilityCost>(*graph);
+    }
+    distances[source] = 0;
+    queue.push(QueueEntry(0.0, source));
+}
+
+bool ShortestPathStream::next() {
+    while (settleNext()) {
+        if (current != source) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Pop queue entries until one settles a new vertex, then relax its out-edges
+bool ShortestPathStream::settleNext() {
+    while (!queue.empty()) {
+        VertexId vertex = queue.top().second;
+        queue.pop();
+        if (settled[vertex]) {
+            continue;
+        }
+        settled[vertex] = true;
+        settledSoFar++;
+        current = vertex;
+        // The metric is dispatched once per settled vertex; the edge loop is a separate instantiation
+        switch (cost) {
+        case PathCost::InverseFrequency:
+            relax(vertex, InverseFrequencyCost());
+            break;
+        case PathCost::NegativeLogProbability:
+            relax(vertex, *logProbability);
+            break;
+        case PathCost::Hops:
+            relax(vertex, UnitCost());
+            break;
+        default:
+            relax(vertex, CountCost());
+            break;
+        }
+        return true;
+    }
+    return false;
+}
+
+template <class Cost>
+void ShortestPathStream::relax(VertexId from, const Cost& edgeCost) {
+    const VertexId* target = graph->targetsBegin(from);
+    const VertexId* end = graph->targetsEnd(from);
+    const uint32_t* weight = graph->weightsBegin(from);
+    uint32_t edge = graph->rowOffsets()[from];
+    for (; target != end; ++target, ++weight, ++edge) {
+        if (settled[*target]) {
+            continue;
+        }
+        double alt = distances[from] + edgeCost(edge, *weight);
+        if (alt < distances[*target]) {
+            distances[*target] = alt;
+            parents[*target] = from;
+            queue.push(QueueEntry(alt, *target));
+        }
+    }
+}
+
+const std::vector<CsrGraph::VertexId>& ShortestPathStream::pathIds() {
+    path.clear();
+    for (VertexId v = current; v != CsrGraph::kNoVertex; v = parents[v]) {
+        path.push_back(v);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+RandomWalkStream::RandomWalkStream(std::shared_ptr<const CsrGraph> graph, uint32_t seed, QueryCounters* counters)
+    : graph(graph), rng(seed), counters(counters), current(CsrGraph::kNoVertex), steps(0),
+      finished(graph->vertexCount() == 0) {}
+
+bool RandomWalkStream::next() {
+    if (finished) {
+        return false;
+    }
+    if (steps == 0) {
+        // Choose a random starting vertex
+        std::uniform_int_distribution<size_t> dist(0, graph->vertexCount() - 1);
+        current = static_cast<VertexId>(dist(rng));
+        steps++;
+        return true;
+    }
+    // Stop at a word without outgoing edges
+    if (graph->outDegree(current) == 0) {
+        return finish();
+    }
+    // Choose a random outgoing edge, stopping if it has been visited
+    std::uniform_int_distribution<uint32_t> edgeDist(0, graph->outDegree(current) - 1);
+    uint32_t edge = graph->rowOffsets()[current] + edgeDist(rng);
+    if (!visitedEdges.insert(edge).second) {
+        return finish();
+    }
+    current = graph->edgeTarget(edge);
+    steps++;
+    return true;
+}
+
+// End of the walk: publish it to the graph's counters
+bool RandomWalkStream::finish() {
+    finished = true;
+    if (counters != nullptr) {
+        TG_STAT(counters->randomWalkCalls.add(1));
+        TG_STAT(counters->lastRandomWalkSteps.store(steps - 1));
+        TG_STAT(counters->totalRandomWalkSteps.add(steps - 1));
+    }
+    return false;
+}
@@ -0,0 +1,206 @@
+#include "../include/SketchBuilder.h"
+#include "../include/PerfectHash.h"
+#include "../include/WordStream.h"
+
+// splitmix64 finalizer, used to derive one independent index per sketch row
+static uint64_t mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// Rows are indexed from a stack array in update()
+static const size_t kMaxDepth = 16;
+// Approximate heap bytes of one hash-map node (key, value, next pointer, cached hash)
+static const size_t kMapNodeBytes = 32;
+
+SketchGraphBuilder::SketchGraphBuilder(const SketchBuildOptions& buildOptions) : options(buildOptions) {
+    options.sketchWidth = std::max<size_t>(options.sketchWidth, 16);
+    options.sketchDepth = std::min<size_t>(std::max<size_t>(options.sketchDepth, 1), kMaxDepth);
+    options.heavyHitters = std::max<size_t>(options.heavyHitters, 1);
+    if (options.readChunkBytes == 0) {
+        options.readChunkBytes = static_cast<size_t>(1) << 20;
+    }
+    counters.assign(options.sketchWidth * options.sketchDepth, 0);
+    tracked.reserve(options.heavyHitters);
+    heap.reserve(options.heavyHitters);
+    heapPos.reserve(options.heavyHitters);
+    byKey.reserve(options.heavyHitters);
+}
+
+bool SketchGraphBuilder::addFile(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << filePath << '\n';
+        return false;
+    }
+    endDocument();
+    auto onWord = [this](const char* word, size_t length) {
+        addWord(word, length);
+        return true;
+    };
+    streamWords(file, options.readChunkBytes, onWord);
+    endDocument();
+    return true;
+}
+
+void SketchGraphBuilder::addWord(const char* word, size_t length) {
+    uint64_t hash = PerfectHash::hashKey(word, length);
+    buildReport.tokens++;
+    if (havePrevious) {
+        buildReport.pairs++;
+        uint64_t key = pairKey(previousHash, hash);
+        uint64_t count = update(key);
+        track(key, count, word, length);
+    }
+    previousWord.assign(word, length);
+    previousHash = hash;
+    havePrevious = true;
+}
+
+uint64_t SketchGraphBuilder::estimate(const std::string& src, const std::string& dest) const {
+    return lookup(pairKey(PerfectHash::hashKey(src), PerfectHash::hashKey(dest)));
+}
+
+uint64_t SketchGraphBuilder::pairKey(uint64_t srcHash, uint64_t destHash) const {
+    // Not symmetric: "a b" and "b a" are different edges
+    return mix(srcHash * 0x9E3779B97F4A7C15ULL + destHash);
+}
+
+// Conservative update: raise only the counters below the new minimum, which keeps the
+// same error guarantee as a plain Count-Min while overestimating far less
+uint64_t SketchGraphBuilder::update(uint64_t key) {
+    const size_t width = options.sketchWidth;
+    const size_t depth = options.sketchDepth;
+    size_t index[kMaxDepth];
+    uint32_t smallest = std::numeric_limits<uint32_t>::max();
+    for (size_t row = 0; row < depth; ++row) {
+        index[row] = row * width + static_cast<size_t>(mix(key + row) % width);
+        smallest = std::min(smallest, counters[index[row]]);
+    }
+    if (smallest == std::numeric_limits<uint32_t>::max()) {
+        return smallest; // saturated
+    }
+    uint32_t raised = smallest + 1;
+    for (size_t row = 0; row < depth; ++row) {
+        counters[index[row]] = std::max(counters[index[row]], raised);
+    }
+    return raised;
+}
+
+uint64_t SketchGraphBuilder::lookup(uint64_t key) const {
+    const size_t width = options.sketchWidth;
+    const size_t depth = options.sketchDepth;
+    uint32_t smallest = std::numeric_limits<uint32_t>::max();
+    for (size_t row = 0; row < depth; ++row) {
+        smallest = std::min(smallest, counters[row * width + static_cast<size_t>(mix(key + row) % width)]);
+    }
+    return smallest;
+}
+
+// Space-Saving step with the sketch as admission filter: a tracked bigram takes its new
+// estimate, an untracked one replaces the smallest entry once its estimate is larger
+void SketchGraphBuilder::track(uint64_t key, uint64_t count, const char* dest, size_t length) {
+    std::unordered_map<uint64_t, uint32_t>::iterator it = byKey.find(key);
+    if (it != byKey.end()) {
+        tracked[it->second].count = count;
+        siftDown(heapPos[it->second]);
+        return;
+    }
+
+    uint32_t slot;
+    if (tracked.size() < options.heavyHitters) {
+        slot = static_cast<uint32_t>(tracked.size());
+        tracked.push_back(Tracked());
+        heap.push_back(slot);
+        heapPos.push_back(static_cast<uint32_t>(heap.size() - 1));
+        // The new entry may be smaller than its parents: move it up
+        tracked[slot].count = count;
+        for (size_t pos = heap.size() - 1; pos > 0 && count < tracked[heap[(pos - 1) / 2]].count; pos = (pos - 1) / 2) {
+            swapHeap(pos, (pos - 1) / 2);
+        }
+    }
+    else if (count > tracked[heap[0]].count) {
+        slot = heap[0];
+        byKey.erase(tracked[slot].key);
+    }
+    else {
+        return;
+    }
+    Tracked& entry = tracked[slot];
+    entry.key = key;
+    entry.count = count;
+    entry.src = previousWord;
+    entry.dest.assign(dest, length);
+    byKey.emplace(key, slot);
+    siftDown(heapPos[slot]);
+}
+
+void SketchGraphBuilder::siftDown(size_t pos) {
+    while (true) {
+        size_t smallest = pos;
+        size_t left = 2 * pos + 1;
+        size_t right = left + 1;
+        if (left < heap.size() && tracked[heap[left]].count < tracked[heap[smallest]].count) {
+            smallest = left;
+        }
+        if (right < heap.size() && tracked[heap[right]].count < tracked[heap[smallest]].count) {
+            smallest = right;
+        }
+        if (smallest == pos) {
+            return;
+        }
+        swapHeap(pos, smallest);
+        pos = smallest;
+    }
+}
+
+void SketchGraphBuilder::swapHeap(size_t a, size_t b) {
+    std::swap(heap[a], heap[b]);
+    heapPos[heap[a]] = static_cast<uint32_t>(a);
+    heapPos[heap[b]] = static_cast<uint32_t>(b);
+}
+
+void SketchGraphBuilder::finishInto(Graph& graph) {
+    std::vector<const Tracked*> kept;
+    for (const Tracked& entry : tracked) {
+        if (entry.count >= options.minWeight) {
+            kept.push_back(&entry);
+        }
+    }
+    // Heaviest first, ties by words so the result does not depend on hash order
+    std::sort(kept.begin(), kept.end(), [](const Tracked* a, const Tracked* b) {
+        if (a->count != b->count) {
+            return a->count > b->count;
+        }
+        return a->src != b->src ? a->src < b->src : a->dest < b->dest;
+    });
+    if (options.topK > 0 && kept.size() > options.topK) {
+        kept.resize(options.topK);
+    }
+
+    std::set<std::string> words;
+    for (const Tracked* entry : kept) {
+        int weight = static_cast<int>(std::min<uint64_t>(entry->count, static_cast<uint64_t>(std::numeric_limits<int>::max())));
+        graph.addEdge(entry->src, entry->dest, weight);
+        words.insert(entry->src);
+        words.insert(entry->dest);
+    }
+
+    buildReport.tracked = tracked.size();
+    buildReport.edges = kept.size();
+    buildReport.vertices = words.size();
+    buildReport.errorBound = std::exp(1.0) / static_cast<double>(options.sketchWidth) * static_cast<double>(buildReport.pairs);
+    buildReport.confidence = 1.0 - std::exp(-static_cast<double>(options.sketchDepth));
+    buildReport.trackedFloor = tracked.size() < options.heavyHitters ? 0 : tracked[heap[0]].count;
+    size_t bytes = counters.capacity() * sizeof(uint32_t) + tracked.capacity() * sizeof(Tracked) +
+                   (heap.capacity() + heapPos.capacity()) * sizeof(uint32_t) +
+                   byKey.size() * kMapNodeBytes + byKey.bucket_count() * sizeof(void*);
+    for (const Tracked& entry : tracked) {
+        bytes += entry.src.capacity() + entry.dest.capacity();
+    }
+    buildReport.memoryBytes = bytes;
+}
@@ -0,0 +1,358 @@
+#include "../include/SparseMatrix.h"
+#include "../include/Parallel.h"
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define SPARSE_MATRIX_X86 1
+#include <immintrin.h>
+#else
+#define SPARSE_MATRIX_X86 0
+#endif
+
+// Rows per work item of a parallel product
+static const size_t kRowBlock = 1024;
+
+// Kernels per backend. Each vector loop keeps one accumulator per lane, adds the lanes at the
+// end and finishes the tail with the scalar loop
+typedef double (*RowKernel)(const uint32_t* columns, const double* values, const double* x, uint32_t begin, uint32_t end);
+
+static double gatherRowScalar(const uint32_t* columns, const double* values, const double* x, uint32_t begin, uint32_t end) {
+    double sum = 0.0;
+    for (uint32_t e = begin; e < end; ++e) {
+        sum += values[e] * x[columns[e]];
+    }
+    return sum;
+}
+
+static double l1Scalar(const double* a, const double* b, size_t begin, size_t n) {
+    double total = 0.0;
+    for (size_t i = begin; i < n; ++i) {
+        total += std::fabs(a[i] - b[i]);
+    }
+    return total;
+}
+
+static double sumScalar(const double* x, size_t begin, size_t n) {
+    double total = 0.0;
+    for (size_t i = begin; i < n; ++i) {
+        total += x[i];
+    }
+    return total;
+}
+
+#if SPARSE_MATRIX_X86
+
+static inline double addLanes128(__m128d v) {
+    return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+static double gatherRowSSE2(const uint32_t* columns, const double* values, const double* x, uint32_t begin, uint32_t end) {
+    __m128d acc = _mm_setzero_pd();
+    uint32_t e = begin;
+    for (; e + 2 <= end; e += 2) {
+        __m128d gathered = _mm_set_pd(x[columns[e + 1]], x[columns[e]]);
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_loadu_pd(values + e), gathered));
+    }
+    return addLanes128(acc) + gatherRowScalar(columns, values, x, e, end);
+}
+
+static double l1SSE2(const double* a, const double* b, size_t n) {
+    const __m128d sign = _mm_set1_pd(-0.0);
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        acc = _mm_add_pd(acc, _mm_andnot_pd(sign, _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i))));
+    }
+    return addLanes128(acc) + l1Scalar(a, b, i, n);
+}
+
+static double sumSSE2(const double* x, size_t n) {
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        acc = _mm_add_pd(acc, _mm_loadu_pd(x + i));
+    }
+    return addLanes128(acc) + sumScalar(x, i, n);
+}
+
+__attribute__((target("avx2")))
+static inline double addLanes256(__m256d v) {
+    return addLanes128(_mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1)));
+}
+
+// The hardware gather takes signed 32-bit indices; gather() falls back to SSE2 for vectors
+// too long for them
+__attribute__((target("avx2")))
+static double gatherRowAVX2(const uint32_t* columns, const double* values, const double* x, uint32_t begin, uint32_t end) {
+    __m256d acc = _mm256_setzero_pd();
+    uint32_t e = begin;
+    for (; e + 4 <= end; e += 4) {
+        __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns + e));
+        __m256d gathered = _mm256_i32gather_pd(x, index, 8);
+        acc = _mm256_add_pd(acc, _mm256_mul_pd(_mm256_loadu_pd(values + e), gathered));
+    }
+    return addLanes256(acc) + gatherRowScalar(columns, values, x, e, end);
+}
+
+__attribute__((target("avx2")))
+static double l1AVX2(const double* a, const double* b, size_t n) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm256_add_pd(acc, _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i))));
+    }
+    return addLanes256(acc) + l1Scalar(a, b, i, n);
+}
+
+__attribute__((target("avx2")))
+static double sumAVX2(const double* x, size_t n) {
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm256_add_pd(acc, _mm256_loadu_pd(x + i));
+    }
+    return addLanes256(acc) + sumScalar(x, i, n);
+}
+
+#endif // SPARSE_MATRIX_X86
+
+bool vectorBackendSupported(VectorBackend backend) {
+    switch (backend) {
+    case VectorBackend::Scalar:
+        return true;
+#if SPARSE_MATRIX_X86
+    case VectorBackend::SSE2:
+        return true;
+    case VectorBackend::AVX2:
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    default:
+        return false;
+    }
+}
+
+VectorBackend vectorBackend() {
+    static const VectorBackend best =
+        vectorBackendSupported(VectorBackend::AVX2) ? VectorBackend::AVX2 :
+        vectorBackendSupported(VectorBackend::SSE2) ? VectorBackend::SSE2 :
+        VectorBackend::Scalar;
+    return best;
+}
+
+const char* vectorBackendName(VectorBackend backend) {
+    switch (backend) {
+    case VectorBackend::AVX2:
+        return "AVX2";
+    case VectorBackend::SSE2:
+        return "SSE2";
+    default:
+        return "scalar";
+    }
+}
+
+SparseMatrix::SparseMatrix(const CsrGraph& graph) : outWeights(graph.vertexCount(), 0.0), largestInWeight(0.0) {
+    const size_t n = graph.vertexCount();
+    const size_t m = graph.edgeCount();
+    forward.offsets = graph.rowOffsets();
+    forward.columns.reserve(m);
+    forward.values.reserve(m);
+    for (uint32_t e = 0; e < m; ++e) {
+        forward.columns.push_back(graph.edgeTarget(e));
+        forward.values.push_back(graph.edgeWeight(e));
+    }
+
+    // Counting sort by target; sources are visited in ascending order, so each transposed
+    // row lists its sources sorted and the gather sums them in ID order
+    transposed.offsets.assign(n + 1, 0);
+    for (uint32_t e = 0; e < m; ++e) {
+        transposed.offsets[graph.edgeTarget(e) + 1]++;
+    }
+    for (size_t v = 0; v < n; ++v) {
+        transposed.offsets[v + 1] += transposed.offsets[v];
+    }
+    transposed.columns.resize(m);
+    transposed.values.resize(m);
+    std::vector<uint32_t> fill(transposed.offsets.begin(), transposed.offsets.end() - 1);
+    std::vector<double> inWeights(n, 0.0);
+    for (uint32_t u = 0; u < n; ++u) {
+        for (uint32_t e = forward.offsets[u]; e < forward.offsets[u + 1]; ++e) {
+            uint32_t slot = fill[forward.columns[e]]++;
+            transposed.columns[slot] = u;
+            transposed.values[slot] = forward.values[e];
+            outWeights[u] += forward.values[e];
+            inWeights[forward.columns[e]] += forward.values[e];
+        }
+    }
+    for (double weight : inWeights) {
+        largestInWeight = std::max(largestInWeight, weight);
+    }
+}
+
+size_t SparseMatrix::memoryBytes() const {
+    size_t total = sizeof(*this) + outWeights.capacity() * sizeof(double);
+    for (const Rows* rows : { &forward, &transposed }) {
+        total += rows->offsets.capacity() * sizeof(uint32_t) + rows->columns.capacity() * sizeof(uint32_t) +
+                 rows->values.capacity() * sizeof(double);
+    }
+    return total;
+}
+
+void SparseMatrix::multiply(const std::vector<double>& x, std::vector<double>& y, unsigned threads,
+    VectorBackend backend) const {
+    gather(forward, x, y, threads, backend);
+}
+
+void SparseMatrix::multiplyTranspose(const std::vector<double>& x, std::vector<double>& y, unsigned threads,
+    VectorBackend backend) const {
+    gather(transposed, x, y, threads, backend);
+}
+
+void SparseMatrix::gather(const Rows& rows, const std::vector<double>& x, std::vector<double>& y, unsigned threads,
+    VectorBackend backend) {
+    const size_t n = rows.offsets.size() - 1;
+    y.resize(n);
+    if (!vectorBackendSupported(backend)) {
+        backend = VectorBackend::Scalar;
+    }
+    // The kernel is picked once per product, every row block runs the same one
+    RowKernel kernel = gatherRowScalar;
+#if SPARSE_MATRIX_X86
+    if (backend == VectorBackend::AVX2 && x.size() <= static_cast<size_t>(INT32_MAX)) {
+        kernel = gatherRowAVX2;
+    }
+    else if (backend != VectorBackend::Scalar) {
+        kernel = gatherRowSSE2;
+    }
+#endif
+    const uint32_t* offsets = rows.offsets.data();
+    const uint32_t* columns = rows.columns.data();
+    const double* values = rows.values.data();
+    const double* in = x.data();
+    double* out = y.data();
+    parallelFor((n + kRowBlock - 1) / kRowBlock, threads, [=](size_t block) {
+        const size_t end = std::min(n, (block + 1) * kRowBlock);
+        for (size_t row = block * kRowBlock; row < end; ++row) {
+            out[row] = kernel(columns, values, in, offsets[row], offsets[row + 1]);
+        }
+    });
+}
+
+double l1Distance(const std::vector<double>& a, const std::vector<double>& b) {
+    return l1Distance(a, b, vectorBackend());
+}
+
+double l1Distance(const std::vector<double>& a, const std::vector<double>& b, VectorBackend backend) {
+    if (!vectorBackendSupported(backend)) {
+        backend = VectorBackend::Scalar;
+    }
+    switch (backend) {
+#if SPARSE_MATRIX_X86
+    case VectorBackend::AVX2:
+        return l1AVX2(a.data(), b.data(), a.size());
+    case VectorBackend::SSE2:
+        return l1SSE2(a.data(), b.data(), a.size());
+#endif
+    default:
+        return l1Scalar(a.data(), b.data(), 0, a.size());
+    }
+}
+
+void scaleToSum(std::vector<double>& x, double sum) {
+    scaleToSum(x, sum, vectorBackend());
+}
+
+void scaleToSum(std::vector<double>& x, double sum, VectorBackend backend) {
+    if (!vectorBackendSupported(backend)) {
+        backend = VectorBackend::Scalar;
+    }
+    double current = 0.0;
+    switch (backend) {
+#if SPARSE_MATRIX_X86
+    case VectorBackend::AVX2:
+        current = sumAVX2(x.data(), x.size());
+        break;
+    case VectorBackend::SSE2:
+        current = sumSSE2(x.data(), x.size());
+        break;
+#endif
+    default:
+        current = sumScalar(x.data(), 0, x.size());
+        break;
+    }
+    if (current == 0.0) {
+        return;
+    }
+    // An element-wise product rounds the same in every backend; left to the compiler
+    const double factor = sum / current;
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] *= factor;
+    }
+}
+
+IterationResult pageRankScores(const SparseMatrix& matrix, double dampingFactor, std::vector<double> start,
+    const IterationOptions& options, JobControl* control) {
+    const size_t n = matrix.size();
+    if (n == 0) {
+        IterationResult result;
+        result.values.swap(start);
+        return result;
+    }
+    const double baseRank = (1.0 - dampingFactor) / static_cast<double>(n);
+    std::vector<double> share(n);
+    return iterate(std::move(start), options, control,
+        [&](const std::vector<double>& rank, std::vector<double>& next) {
+            // share[u] = rank[u] / out-weight, so A^T share hands each edge its weighted part
+            double danglingSum = 0.0;
+            for (size_t u = 0; u < n; ++u) {
+                double out = matrix.outWeight(static_cast<uint32_t>(u));
+                if (out == 0.0) {
+                    danglingSum += rank[u];
+                    share[u] = 0.0;
+                }
+                else {
+                    share[u] = rank[u] / out;
+                }
+            }
+            matrix.multiplyTranspose(share, next, options.threads);
+            const double offset = baseRank + dampingFactor * danglingSum / static_cast<double>(n);
+            for (size_t v = 0; v < n; ++v) {
+                next[v] = offset + dampingFactor * next[v];
+            }
+        });
+}
+
+HitsResult hitsScores(const SparseMatrix& matrix, const IterationOptions& options, JobControl* control) {
+    const size_t n = matrix.size();
+    HitsResult result;
+    std::vector<double> hubs(n);
+    // One step is a = A^T (A a): the hub update followed by the authority update
+    result.authorities = iterate(std::vector<double>(n, n == 0 ? 0.0 : 1.0 / static_cast<double>(n)), options, control,
+        [&](const std::vector<double>& authorities, std::vector<double>& next) {
+            matrix.multiply(authorities, hubs, options.threads);
+            matrix.multiplyTranspose(hubs, next, options.threads);
+            scaleToSum(next, 1.0);
+        });
+    if (!result.authorities.values.empty()) {
+        matrix.multiply(result.authorities.values, result.hubs, options.threads);
+        scaleToSum(result.hubs, 1.0);
+    }
+    return result;
+}
+
+IterationResult katzScores(const SparseMatrix& matrix, double alpha, double beta, const IterationOptions& options,
+    JobControl* control) {
+    if (alpha <= 0.0) {
+        alpha = matrix.maxInWeight() > 0.0 ? 0.5 / matrix.maxInWeight() : 0.0;
+    }
+    const size_t n = matrix.size();
+    return iterate(std::vector<double>(n, beta), options, control,
+        [&](const std::vector<double>& x, std::vector<double>& next) {
+            matrix.multiplyTranspose(x, next, options.threads);
+            for (size_t v = 0; v < n; ++v) {
+                next[v] = alpha * next[v] + beta;
+            }
+        });
+}
@@ -0,0 +1,252 @@
+#include "../include/Tokenizer.h"
+
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define TOKENIZER_X86 1
+#include <immintrin.h>
+#else
+#define TOKENIZER_X86 0
+#endif
+
+// 256-entry class table, built once (thread-safe function-local static)
+struct CharClassTable {
+    unsigned char cls[256];
+
+    CharClassTable() {
+        for (int c = 0; c < 256; ++c) {
+            unsigned char value = CHAR_OTHER;
+            if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) {
+                value = CHAR_ALPHA;
+            }
+            else if ((c >= 0x09 && c <= 0x0D) || (c >= 0x20 && c <= 0x2F) || (c >= 0x3A && c <= 0x40) ||
+                     (c >= 0x5B && c <= 0x60) || (c >= 0x7B && c <= 0x7E)) {
+                // whitespace, space and the ASCII punctuation ranges
+                value = CHAR_SEPARATOR;
+            }
+            cls[c] = value;
+        }
+    }
+};
+
+static const unsigned char* charClassTable() {
+    static const CharClassTable table;
+    return table.cls;
+}
+
+CharClass classifyChar(char c) {
+    return static_cast<CharClass>(charClassTable()[static_cast<unsigned char>(c)]);
+}
+
+// Output state of the in-place compaction: write <= read is always true,
+// since every input byte produces at most one output byte
+struct CompactState {
+    char* write;
+    char* wordStart;
+    size_t words;
+};
+
+static inline void endWord(CompactState& st) {
+    if (st.write > st.wordStart) {
+        *st.write++ = ' ';
+        st.wordStart = st.write;
+        st.words++;
+    }
+}
+
+static inline void scalarStep(CompactState& st, const unsigned char* table, char c) {
+    unsigned char cls = table[static_cast<unsigned char>(c)];
+    if (cls == CHAR_ALPHA) {
+        *st.write++ = static_cast<char>(c | 0x20);
+    }
+    else if (cls == CHAR_SEPARATOR) {
+        endWord(st);
+    }
+}
+
+static size_t finish(CompactState& st, char* data, size_t* wordCount) {
+    if (st.write > st.wordStart) {
+        st.words++;
+    }
+    else if (st.write > data) {
+        st.write--; // drop the trailing separator
+    }
+    if (wordCount) {
+        *wordCount = st.words;
+    }
+    return static_cast<size_t>(st.write - data);
+}
+
+static size_t normalizeScalar(char* data, size_t size, size_t* wordCount) {
+    CompactState st = { data, data, 0 };
+    const unsigned char* table = charClassTable();
+    for (size_t i = 0; i < size; ++i) {
+        scalarStep(st, table, data[i]);
+    }
+    return finish(st, data, wordCount);
+}
+
+#if TOKENIZER_X86
+
+// Consume one block given its lowercased bytes and per-byte alpha / separator bit masks
+static inline void consumeBlock(CompactState& st, const char* lowered, uint32_t alpha, uint32_t sep, unsigned width) {
+    unsigned i = 0;
+    while (i < width) {
+        // Run of word bytes up to the next separator
+        uint32_t sepRest = sep >> i;
+        unsigned run = sepRest ? static_cast<unsigned>(__builtin_ctz(sepRest)) : width - i;
+        if (run > 0) {
+            uint32_t runMask = (run >= 32) ? 0xFFFFFFFFu : ((1u << run) - 1);
+            uint32_t runAlpha = (alpha >> i) & runMask;
+            if (runAlpha == runMask) {
+                std::memcpy(st.write, lowered + i, run);
+                st.write += run;
+            }
+            else {
+                while (runAlpha) {
+                    unsigned j = static_cast<unsigned>(__builtin_ctz(runAlpha));
+                    *st.write++ = lowered[i + j];
+                    runAlpha &= runAlpha - 1;
+                }
+            }
+            i += run;
+        }
+        if (i >= width) {
+            break;
+        }
+
+        // Run of separators closes the current word
+        endWord(st);
+        uint32_t nonSep = ~(sep >> i);
+        i += nonSep ? static_cast<unsigned>(__builtin_ctz(nonSep)) : width - i;
+    }
+}
+
+static inline __m128i inRange128(__m128i v, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(lo - 1))),
+                         _mm_cmpgt_epi8(_mm_set1_epi8(static_cast<char>(hi + 1)), v));
+}
+
+static size_t normalizeSSE2(char* data, size_t size, size_t* wordCount) {
+    CompactState st = { data, data, 0 };
+    alignas(16) char lowered[16];
+    size_t r = 0;
+    for (; r + 16 <= size; r += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + r));
+        __m128i low = _mm_or_si128(v, _mm_set1_epi8(0x20));
+        __m128i alphaV = inRange128(low, 'a', 'z');
+        __m128i sepV = _mm_or_si128(
+            _mm_or_si128(inRange128(v, 0x09, 0x0D), inRange128(v, 0x20, 0x2F)),
+            _mm_or_si128(_mm_or_si128(inRange128(v, 0x3A, 0x40), inRange128(v, 0x5B, 0x60)),
+                         inRange128(v, 0x7B, 0x7E)));
+        uint32_t alpha = static_cast<uint32_t>(_mm_movemask_epi8(alphaV));
+        uint32_t sep = static_cast<uint32_t>(_mm_movemask_epi8(sepV));
+
+        if (alpha == 0xFFFFu) {
+            // Whole block is letters: lowercase and store 16 bytes at once
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(st.write), low);
+            st.write += 16;
+            continue;
+        }
+        _mm_store_si128(reinterpret_cast<__m128i*>(lowered), low);
+        consumeBlock(st, lowered, alpha, sep, 16);
+    }
+    const unsigned char* table = charClassTable();
+    for (; r < size; ++r) {
+        scalarStep(st, table, data[r]);
+    }
+    return finish(st, data, wordCount);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i inRange256(__m256i v, char lo, char hi) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(static_cast<char>(lo - 1))),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(hi + 1)), v));
+}
+
+__attribute__((target("avx2")))
+static size_t normalizeAVX2(char* data, size_t size, size_t* wordCount) {
+    CompactState st = { data, data, 0 };
+    alignas(32) char lowered[32];
+    size_t r = 0;
+    for (; r + 32 <= size; r += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + r));
+        __m256i low = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+        __m256i alphaV = inRange256(low, 'a', 'z');
+        __m256i sepV = _mm256_or_si256(
+            _mm256_or_si256(inRange256(v, 0x09, 0x0D), inRange256(v, 0x20, 0x2F)),
+            _mm256_or_si256(_mm256_or_si256(inRange256(v, 0x3A, 0x40), inRange256(v, 0x5B, 0x60)),
+                            inRange256(v, 0x7B, 0x7E)));
+        uint32_t alpha = static_cast<uint32_t>(_mm256_movemask_epi8(alphaV));
+        uint32_t sep = static_cast<uint32_t>(_mm256_movemask_epi8(sepV));
+
+        if (alpha == 0xFFFFFFFFu) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(st.write), low);
+            st.write += 32;
+            continue;
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lowered), low);
+        consumeBlock(st, lowered, alpha, sep, 32);
+    }
+    const unsigned char* table = charClassTable();
+    for (; r < size; ++r) {
+        scalarStep(st, table, data[r]);
+    }
+    return finish(st, data, wordCount);
+}
+
+#endif // TOKENIZER_X86
+
+bool tokenizerBackendSupported(TokenizerBackend backend) {
+    switch (backend) {
+    case TokenizerBackend::Scalar:
+        return true;
+#if TOKENIZER_X86
+    case TokenizerBackend::SSE2:
+        return true;
+    case TokenizerBackend::AVX2:
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    default:
+        return false;
+    }
+}
+
+TokenizerBackend tokenizerBackend() {
+    static const TokenizerBackend best =
+        tokenizerBackendSupported(TokenizerBackend::AVX2) ? TokenizerBackend::AVX2 :
+        tokenizerBackendSupported(TokenizerBackend::SSE2) ? TokenizerBackend::SSE2 :
+        TokenizerBackend::Scalar;
+    return best;
+}
+
+const char* tokenizerBackendName(TokenizerBackend backend) {
+    switch (backend) {
+    case TokenizerBackend::AVX2:
+        return "AVX2";
+    case TokenizerBackend::SSE2:
+        return "SSE2";
+    default:
+        return "scalar";
+    }
+}
+
+size_t normalizeTextInPlace(char* data, size_t size, size_t* wordCount) {
+    return normalizeTextInPlace(data, size, wordCount, tokenizerBackend());
+}
+
+size_t normalizeTextInPlace(char* data, size_t size, size_t* wordCount, TokenizerBackend backend) {
+    if (!tokenizerBackendSupported(backend)) {
+        backend = TokenizerBackend::Scalar;
+    }
+    switch (backend) {
+#if TOKENIZER_X86
+    case TokenizerBackend::AVX2:
+        return normalizeAVX2(data, size, wordCount);
+    case TokenizerBackend::SSE2:
+        return normalizeSSE2(data, size, wordCount);
+#endif
+    default:
+        return normalizeScalar(data, size, wordCount);
+    }
+}
@@ -1,11 +1,16 @@
 #include "../include/Tools.h"
 
+#include <dirent.h>
+#include <sys/stat.h>
+
 // Convert to lowercase and normalize word
 std::string normalizeWord(const std::string& word) {
     std::string result;
+    result.reserve(word.size());
     for (char c : word) {
-        if (std::isalpha(c)) {
-            result += static_cast<char>(std::tolower(c));
+        // Same table as the bulk tokenizer: ASCII letters only, no locale lookups
+        if (classifyChar(c) == CHAR_ALPHA) {
+            result += static_cast<char>(c | 0x20);
         }
     }
     return result;
@@ -26,4 +31,86 @@ void displayShortestPath(const std::pair<double, std::vector<std::string>>& path
     std::cout << '\n';
 
     std::cout << "Path Length: " << pathInfo.first << '\n';
-}
\ No newline at end of file
+}
+
+// Function to display graph size, memory estimate and build timings (--stats)
+void displayGraphStats(const GraphStats& stats) {
+    std::cout << BLUE << "=== Graph Statistics ===" << RESET << '\n';
+    std::cout << "Documents: " << stats.build.documents << '\n';
+    std::cout << "Tokens: " << stats.build.tokens << '\n';
+    std::cout << "Vertices: " << stats.vertices << '\n';
+    std::cout << "Edges: " << stats.edges << '\n';
+
+    std::cout << "Estimated memory (bytes): " << stats.memory.total() << '\n';
+    std::cout << "  map nodes:      " << stats.memory.mapNodes << '\n';
+    std::cout << "  vertex strings: " << stats.memory.vertexStrings << '\n';
+    std::cout << "  edge arrays:    " << stats.memory.edgeArrays << '\n';
+    std::cout << "  edge strings:   " << stats.memory.edgeStrings << '\n';
+    std::cout << "  CSR view:       " << stats.memory.csrView << '\n';
+    std::cout << "  in-edge view:   " << stats.memory.inEdgeView << '\n';
+    std::cout << "  reachability:   " << stats.memory.reachability << '\n';
+    std::cout << "  rank matrix:    " << stats.memory.rankMatrix << '\n';
+    std::cout << "  log-prob costs: " << stats.memory.logProbabilityCosts << '\n';
+    std::cout << "  path trees:     " << stats.memory.pathTrees << '\n';
+
+    std::cout << "Build timings (ms): read " << stats.build.readMs
+              << ", tokenize " << stats.build.tokenizeMs
+              << ", insert " << stats.build.insertMs << '\n';
+    std::cout << "Path cache: " << stats.pathCache.entries << " trees, " << stats.pathCache.bytes
+              << " / " << stats.pathCache.budgetBytes << " bytes, " << stats.pathCache.hits << " hits, "
+              << stats.pathCache.misses << " misses, " << stats.pathCache.evictions << " evictions\n";
+    displayQueryStats(stats.queries);
+}
+
+// Function to display hot-path counters of the queries run so far
+void displayQueryStats(const QueryStats& queries) {
+#if TG_STATS_ENABLED
+    std::cout << YELLOW << "Query counters:" << RESET << '\n';
+    std::cout << "  shortestPath: " << queries.shortestPathCalls << " calls, last settled "
+              << queries.lastVerticesSettled << " / relaxed " << queries.lastEdgesRelaxed
+              << ", total settled " << queries.totalVerticesSettled
+              << " / relaxed " << queries.totalEdgesRelaxed << '\n';
+    std::cout << "  calculatePageRank: " << queries.pageRankCalls << " calls, last "
+              << queries.lastPageRankIterations << " iterations, residual "
+              << std::scientific << queries.lastPageRankResidual << std::defaultfloat << '\n';
+    std::cout << "  randomWalk: " << queries.randomWalkCalls << " calls, last "
+              << queries.lastRandomWalkSteps << " steps, total " << queries.totalRandomWalkSteps << '\n';
+#else
+    (void)queries;
+    std::cout << YELLOW << "Query counters disabled at build time (TEXTGRAPH_NO_STATS)." << RESET << '\n';
+#endif
+}
+
+// Expand a command-line input into files: a regular file is taken as is, a directory
+// contributes every non-hidden file below it, in sorted order
+bool collectInputFiles(const std::string& path, std::vector<std::string>& files) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+        std::cerr << "Error: Could not open file " << path << '\n';
+        return false;
+    }
+    if (!S_ISDIR(info.st_mode)) {
+        files.push_back(path);
+        return true;
+    }
+
+    DIR* dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        std::cerr << "Error: Could not open directory " << path << '\n';
+        return false;
+    }
+    std::vector<std::string> entries;
+    while (struct dirent* entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') {
+            entries.push_back(path + "/" + entry->d_name);
+        }
+    }
+    closedir(dir);
+
+    std::sort(entries.begin(), entries.end());
+    bool ok = true;
+    for (const std::string& entry : entries) {
+        ok = collectInputFiles(entry, files) && ok;
+    }
+    return ok;
+}
@@ -0,0 +1,128 @@
+#include "../include/TwoHop.h"
+#include "../include/Parallel.h"
+
+namespace {
+
+typedef CsrGraph::VertexId VertexId;
+
+// Rows handed to a worker at a time; small enough to balance hub rows, large enough to
+// keep the per-block bookkeeping negligible
+const size_t kRowsPerBlock = 256;
+
+// Dense accumulator indexed by column plus the list of columns touched by the current row,
+// so resetting costs O(row non-zeros) instead of O(V)
+struct SparseAccumulator {
+    std::vector<uint32_t> bridges;
+    std::vector<uint64_t> weight;
+    std::vector<VertexId> touched;
+
+    explicit SparseAccumulator(size_t columns) : bridges(columns, 0), weight(columns, 0) {}
+};
+
+// Output of one block of rows, concatenated in block order afterwards
+struct RowBlock {
+    std::vector<uint64_t> rowSizes;
+    std::vector<TwoHopEntry> entries;
+};
+
+bool strongerEntry(const TwoHopEntry& a, const TwoHopEntry& b) {
+    if (a.weight != b.weight) {
+        return a.weight > b.weight;
+    }
+    if (a.bridges != b.bridges) {
+        return a.bridges > b.bridges;
+    }
+    return a.target < b.target;
+}
+
+bool byTarget(const TwoHopEntry& a, const TwoHopEntry& b) {
+    return a.target < b.target;
+}
+
+} // namespace
+
+TwoHopMatrix::TwoHopMatrix(const CsrGraph& graph, const TwoHopOptions& options) {
+    const size_t n = graph.vertexCount();
+    const size_t blockCount = (n + kRowsPerBlock - 1) / kRowsPerBlock;
+    const unsigned workers = workerCount(blockCount, options.threads);
+    std::vector<std::unique_ptr<SparseAccumulator>> accumulators(workers);
+    std::vector<RowBlock> blocks(blockCount);
+
+    parallelForWorkers(blockCount, workers, [&](size_t block, unsigned worker) {
+        if (!accumulators[worker]) {
+            accumulators[worker].reset(new SparseAccumulator(n));
+        }
+        SparseAccumulator& acc = *accumulators[worker];
+        RowBlock& out = blocks[block];
+        const VertexId first = static_cast<VertexId>(block * kRowsPerBlock);
+        const VertexId last = static_cast<VertexId>(std::min(n, (block + 1) * kRowsPerBlock));
+        out.rowSizes.reserve(last - first);
+
+        for (VertexId a = first; a < last; ++a) {
+            // Row a of A * A: scatter row b of A, scaled by A[a][b], for every b in row a
+            const uint32_t* wab = graph.weightsBegin(a);
+            for (const VertexId* b = graph.targetsBegin(a); b != graph.targetsEnd(a); ++b, ++wab) {
+                const uint32_t* wbc = graph.weightsBegin(*b);
+                for (const VertexId* c = graph.targetsBegin(*b); c != graph.targetsEnd(*b); ++c, ++wbc) {
+                    if (acc.bridges[*c] == 0) {
+                        acc.touched.push_back(*c);
+                    }
+                    acc.bridges[*c]++;
+                    acc.weight[*c] += static_cast<uint64_t>(*wab) * *wbc;
+                }
+            }
+
+            // Gather the surviving entries and clear only what this row touched
+            const size_t rowStart = out.entries.size();
+            for (VertexId c : acc.touched) {
+                if (acc.bridges[c] >= options.minBridges && acc.weight[c] >= options.minWeight &&
+                    !(options.skipSelfPairs && c == a)) {
+                    TwoHopEntry entry;
+                    entry.target = c;
+                    entry.bridges = acc.bridges[c];
+                    entry.weight = acc.weight[c];
+                    out.entries.push_back(entry);
+                }
+                acc.bridges[c] = 0;
+                acc.weight[c] = 0;
+            }
+            acc.touched.clear();
+
+            std::vector<TwoHopEntry>::iterator rowBegin = out.entries.begin() + rowStart;
+            if (options.topK > 0 && out.entries.size() - rowStart > options.topK) {
+                std::nth_element(rowBegin, rowBegin + (options.topK - 1), out.entries.end(), strongerEntry);
+                out.entries.resize(rowStart + options.topK);
+                rowBegin = out.entries.begin() + rowStart;
+            }
+            std::sort(rowBegin, out.entries.end(), byTarget);
+            out.rowSizes.push_back(out.entries.size() - rowStart);
+        }
+    });
+
+    size_t total = 0;
+    for (const RowBlock& block : blocks) {
+        total += block.entries.size();
+    }
+    offsets.reserve(n + 1);
+    offsets.push_back(0);
+    entries.reserve(total);
+    for (RowBlock& block : blocks) {
+        for (uint64_t size : block.rowSizes) {
+            offsets.push_back(offsets.back() + size);
+        }
+        entries.insert(entries.end(), block.entries.begin(), block.entries.end());
+        std::vector<TwoHopEntry>().swap(block.entries);
+    }
+}
+
+bool TwoHopMatrix::find(CsrGraph::VertexId from, CsrGraph::VertexId to, TwoHopEntry& entry) const {
+    TwoHopEntry key = TwoHopEntry();
+    key.target = to;
+    const TwoHopEntry* end = rowEnd(from);
+    const TwoHopEntry* it = std::lower_bound(rowBegin(from), end, key, byTarget);
+    if (it == end || it->target != to) {
+        return false;
+    }
+    entry = *it;
+    return true;
+}
@@ -0,0 +1,34 @@
+#include "../include/VertexOrder.h"
+
+const char* vertexOrderName(VertexOrder order) {
+    switch (order) {
+    case VertexOrder::Lexicographic:
+        return "lexicographic";
+    case VertexOrder::ReverseCuthillMcKee:
+        return "reverse Cuthill-McKee";
+    case VertexOrder::Degree:
+        return "degree";
+    case VertexOrder::BreadthFirst:
+        return "breadth-first";
+    }
+    return "unknown";
+}
+
+bool parseVertexOrder(const std::string& text, VertexOrder& order) {
+    if (text == "lex") {
+        order = VertexOrder::Lexicographic;
+    }
+    else if (text == "rcm") {
+        order = VertexOrder::ReverseCuthillMcKee;
+    }
+    else if (text == "degree") {
+        order = VertexOrder::Degree;
+    }
+    else if (text == "bfs") {
+        order = VertexOrder::BreadthFirst;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,183 @@
+#include "../include/WindowedGraph.h"
+#include "../include/Tools.h"
+
+// Expired bucket entries examined per insertion. Each insertion adds at most one entry,
+// so sweeping two keeps reclamation ahead of the feed
+static const size_t kSweepPerInsert = 2;
+
+WindowedGraph::WindowedGraph(const WindowOptions& opts) : options(opts) {
+    if (options.windowEpochs == 0) {
+        options.windowEpochs = 1;
+    }
+    decayFactor.resize(options.windowEpochs);
+    double factor = 1.0;
+    for (uint32_t age = 0; age < options.windowEpochs; ++age) {
+        decayFactor[age] = factor;
+        factor *= options.decayPerEpoch;
+    }
+    buckets.push_back(std::vector<uint64_t>());
+}
+
+void WindowedGraph::addText(const std::string& text) {
+    std::string buffer(text);
+    size_t length = normalizeTextInPlace(&buffer[0], buffer.size());
+    WordCursor cursor(buffer.data(), length);
+    const char* word = nullptr;
+    size_t wordLength = 0;
+    std::string token;
+    while (cursor.next(word, wordLength)) {
+        token.assign(word, wordLength);
+        addToken(token);
+    }
+}
+
+void WindowedGraph::addToken(const std::string& word) {
+    if (word.empty()) {
+        return;
+    }
+    if (havePrevious) {
+        addEdge(previousWord, word);
+    }
+    previousWord = word;
+    havePrevious = true;
+
+    if (options.tokensPerEpoch > 0 && ++tokensInEpoch >= options.tokensPerEpoch) {
+        advanceEpoch();
+    }
+}
+
+void WindowedGraph::endDocument() {
+    havePrevious = false;
+}
+
+void WindowedGraph::addEdge(const std::string& src, const std::string& dest, double weight) {
+    sweep(kSweepPerInsert);
+    uint32_t srcId = intern(src);
+    uint32_t destId = intern(dest);
+    uint64_t key = (static_cast<uint64_t>(srcId) << 32) | destId;
+
+    std::unordered_map<uint64_t, EdgeSlot>::iterator it = edges.find(key);
+    if (it == edges.end()) {
+        EdgeSlot slot;
+        slot.weight = weight;
+        slot.lastEpoch = epoch;
+        edges.emplace(key, slot);
+        vertices[srcId].liveEdges++;
+        vertices[destId].liveEdges++;
+        buckets.back().push_back(key);
+        return;
+    }
+
+    // Expired but not reclaimed yet: start over instead of reviving the old weight
+    EdgeSlot& slot = it->second;
+    slot.weight = (isLive(slot) ? decayed(slot) : 0.0) + weight;
+    if (slot.lastEpoch != epoch) {
+        slot.lastEpoch = epoch;
+        buckets.back().push_back(key);
+    }
+}
+
+void WindowedGraph::advanceEpoch() {
+    epoch++;
+    tokensInEpoch = 0;
+    buckets.push_back(std::vector<uint64_t>());
+    sweep(kSweepPerInsert);
+}
+
+void WindowedGraph::reclaimExpired() {
+    sweep(std::numeric_limits<size_t>::max());
+}
+
+double WindowedGraph::edgeWeight(const std::string& src, const std::string& dest) const {
+    std::unordered_map<std::string, uint32_t>::const_iterator s = vertexIds.find(src);
+    std::unordered_map<std::string, uint32_t>::const_iterator d = vertexIds.find(dest);
+    if (s == vertexIds.end() || d == vertexIds.end()) {
+        return 0.0;
+    }
+    std::unordered_map<uint64_t, EdgeSlot>::const_iterator it = edges.find((static_cast<uint64_t>(s->second) << 32) | d->second);
+    if (it == edges.end() || !isLive(it->second)) {
+        return 0.0;
+    }
+    return decayed(it->second);
+}
+
+Graph WindowedGraph::snapshot() const {
+    // Sorted by (source, destination) so the snapshot does not depend on hash order
+    std::vector<std::pair<std::pair<const std::string*, const std::string*>, double>> live;
+    live.reserve(edges.size());
+    for (const auto& entry : edges) {
+        if (isLive(entry.second)) {
+            const std::string* src = &vertices[static_cast<uint32_t>(entry.first >> 32)].name;
+            const std::string* dest = &vertices[static_cast<uint32_t>(entry.first)].name;
+            live.push_back(std::make_pair(std::make_pair(src, dest), decayed(entry.second)));
+        }
+    }
+    std::sort(live.begin(), live.end(),
+        [](const std::pair<std::pair<const std::string*, const std::string*>, double>& a,
+           const std::pair<std::pair<const std::string*, const std::string*>, double>& b) {
+            if (*a.first.first != *b.first.first) {
+                return *a.first.first < *b.first.first;
+            }
+            return *a.first.second < *b.first.second;
+        });
+
+    Graph graph;
+    for (const auto& edge : live) {
+        graph.addEdge(*edge.first.first, *edge.first.second, std::max(1, static_cast<int>(std::lround(edge.second))));
+    }
+    return graph;
+}
+
+uint32_t WindowedGraph::intern(const std::string& word) {
+    std::unordered_map<std::string, uint32_t>::iterator it = vertexIds.find(word);
+    if (it != vertexIds.end()) {
+        return it->second;
+    }
+    uint32_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+        vertices[id].name = word;
+    }
+    else {
+        id = static_cast<uint32_t>(vertices.size());
+        vertices.push_back(Vertex());
+        vertices.back().name = word;
+    }
+    vertices[id].liveEdges = 0;
+    vertexIds.emplace(word, id);
+    return id;
+}
+
+// Drop one edge reference; a word with none left is forgotten and its ID reused
+void WindowedGraph::release(uint32_t id) {
+    if (--vertices[id].liveEdges == 0) {
+        vertexIds.erase(vertices[id].name);
+        std::string().swap(vertices[id].name);
+        freeIds.push_back(id);
+    }
+}
+
+// Examine up to budget entries of buckets that have left the window. An entry is stale
+// when the edge was reinforced again later (a newer bucket holds it) or already removed
+void WindowedGraph::sweep(size_t budget) {
+    while (budget > 0 && firstBucketEpoch + options.windowEpochs <= epoch) {
+        std::vector<uint64_t>& bucket = buckets.front();
+        if (sweepCursor == bucket.size()) {
+            buckets.pop_front();
+            firstBucketEpoch++;
+            sweepCursor = 0;
+            budget--;
+            continue;
+        }
+        uint64_t key = bucket[sweepCursor++];
+        budget--;
+        std::unordered_map<uint64_t, EdgeSlot>::iterator it = edges.find(key);
+        if (it == edges.end() || it->second.lastEpoch != firstBucketEpoch) {
+            continue;
+        }
+        edges.erase(it);
+        release(static_cast<uint32_t>(key >> 32));
+        release(static_cast<uint32_t>(key));
+    }
+}
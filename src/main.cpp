@@ -1,22 +1,307 @@
 #include "../include/Tools.h"
+#include "../include/ExternalBuilder.h"
+#include "../include/SketchBuilder.h"
+
+#include "../include/Jobs.h"
+#include "../include/ResultStream.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+// Print the shortest paths from one word to all others (menu option 5)
+static void presentAllPaths(const std::string& source,
+    const std::map<std::string, std::pair<double, std::vector<std::string>>>& paths) {
+    if (paths.empty()) {
+        std::cout << YELLOW << "No paths found from " << source << "." << RESET << '\n';
+        return;
+    }
+    std::cout << BLUE << "Shortest paths from " << source << " to all words:" << RESET << '\n';
+    for (const auto& entry : paths) {
+        std::cout << GREEN << "To " << entry.first << ": " << RESET;
+        displayShortestPath(entry.second);
+        std::cout << '\n';
+    }
+}
+
+// Write the shortest paths from one word into a file as they are settled, one
+// "word<TAB>length<TAB>path" line each, without holding them in memory (menu option 5)
+static bool streamAllPaths(const Graph& graph, const std::string& source, PathCost cost, const std::string& fileName,
+    JobControl& control) {
+    std::ofstream out(fileName);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open file " << fileName << '\n';
+        return false;
+    }
+    ShortestPathStream paths = graph.streamShortestPaths(source, cost);
+    while (paths.next()) {
+        out << paths.word() << '\t' << paths.distance() << '\t';
+        const std::vector<CsrGraph::VertexId>& ids = paths.pathIds();
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (i > 0) out << " -> ";
+            out << paths.view().name(ids[i]);
+        }
+        out << '\n';
+        if (paths.settledCount() % 4096 == 0) {
+            control.reportProgress(paths.settledCount(), paths.view().vertexCount());
+            if (control.shouldStop()) {
+                return false;
+            }
+        }
+    }
+    return static_cast<bool>(out);
+}
+
+// Sort, print and optionally save PageRank, HITS or Katz scores (menu option 6)
+static void presentPageRanks(const std::map<std::string, double>& pageRanks, const std::string& measure = "PageRank") {
+    // 按 PageRank 值排序 (从高到低)
+    std::vector<std::pair<std::string, double>> sortedRanks;
+    sortedRanks.reserve(pageRanks.size());
+    for (const auto& entry : pageRanks) {
+        sortedRanks.emplace_back(entry);
+    }
+
+    std::sort(sortedRanks.begin(), sortedRanks.end(),
+        [](const std::pair<std::string, double>& a, const std::pair<std::string, double>& b) {
+            return a.second > b.second;
+        });
+
+    // 显示结果的选项
+    int displayCount = 20; // 默认显示前 20 个结果
+    std::cout << "显示前多少个结果 (默认 20): ";
+    std::string displayInput;
+    std::getline(std::cin, displayInput);
+    if (!displayInput.empty()) {
+        displayCount = std::stoi(displayInput);
+    }
+
+    std::cout << BLUE << measure << " 值 (前 " << displayCount << "):" << RESET << '\n';
+    std::cout << std::setw(15) << "单词" << std::setw(15) << measure + " 值" << '\n';
+    std::cout << std::string(30, '-') << '\n';
+
+    // 显示排序后的结果
+    for (size_t i = 0; i < std::min(sortedRanks.size(), static_cast<size_t>(displayCount)); ++i) {
+        std::cout << std::setw(15) << sortedRanks[i].first
+            << std::setw(15) << std::fixed << std::setprecision(8) << sortedRanks[i].second << '\n';
+    }
+
+    // 保存 PageRank 结果到文件
+    std::cout << "是否保存结果到文件？(y/n): ";
+    char saveToFile;
+    std::cin >> saveToFile;
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+    if (saveToFile == 'y' || saveToFile == 'Y') {
+        std::string outputFile;
+        std::cout << "输入输出文件名 (如 pagerank_results.txt): ";
+        std::getline(std::cin, outputFile);
+
+        std::ofstream outFile(outputFile);
+        if (outFile.is_open()) {
+            outFile << "单词," << measure << "值\n";
+            for (const auto& entry : sortedRanks) {
+                outFile << entry.first << "," << std::fixed << std::setprecision(6) << entry.second << "\n";
+            }
+            outFile.close();
+            std::cout << GREEN << measure << " 结果已保存到 " << outputFile << RESET << '\n';
+        }
+        else {
+            std::cerr << RED << "无法打开文件保存结果。" << RESET << '\n';
+        }
+    }
+}
+
+// Ask for an optional time limit for a background job
+static std::chrono::milliseconds askDeadline() {
+    std::cout << "Deadline in seconds (Enter for none): ";
+    std::string input;
+    std::getline(std::cin, input);
+    double seconds = input.empty() ? 0.0 : std::strtod(input.c_str(), nullptr);
+    return std::chrono::milliseconds(static_cast<int64_t>(seconds * 1000.0));
+}
+
+// List background jobs and view, cancel or dismiss them (menu option 9)
+static void manageJobs(JobManager& jobManager) {
+    std::vector<std::shared_ptr<Job>> jobs = jobManager.list();
+    if (jobs.empty()) {
+        std::cout << YELLOW << "No background jobs." << RESET << '\n';
+        return;
+    }
+    for (const std::shared_ptr<Job>& job : jobs) {
+        const JobControl& control = job->control();
+        std::cout << "#" << job->id() << "  " << std::setw(10) << std::left << jobStateName(job->state()) << std::right
+                  << "  " << control.progressDone() << "/" << control.progressTotal()
+                  << "  " << std::fixed << std::setprecision(1) << job->elapsedSeconds() << "s" << std::defaultfloat
+                  << "  " << job->description() << '\n';
+    }
+
+    std::cout << "Enter 'v <id>' to view a finished result, 'c <id>' to cancel, 'd <id>' to dismiss, or Enter to return: ";
+    std::string command;
+    std::getline(std::cin, command);
+    if (command.size() < 3) {
+        return;
+    }
+    int id = std::atoi(command.c_str() + 2);
+    std::shared_ptr<Job> job = jobManager.find(id);
+    if (!job) {
+        std::cout << RED << "No job #" << id << "." << RESET << '\n';
+    }
+    else if (command[0] == 'c') {
+        job->cancel();
+        std::cout << "Cancellation requested for job #" << id << "." << '\n';
+    }
+    else if (command[0] == 'v' && job->state() == JobState::Finished) {
+        job->presentResult();
+        jobManager.remove(id);
+    }
+    else if (command[0] == 'v') {
+        std::cout << YELLOW << "Job #" << id << " has no result (" << jobStateName(job->state()) << ")." << RESET << '\n';
+    }
+    else if (command[0] == 'd' && !jobManager.remove(id)) {
+        std::cout << YELLOW << "Job #" << id << " is still running; cancel it first." << RESET << '\n';
+    }
+}
 
 // Main function to handle user interface
 int main(int argc, const char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: " << argv[0] << " <text_file>" << '\n';
+    bool showStats = false;
+    size_t memoryBudgetMB = 0;
+    uint64_t approximateMinWeight = 0;
+    unsigned threads = 0;
+    uint32_t delta = 0;
+    VertexOrder order = VertexOrder::Lexicographic;
+    PathCost pathCost = PathCost::Count;
+    std::string fileName, snapshotFile;
+    std::vector<std::string> inputs;
+    bool badArgs = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--stats") {
+            showStats = true;
+        }
+        else if (arg == "--memory-budget" && i + 1 < argc) {
+            memoryBudgetMB = static_cast<size_t>(std::strtoul(argv[++i], nullptr, 10));
+            badArgs = badArgs || memoryBudgetMB == 0;
+        }
+        else if (arg == "--approximate" && i + 1 < argc) {
+            approximateMinWeight = std::strtoull(argv[++i], nullptr, 10);
+            badArgs = badArgs || approximateMinWeight == 0;
+        }
+        else if (arg == "--snapshot" && i + 1 < argc) {
+            snapshotFile = argv[++i];
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--delta" && i + 1 < argc) {
+            delta = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            badArgs = badArgs || delta == 0;
+        }
+        else if (arg == "--cost" && i + 1 < argc) {
+            badArgs = !parsePathCost(argv[++i], pathCost) || badArgs;
+        }
+        else if (arg == "--order" && i + 1 < argc) {
+            badArgs = !parseVertexOrder(argv[++i], order) || badArgs;
+        }
+        else if (arg.compare(0, 2, "--") != 0) {
+            badArgs = !collectInputFiles(arg, inputs) || badArgs;
+        }
+        else {
+            badArgs = true;
+        }
+    }
+
+    if (inputs.empty() || badArgs) {
+        std::cerr << "Usage: " << argv[0] << " [--stats] [--threads <N>] [--delta <W>] [--order <lex|rcm|degree|bfs>] [--cost <count|inverse|logprob|hops>] [--memory-budget <MB>] [--approximate <N>] [--snapshot <out.tgcg>] <text_file|dir>..." << '\n';
+        std::cerr << "  --threads        worker threads for multi-file builds and path searches (default: all cores)" << '\n';
+        std::cerr << "  --delta          bucket width of the parallel path search (default: mean edge weight)" << '\n';
+        std::cerr << "  --cost           what shortest paths minimize: raw counts (default), 1/count, -log probability or hops" << '\n';
+        std::cerr << "  --order          renumber vertices for cache locality before PageRank and path queries" << '\n';
+        std::cerr << "  --memory-budget  build out-of-core with bounded memory (sorted runs spilled to $TMPDIR)" << '\n';
+        std::cerr << "  --approximate    fixed-memory sketch build keeping only bigrams seen about N times or more" << '\n';
+        std::cerr << "  --snapshot       write a compressed graph snapshot and exit" << '\n';
         return 1;
     }
+    // Several inputs are separate documents: no edges across files, TF-IDF per file
+    const bool multiDocument = inputs.size() > 1;
+    fileName = inputs[0];
 
-    std::string fileName = argv[1];
     Graph graph;
 
-    std::cout << "Reading file: " << fileName << '\n';
-    if (!graph.buildFromFile(fileName)) {
+    if (multiDocument) {
+        std::cout << "Reading " << inputs.size() << " files" << '\n';
+    }
+    else {
+        std::cout << "Reading file: " << fileName << '\n';
+    }
+    if (approximateMinWeight > 0) {
+        SketchBuildOptions options;
+        options.minWeight = approximateMinWeight;
+        SketchGraphBuilder builder(options);
+        bool built = true;
+        for (size_t i = 0; i < inputs.size() && built; ++i) {
+            built = builder.addFile(inputs[i]);
+        }
+        if (!built) {
+            std::cerr << "Failed to build graph from file." << '\n';
+            return 1;
+        }
+        builder.finishInto(graph);
+        const SketchBuildReport& report = builder.report();
+        std::cout << "Approximate build: " << report.tokens << " tokens, " << report.tracked << " bigrams tracked, "
+                  << report.edges << " edges kept in " << (report.memoryBytes >> 10) << " KB" << '\n';
+        std::cout << "Weights overestimate by at most " << std::fixed << std::setprecision(1) << report.errorBound
+                  << std::defaultfloat << std::setprecision(6) << " with probability " << report.confidence << "; no untracked bigram occurred more than "
+                  << report.trackedFloor << " times" << '\n';
+    }
+    else if (memoryBudgetMB > 0) {
+        ExternalBuildOptions options;
+        options.memoryBudgetBytes = memoryBudgetMB << 20;
+        ExternalGraphBuilder builder(options);
+        bool built = true;
+        for (size_t i = 0; i < inputs.size() && built; ++i) {
+            built = builder.addFile(inputs[i]);
+        }
+        built = built && (snapshotFile.empty() ? builder.finishInto(graph) : builder.finishToSnapshot(snapshotFile));
+        if (!built) {
+            std::cerr << "Failed to build graph from file." << '\n';
+            return 1;
+        }
+        const ExternalBuildReport& report = builder.report();
+        std::cout << "External build: " << report.tokens << " tokens, " << report.runs << " runs, "
+                  << report.edges << " edges, " << report.vertices << " vertices" << '\n';
+        if (!snapshotFile.empty()) {
+            std::cout << "Snapshot saved to " << snapshotFile << '\n';
+            return 0;
+        }
+    }
+    else if (multiDocument ? !graph.buildFromFiles(inputs, threads) : !graph.buildFromFile(fileName)) {
         std::cerr << "Failed to build graph from file." << '\n';
         return 1;
     }
 
+    if (!snapshotFile.empty()) {
+        CompressedGraph compressed(graph);
+        if (!compressed.saveToFile(snapshotFile)) {
+            return 1;
+        }
+        std::cout << "Snapshot saved to " << snapshotFile << " (" << compressed.memoryBytes() << " bytes in memory)" << '\n';
+        return 0;
+    }
+
     std::cout << BLUE << "Graph built successfully!" << RESET << '\n';
+    if (showStats) {
+        displayGraphStats(graph.stats());
+    }
+
+    // Long computations run as background jobs reading the graph while the menu stays live.
+    // The graph is not modified from here on; build its lazy views now so that concurrent
+    // queries only ever read them. Declared after graph so jobs stop before it goes away
+    graph.setVertexOrder(order);
+    graph.setPathThreads(threads, delta);
+    graph.setRankThreads(threads);
+    graph.csrView();
+    graph.reachabilityIndex();
+    JobManager jobManager;
 
     // Main menu loop
     int choice;
@@ -31,6 +316,9 @@ int main(int argc, const char* argv[]) {
         std::cout << "5. Find Shortest Path" << '\n';
         std::cout << "6. Calculate PageRank" << '\n';
         std::cout << "7. Random Walk" << '\n';
+        std::cout << "8. Betweenness Centrality (hub words)" << '\n';
+        std::cout << "9. Background Jobs" << '\n';
+        std::cout << "10. Hop Queries (distance, k-hop neighborhood, reachable words)" << '\n';
         std::cout << "0. Exit" << '\n';
         std::cout << "Enter your choice: ";
         std::cin >> choice;
@@ -127,21 +415,34 @@ int main(int argc, const char* argv[]) {
             std::getline(std::cin, word2);
 
             if (word2.empty()) {
-                // Calculate paths from source to all destinations
-                std::map<std::string, std::pair<double, std::vector<std::string>>> paths =
-                    graph.shortestPathsFromSource(normalizedWord1);
-
-                if (paths.empty()) {
-                    std::cout << YELLOW << "No paths found from " << normalizedWord1 << "." << RESET << '\n';
-                }
-                else {
-                    std::cout << BLUE << "Shortest paths from " << normalizedWord1 << " to all words:" << RESET << '\n';
-                    for (const auto& entry : paths) {
-                        std::cout << GREEN << "To " << entry.first << ": " << RESET;
-                        displayShortestPath(entry.second);
-                        std::cout << '\n';
-                    }
+                std::cout << "Stream paths into file (Enter to list them here): ";
+                std::string pathFile;
+                std::getline(std::cin, pathFile);
+                if (!pathFile.empty()) {
+                    // Each path is written as soon as its destination is settled
+                    std::chrono::milliseconds deadline = askDeadline();
+                    std::shared_ptr<Job> job = jobManager.start("Streaming paths from " + normalizedWord1 + " to " + pathFile,
+                        deadline,
+                        [&graph, normalizedWord1, pathCost, pathFile](JobControl& control) {
+                            return streamAllPaths(graph, normalizedWord1, pathCost, pathFile, control);
+                        },
+                        [pathFile]() { std::cout << GREEN << "Paths saved to " << pathFile << RESET << '\n'; });
+                    std::cout << GREEN << "Started background job #" << job->id()
+                              << "; use option 9 to follow it." << RESET << '\n';
+                    break;
                 }
+                // Calculate paths from source to all destinations in the background
+                typedef std::map<std::string, std::pair<double, std::vector<std::string>>> PathMap;
+                std::shared_ptr<PathMap> paths = std::make_shared<PathMap>();
+                std::chrono::milliseconds deadline = askDeadline();
+                std::shared_ptr<Job> job = jobManager.start("All shortest paths from " + normalizedWord1, deadline,
+                    [&graph, paths, normalizedWord1, pathCost](JobControl& control) {
+                        *paths = graph.shortestPathsFromSource(normalizedWord1, &control, pathCost);
+                        return !control.interrupted();
+                    },
+                    [paths, normalizedWord1]() { presentAllPaths(normalizedWord1, *paths); });
+                std::cout << GREEN << "Started background job #" << job->id()
+                          << "; use option 9 to follow it." << RESET << '\n';
             }
             else {
                 // Calculate path from source to destination
@@ -153,7 +454,7 @@ int main(int argc, const char* argv[]) {
                 }
 
                 std::pair<double, std::vector<std::string>> path =
-                    graph.shortestPath(normalizedWord1, normalizedWord2);
+                    graph.shortestPath(normalizedWord1, normalizedWord2, pathCost);
 
                 std::cout << BLUE << "Shortest path from " << normalizedWord1 << " to " << normalizedWord2 << ":" << RESET << '\n';
                 displayShortestPath(path);
@@ -166,7 +467,10 @@ int main(int argc, const char* argv[]) {
             std::cout << YELLOW << "选择 PageRank 计算方法：" << RESET << '\n';
             std::cout << "1. 标准 PageRank (均匀初始值)" << '\n';
             std::cout << "2. 基于 TF-IDF 的 PageRank" << '\n';
-            std::cout << "请输入选择 (1-2): ";
+            std::cout << "3. HITS 权威值 (authority)" << '\n';
+            std::cout << "4. HITS 枢纽值 (hub)" << '\n';
+            std::cout << "5. Katz 中心性" << '\n';
+            std::cout << "请输入选择 (1-5): ";
             std::cin >> prMethod;
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); // 清除输入缓冲区
 
@@ -186,102 +490,162 @@ int main(int argc, const char* argv[]) {
                 std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
             }
 
-            // 根据用户选择计算 PageRank
-            std::map<std::string, double> pageRanks;
-            if (prMethod == 2) {
-                std::cout << BLUE << "使用 TF-IDF 作为初始 PageRank 值..." << RESET << '\n';
-                pageRanks = graph.calculatePageRankWithTfIdf(fileName, dampingFactor, iterations);
+            if (prMethod >= 3 && prMethod <= 5) {
+                std::shared_ptr<std::map<std::string, double>> scores = std::make_shared<std::map<std::string, double>>();
+                std::string measure = prMethod == 5 ? "Katz" : prMethod == 3 ? "HITS authority" : "HITS hub";
+                std::chrono::milliseconds deadline = askDeadline();
+                std::shared_ptr<Job> job = jobManager.start(measure, deadline,
+                    [&graph, scores, prMethod, iterations](JobControl& control) {
+                        if (prMethod == 5) {
+                            *scores = graph.calculateKatz(0.0, iterations, &control);
+                        }
+                        else {
+                            std::pair<std::map<std::string, double>, std::map<std::string, double>> hits =
+                                graph.calculateHits(iterations, &control);
+                            scores->swap(prMethod == 3 ? hits.second : hits.first);
+                        }
+                        return !control.interrupted();
+                    },
+                    [scores, measure]() { presentPageRanks(*scores, measure); });
+                std::cout << GREEN << "Started background job #" << job->id()
+                          << "; use option 9 to follow it." << RESET << '\n';
+                break;
+            }
+
+            // 根据用户选择在后台计算 PageRank；初始值在查看结果时打印，不打断交互提示
+            std::shared_ptr<std::map<std::string, double>> pageRanks = std::make_shared<std::map<std::string, double>>();
+            std::shared_ptr<std::map<std::string, double>> initialRanks = std::make_shared<std::map<std::string, double>>();
+            std::shared_ptr<double> uniformRank = std::make_shared<double>(0.0);
+            bool useTfIdf = prMethod == 2;
+            std::chrono::milliseconds deadline = askDeadline();
+            std::shared_ptr<Job> job = jobManager.start(useTfIdf ? "TF-IDF PageRank" : "PageRank", deadline,
+                [&graph, pageRanks, initialRanks, uniformRank, useTfIdf, multiDocument, fileName, dampingFactor,
+                    iterations](JobControl& control) {
+                    if (useTfIdf) {
+                        *initialRanks = multiDocument ? graph.calculateTfIdfRanks() : graph.calculateTfIdfRanks(fileName);
+                    }
+                    else {
+                        *uniformRank = 1.0 / static_cast<double>(graph.vertexCount());
+                    }
+                    *pageRanks = graph.calculatePageRank(dampingFactor, *initialRanks, iterations, &control);
+                    return !control.interrupted();
+                },
+                [pageRanks, initialRanks, uniformRank, useTfIdf]() {
+                    if (useTfIdf) {
+                        for (const auto& entry : *initialRanks) {
+                            printf("\"%s\" TF-IDF initialRank: %f\n", entry.first.c_str(), entry.second);
+                        }
+                    }
+                    else {
+                        printf("initialRank: %f\n", *uniformRank);
+                    }
+                    presentPageRanks(*pageRanks);
+                });
+            std::cout << BLUE << (useTfIdf ? "使用 TF-IDF 作为初始 PageRank 值..." : "使用标准 PageRank 计算...") << RESET << '\n';
+            std::cout << GREEN << "Started background job #" << job->id()
+                      << "; use option 9 to follow it." << RESET << '\n';
+            break;
+        }
+
+        case 7: {
+            // Print and save each step as it is taken
+            RandomWalkStream walk = graph.streamRandomWalk();
+            if (!walk.next()) {
+                std::cout << RED << "Random walk could not be performed on the graph." << RESET << '\n';
+                break;
+            }
+            std::ofstream walkFile("random_walk.txt");
+            std::cout << GREEN << "Random Walk Path:" << RESET << '\n';
+            do {
+                if (walk.length() > 1) {
+                    std::cout << " -> ";
+                    walkFile << " ";
+                }
+                std::cout << walk.word();
+                walkFile << walk.word();
+            } while (walk.next());
+            std::cout << '\n';
+
+            // Save walk to file
+            if (walkFile.is_open()) {
+                walkFile.close();
+                std::cout << "Random walk saved to random_walk.txt" << '\n';
             }
             else {
-                std::cout << BLUE << "使用标准 PageRank 计算..." << RESET << '\n';
-                pageRanks = graph.calculatePageRank(dampingFactor, std::map<std::string, double>(), iterations);
+                std::cerr << "Could not save random walk to file." << '\n';
             }
+            break;
+        }
 
-            // 按 PageRank 值排序 (从高到低)
-            std::vector<std::pair<std::string, double>> sortedRanks;
-            sortedRanks.reserve(pageRanks.size());
-            for (const auto& entry : pageRanks) {
-                sortedRanks.emplace_back(entry);
-            }
+        case 8: {
+            std::cout << "Number of sampled sources (Enter for exact): ";
+            std::getline(std::cin, input);
+            size_t samples = input.empty() ? 0 : static_cast<size_t>(std::strtoul(input.c_str(), nullptr, 10));
+            std::map<std::string, double> scores = graph.calculateBetweenness(samples, threads);
 
-            std::sort(sortedRanks.begin(), sortedRanks.end(),
+            std::vector<std::pair<std::string, double>> hubs(scores.begin(), scores.end());
+            std::sort(hubs.begin(), hubs.end(),
                 [](const std::pair<std::string, double>& a, const std::pair<std::string, double>& b) {
                     return a.second > b.second;
                 });
-
-            // 显示结果的选项
-            int displayCount = 20; // 默认显示前 20 个结果
-            std::cout << "显示前多少个结果 (默认 20): ";
-            std::string displayInput;
-            std::getline(std::cin, displayInput);
-            if (!displayInput.empty()) {
-                displayCount = std::stoi(displayInput);
+            std::cout << BLUE << "Top hub words by betweenness" << (samples > 0 ? " (sampled)" : "") << ":" << RESET << '\n';
+            for (size_t i = 0; i < std::min<size_t>(hubs.size(), 20); ++i) {
+                std::cout << std::setw(15) << hubs[i].first << std::setw(15) << std::fixed << std::setprecision(2)
+                          << hubs[i].second << std::defaultfloat << '\n';
             }
+            break;
+        }
 
-            std::cout << BLUE << "PageRank 值 (前 " << displayCount << "):" << RESET << '\n';
-            std::cout << std::setw(15) << "单词" << std::setw(15) << "PageRank 值" << '\n';
-            std::cout << std::string(30, '-') << '\n';
-
-            // 显示排序后的结果
-            for (size_t i = 0; i < std::min(sortedRanks.size(), static_cast<size_t>(displayCount)); ++i) {
-                std::cout << std::setw(15) << sortedRanks[i].first
-                    << std::setw(15) << std::fixed << std::setprecision(8) << sortedRanks[i].second << '\n';
-            }
+        case 9:
+            manageJobs(jobManager);
+            break;
 
-            // 保存 PageRank 结果到文件
-            std::cout << "是否保存结果到文件？(y/n): ";
-            char saveToFile;
-            std::cin >> saveToFile;
+        case 10: {
+            int queryType;
+            std::cout << YELLOW << "选择跳数查询：" << RESET << '\n';
+            std::cout << "1. 两个单词之间的最少跳数" << '\n';
+            std::cout << "2. k 跳以内的单词" << '\n';
+            std::cout << "3. 可达的全部单词" << '\n';
+            std::cout << "请输入选择 (1-3): ";
+            std::cin >> queryType;
             std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
-            if (saveToFile == 'y' || saveToFile == 'Y') {
-                std::string outputFile;
-                std::cout << "输入输出文件名 (如 pagerank_results.txt): ";
-                std::getline(std::cin, outputFile);
+            std::string word1, word2;
+            std::cout << "Enter the source word: ";
+            std::getline(std::cin, word1);
+            std::string normalizedWord1 = normalizeWord(word1);
+            if (!graph.containsWord(normalizedWord1)) {
+                std::cout << RED << "No " << normalizedWord1 << " in the graph!" << RESET << '\n';
+                break;
+            }
 
-                std::ofstream outFile(outputFile);
-                if (outFile.is_open()) {
-                    outFile << "单词,PageRank值\n";
-                    for (const auto& entry : sortedRanks) {
-                        outFile << entry.first << "," << std::fixed << std::setprecision(6) << entry.second << "\n";
-                    }
-                    outFile.close();
-                    std::cout << GREEN << "PageRank 结果已保存到 " << outputFile << RESET << '\n';
+            if (queryType == 1) {
+                std::cout << "Enter the target word: ";
+                std::getline(std::cin, word2);
+                int hops = graph.hopDistance(normalizedWord1, normalizeWord(word2));
+                if (hops < 0) {
+                    std::cout << RED << "No path exists between these words." << RESET << '\n';
                 }
                 else {
-                    std::cerr << RED << "无法打开文件保存结果。" << RESET << '\n';
+                    std::cout << GREEN << "Hops: " << RESET << hops << '\n';
                 }
             }
-            break;
-        }
-
-        case 7: {
-            std::vector<std::string> walkPath = graph.randomWalk();
-
-            if (walkPath.empty()) {
-                std::cout << RED << "Random walk could not be performed on the graph." << RESET << '\n';
-                break;
+            else if (queryType == 2) {
+                uint32_t k = 1;
+                std::cout << "Enter k: ";
+                std::cin >> k;
+                std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+                std::map<std::string, uint32_t> nearby = graph.neighborhood(normalizedWord1, k);
+                std::cout << BLUE << nearby.size() << " words within " << k << " hops of " << normalizedWord1 << ":" << RESET << '\n';
+                for (const auto& entry : nearby) {
+                    std::cout << entry.first << " (" << entry.second << ")" << '\n';
+                }
             }
             else {
-                std::cout << GREEN << "Random Walk Path:" << RESET << '\n';
-                for (size_t i = 0; i < walkPath.size(); ++i) {
-                    if (i > 0) std::cout << " -> ";
-                    std::cout << walkPath[i];
-                }
-                std::cout << '\n';
-
-                // Save walk to file
-                std::ofstream walkFile("random_walk.txt");
-                if (walkFile.is_open()) {
-                    for (size_t i = 0; i < walkPath.size(); ++i) {
-                        walkFile << walkPath[i];
-                        if (i < walkPath.size() - 1) walkFile << " ";
-                    }
-                    walkFile.close();
-                    std::cout << "Random walk saved to random_walk.txt" << '\n';
-                }
-                else {
-                    std::cerr << "Could not save random walk to file." << '\n';
+                std::vector<std::string> reachable = graph.reachableSet(normalizedWord1);
+                std::cout << BLUE << reachable.size() << " words reachable from " << normalizedWord1 << ":" << RESET << '\n';
+                for (const std::string& word : reachable) {
+                    std::cout << word << '\n';
                 }
             }
             break;
@@ -290,6 +654,10 @@ int main(int argc, const char* argv[]) {
         default:
             std::cout << RED << "Invalid choice. Please try again." << RESET << '\n';
         }
+
+        if (showStats) {
+            displayQueryStats(graph.stats().queries);
+        }
     }
 
     return 0;